@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../arena.c"
+#include "../string.c"
+#include "../compress.c"
+#include "../timer.c"
+#include "../profiler.c"
+#include "../players.c"
+
+// Micro benchmarks for the tournament engine.
+//
+// Every case is run BENCH_WARMUP times untimed, then BENCH_REPS times timed.
+// A summary table goes to stderr and one JSON object per case to the results
+// file (build/bench.json by default, first argument to override), so two runs
+// can be compared with any diff tool:
+//
+//   {"name": "...", "reps": N, "min_ns": .., "median_ns": .., "p99_ns": .., "mean_ns": .., "median_cycles": ..}
+//
+// Run from the repository root: the v2 upgrade case loads tests/fixtures/olympiad_v2.sav.
+
+#define BENCH_SAVE_V2 "tests/fixtures/olympiad_v2.sav"
+#define BENCH_WARMUP 16
+#define BENCH_REPS   512
+
+typedef void BenchFunc(void *userData);
+
+typedef struct BenchContext BenchContext;
+struct BenchContext {
+    Arena *arena;
+    PlayersList players;
+    EventsList events;
+    u32 event_idx;        // Group + knockout event with every player registered
+    String8 last_player;  // Last player in list order, worst case for players_list_find
+};
+
+global FILE *bench_results;
+
+internal int
+bench_compare_u64(const void *a, const void *b)
+{
+    u64 x = *(const u64 *)a;
+    u64 y = *(const u64 *)b;
+    return (x > y) - (x < y);
+}
+
+internal void
+bench_run(char *name, BenchFunc *func, void *userData, u32 reps)
+{
+    u64 ns[BENCH_REPS];
+    u64 cycles[BENCH_REPS];
+    reps = Min(reps, BENCH_REPS);
+
+    for (u32 i = 0; i < BENCH_WARMUP; ++i)
+    {
+        func(userData);
+    }
+
+    for (u32 i = 0; i < reps; ++i)
+    {
+        u64 start_ns = timer_now_ns();
+        u64 start_cycles = timer_cycles();
+        func(userData);
+        cycles[i] = timer_cycles() - start_cycles;
+        ns[i] = timer_now_ns() - start_ns;
+    }
+
+    u64 total = 0;
+    for (u32 i = 0; i < reps; ++i)
+    {
+        total += ns[i];
+    }
+
+    qsort(ns, reps, sizeof(u64), bench_compare_u64);
+    qsort(cycles, reps, sizeof(u64), bench_compare_u64);
+
+    u64 min_ns = ns[0];
+    u64 median_ns = ns[reps / 2];
+    u64 p99_ns = ns[(reps * 99) / 100];
+    u64 mean_ns = total / reps;
+    u64 median_cycles = cycles[reps / 2];
+
+    fprintf(stderr, "%-44s %10llu %10llu %10llu %12llu\n", name,
+        (unsigned long long)min_ns, (unsigned long long)median_ns,
+        (unsigned long long)p99_ns, (unsigned long long)median_cycles);
+
+    fprintf(bench_results,
+        "{\"name\": \"%s\", \"reps\": %u, \"min_ns\": %llu, \"median_ns\": %llu, \"p99_ns\": %llu, \"mean_ns\": %llu, \"median_cycles\": %llu}\n",
+        name, reps, (unsigned long long)min_ns, (unsigned long long)median_ns,
+        (unsigned long long)p99_ns, (unsigned long long)mean_ns, (unsigned long long)median_cycles);
+}
+
+///////////////////////////////////////////////////////////////
+// setup
+
+internal String8
+bench_name(Arena *arena, char *prefix, u32 n)
+{
+    char buffer[MAX_STRING_SIZE];
+    int len = snprintf(buffer, sizeof(buffer), "%s%04u", prefix, n);
+    return str8_copy(arena, str8((u8 *)buffer, (u64)len));
+}
+
+// Full lists, every player in the first event, a sparse registration pattern elsewhere
+internal void
+bench_setup(BenchContext *ctx)
+{
+    ctx->arena = arena_alloc(MegaByte(64));
+    ctx->players = players_list_init(ctx->arena, MAX_NUM_ENTITIES);
+    ctx->events = events_list_init(ctx->arena, MAX_NUM_ENTITIES);
+
+    u32 capacity = MAX_NUM_ENTITIES - 2;
+    for (u32 i = 0; i < capacity; ++i)
+    {
+        players_list_add(&ctx->players, bench_name(ctx->arena, "Player", i));
+        events_list_add(&ctx->events, bench_name(ctx->arena, "Torneo", i));
+    }
+
+    // Players are inserted at the head, the first one added is the last in list order
+    ctx->last_player = bench_name(ctx->arena, "Player", 0);
+
+    String8 main_event = bench_name(ctx->arena, "Torneo", 0);
+    ctx->event_idx = events_list_find(&ctx->events, main_event);
+    Event *event = ctx->events.events + ctx->event_idx;
+    event->format = FORMAT_GROUP_KNOCKOUT;
+    event->group_phase.group_size = MAX_GROUP_SIZE;
+
+    for (u32 p = 0; p < capacity; ++p)
+    {
+        String8 player = bench_name(ctx->arena, "Player", p);
+        register_player_to_event(&ctx->players, &ctx->events, player, main_event);
+        for (u32 e = 1 + p % 4; e < capacity; e += 4)
+        {
+            register_player_to_event(&ctx->players, &ctx->events, player, bench_name(ctx->arena, "Torneo", e));
+        }
+    }
+
+    // Every group match of the main event played
+    GroupPhase *gp = &event->group_phase;
+    for (u32 g = 0; g < gp->num_groups; ++g)
+    {
+        for (u32 row = 0; row < MAX_GROUP_SIZE; ++row)
+        {
+            for (u32 col = 0; col < MAX_GROUP_SIZE; ++col)
+            {
+                if (row != col)
+                {
+                    gp->scores[g][row][col] = (MatchScore){ (u16)((row * 7 + col) % 5), (u16)((col * 7 + row) % 5) };
+                }
+            }
+        }
+    }
+    tournament_populate_bracket_from_groups(event);
+}
+
+///////////////////////////////////////////////////////////////
+// cases
+
+internal void
+bench_players_list_find(void *userData)
+{
+    BenchContext *ctx = userData;
+    u32 idx = players_list_find(&ctx->players, ctx->last_player);
+    assert(idx != ctx->players.len - 1);
+}
+
+internal void
+bench_players_list_find_missing(void *userData)
+{
+    BenchContext *ctx = userData;
+    u32 idx = players_list_find(&ctx->players, str8_lit("Nobody"));
+    assert(idx == ctx->players.len - 1);
+}
+
+internal void
+bench_register_unregister(void *userData)
+{
+    BenchContext *ctx = userData;
+    String8 player = ctx->last_player;
+    String8 event = ctx->events.events[ctx->event_idx].name;
+    unregister_player_from_event(&ctx->players, &ctx->events, player, event);
+    register_player_to_event(&ctx->players, &ctx->events, player, event);
+}
+
+internal void
+bench_construct_bracket(void *userData)
+{
+    BenchContext *ctx = userData;
+    tournament_construct_bracket(ctx->events.events + ctx->event_idx);
+}
+
+internal void
+bench_construct_groups(void *userData)
+{
+    BenchContext *ctx = userData;
+    Event *event = ctx->events.events + ctx->event_idx;
+
+    // construct_groups clears the scores, work on a copy
+    local_persist Event copy;
+    copy = *event;
+    tournament_construct_groups(&copy);
+}
+
+internal void
+bench_populate_bracket_from_groups(void *userData)
+{
+    BenchContext *ctx = userData;
+    tournament_populate_bracket_from_groups(ctx->events.events + ctx->event_idx);
+}
+
+internal void
+bench_seeding_256(void *userData)
+{
+    (void)userData;
+
+    // 128 groups of which the first two advance, past the app's limits
+    local_persist u16 groups[256];
+    local_persist u16 tiers[256];
+    local_persist u32 lines[256];
+    for (u32 i = 0; i < ArrayCount(groups); ++i)
+    {
+        groups[i] = (u16)(i % 128);
+        tiers[i] = (u16)(i / 128);
+    }
+    seeding_assign_lines(groups, tiers, ArrayCount(groups), lines);
+}
+
+internal void
+bench_group_standings(void *userData)
+{
+    BenchContext *ctx = userData;
+    u8 standings[MAX_GROUP_SIZE];
+    calculate_group_standings(ctx->events.events + ctx->event_idx, 0, standings, MAX_GROUP_SIZE);
+}
+
+internal void
+bench_save(void *userData)
+{
+    BenchContext *ctx = userData;
+    olympiad_save(&ctx->players, &ctx->events);
+}
+
+internal void
+bench_save_archive(void *userData)
+{
+    BenchContext *ctx = userData;
+    olympiad_save_archive(&ctx->players, &ctx->events, "build/bench_archive.sav");
+}
+
+internal void
+bench_load_file(void *userData, const char *path)
+{
+    BenchContext *ctx = userData;
+
+    // Names are pushed on the arena, rewind it after every load
+    Temp temp = temp_begin(ctx->arena);
+    PlayersList players = players_list_init(temp.arena, MAX_NUM_ENTITIES);
+    EventsList events = events_list_init(temp.arena, MAX_NUM_ENTITIES);
+    olympiad_load_file(temp.arena, &players, &events, path);
+    temp_end(temp);
+}
+
+internal void bench_load(void *userData)         { bench_load_file(userData, "build/bench.sav"); }
+internal void bench_load_archive(void *userData) { bench_load_file(userData, "build/bench_archive.sav"); }
+internal void bench_load_upgrade(void *userData) { bench_load_file(userData, BENCH_SAVE_V2); }
+
+int
+main(int argc, char **argv)
+{
+    ctx_init();
+
+    const char *results_path = argc > 1 ? argv[1] : "build/bench.json";
+    bench_results = fopen(results_path, "w");
+    if (!bench_results)
+    {
+        printf("Cannot open %s\n", results_path);
+        return 1;
+    }
+
+    // The upgrade case only measures the upgrade on a version 2 file
+    SaveHeader header = {0};
+    FILE *fixture = fopen(BENCH_SAVE_V2, "rb");
+    b32 is_v2 = fixture && fread(&header, sizeof(header), 1, fixture) == 1 && header.version == 2;
+    if (fixture) fclose(fixture);
+    if (!is_v2)
+    {
+        printf("%s is not a version 2 save\n", BENCH_SAVE_V2);
+        return 1;
+    }
+
+    BenchContext ctx = {0};
+    bench_setup(&ctx);
+
+    // Save/load print a line per call, silence stdout to keep the table readable
+    olympiad_save_file = "build/bench.sav";
+    olympiad_temp_file = "build/bench.tmp";
+    olympiad_save(&ctx.players, &ctx.events);
+    olympiad_save_archive(&ctx.players, &ctx.events, "build/bench_archive.sav");
+#if OS_WINDOWS
+    FILE *quiet = freopen("NUL", "w", stdout);
+#else
+    FILE *quiet = freopen("/dev/null", "w", stdout);
+#endif
+    (void)quiet;
+
+    typedef struct { char *name; BenchFunc *func; u32 reps; } BenchCase;
+    BenchCase cases[] = {
+        { "players_list_find",                      bench_players_list_find,            BENCH_REPS },
+        { "players_list_find (missing)",            bench_players_list_find_missing,    BENCH_REPS },
+        { "register + unregister",                  bench_register_unregister,          BENCH_REPS },
+        { "tournament_construct_bracket",           bench_construct_bracket,            BENCH_REPS },
+        { "tournament_construct_groups",            bench_construct_groups,             BENCH_REPS },
+        { "tournament_populate_bracket_from_groups", bench_populate_bracket_from_groups, BENCH_REPS },
+        { "seeding_assign_lines (256 qualifiers)",  bench_seeding_256,                  BENCH_REPS },
+        { "calculate_group_standings",              bench_group_standings,              BENCH_REPS },
+        { "olympiad_save",                          bench_save,                         64 },
+        { "olympiad_save_archive",                  bench_save_archive,                 64 },
+        { "olympiad_load",                          bench_load,                         64 },
+        { "olympiad_load (archive)",                bench_load_archive,                 64 },
+        { "olympiad_load (v2 upgrade)",             bench_load_upgrade,                 64 },
+    };
+
+    for (u32 i = 0; i < ArrayCount(cases); ++i)
+    {
+        if (i == 0)
+        {
+            fprintf(stderr, "%-44s %10s %10s %10s %12s\n", "case", "min ns", "median ns", "p99 ns", "med cycles");
+        }
+        bench_run(cases[i].name, cases[i].func, &ctx, cases[i].reps);
+    }
+
+    fclose(bench_results);
+    fprintf(stderr, "Results written to %s\n", results_path);
+
+    return 0;
+}
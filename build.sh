@@ -27,6 +27,15 @@ RELEASE_RAYLIB_INCLUDES=$(pkg-config --cflags raylib)
 RELEASE_RAYLIB_STATIC="/opt/homebrew/lib/libraylib.a"
 RELEASE_MACOS_FRAMEWORKS="-framework CoreVideo -framework IOKit -framework Cocoa -framework GLUT -framework OpenGL"
 
+# ------------------------------------------------------------------------------
+# Linux
+# - clock_gettime (timer.c) is hidden by -std=c99 unless POSIX is requested
+# ------------------------------------------------------------------------------
+if [[ "$(uname)" == "Linux" ]]; then
+    DEBUG_CFLAGS="$DEBUG_CFLAGS -D_POSIX_C_SOURCE=199309L"
+    RELEASE_CFLAGS="$RELEASE_CFLAGS -D_POSIX_C_SOURCE=199309L"
+fi
+
 # Parse flags
 PREPROCESS_ONLY=false
 if [[ "$1" == "-p" ]]; then
@@ -36,13 +45,15 @@ fi
 
 # Show help message
 show_help() {
-    echo "Usage: $0 [-p] [debug|tests|generate|release|clean]"
+    echo "Usage: $0 [-p] [debug|tests|generate|headless|bench|release|clean]"
     echo
     echo "  -p               Run preprocessor only (outputs .i file)"
     echo
     echo "  debug            Compile $SRC -> $DEBUG_OUT (with AddressSanitizer)"
     echo "  tests            Compile tests.c -> tests"
-    echo "  generate         Compile generate_save.c -> generate_save (creates olympiad.sav)"
+    echo "  generate         Compile generate_save.c -> generate_save (synthetic olympiad.sav, see its options)"
+    echo "  headless         Compile headless.c -> headless (scriptable engine, no raylib)"
+    echo "  bench            Compile bench/bench.c -> bench (optimized, run from the repository root)"
     echo "  release          Compile $SRC -> $RELEASE_OUT (distributable, statically linked)"
     echo "  clean            Remove the build directory"
     echo
@@ -98,6 +109,14 @@ case "$1" in
         echo "Compiling generate_save.c -> generate_save"
         clang $DEBUG_CFLAGS generate_save.c -o $BUILD_DIR/generate_save
         ;;
+    headless)
+        echo "Compiling headless.c -> headless"
+        clang $RELEASE_CFLAGS headless.c -o $BUILD_DIR/headless
+        ;;
+    bench)
+        echo "Compiling bench.c -> bench"
+        clang $RELEASE_CFLAGS bench/bench.c -o $BUILD_DIR/bench
+        ;;
     release)
         echo "Compiling $SRC -> $RELEASE_OUT (release build, statically linked)"
         clang $RELEASE_CFLAGS $SRC -o $BUILD_DIR/$RELEASE_OUT $RELEASE_RAYLIB_INCLUDES $RELEASE_RAYLIB_STATIC $RELEASE_MACOS_FRAMEWORKS
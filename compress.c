@@ -0,0 +1,280 @@
+#include <assert.h>
+
+#include "core.h"
+#include "compress.h"
+
+internal u32
+compress_read_u32(u8 *p)
+{
+    u32 result;
+    MemoryCopy(&result, p, sizeof(result));
+    return result;
+}
+
+internal u32
+compress_hash(u32 value)
+{
+    return (value * 2654435761u) >> (32 - COMPRESS_HASH_BITS);
+}
+
+internal u8 *
+compress_write_length(u8 *dst, u8 token, u64 length)
+{
+    // length is already relative to the token minimum
+    if (length < 0x3F)
+    {
+        *dst++ = token | (u8)length;
+        return dst;
+    }
+
+    *dst++ = token | 0x3F;
+    length -= 0x3F;
+    while (length >= 0x80)
+    {
+        *dst++ = (u8)(length | 0x80);
+        length >>= 7;
+    }
+    *dst++ = (u8)length;
+    return dst;
+}
+
+internal u8 *
+compress_write_literals(u8 *dst, u8 *src, u64 count)
+{
+    while (count > 0)
+    {
+        u64 run = Min(count, 128);
+        *dst++ = (u8)(run - 1);
+        MemoryCopy(dst, src, run);
+        dst += run;
+        src += run;
+        count -= run;
+    }
+    return dst;
+}
+
+/**
+ * Compress a single block.
+ *
+ * Greedy parse: zero runs first (the save file is mostly zero-filled
+ * matrices), then 4-byte matches found through a small hash table of the
+ * last position seen for each hash, then literals.
+ *
+ * @param src       Input bytes, at most COMPRESS_BLOCK_SIZE
+ * @param src_size  Number of input bytes
+ * @param dst       Output buffer, at least COMPRESS_BLOCK_BOUND(src_size) bytes
+ * @return          Number of bytes written to dst
+ */
+u64
+compress_block(u8 *src, u64 src_size, u8 *dst)
+{
+    assert(src_size <= COMPRESS_BLOCK_SIZE);
+
+    // Positions are stored +1 so that zero means empty
+    u32 table[1 << COMPRESS_HASH_BITS];
+    MemoryZeroArray(table);
+
+    u8 *out = dst;
+    u64 i = 0;
+    u64 literal_start = 0;
+
+    while (i + COMPRESS_MIN_RUN <= src_size)
+    {
+        if (src[i] == 0)
+        {
+            u64 end = i;
+            while (end < src_size && src[end] == 0)
+            {
+                ++end;
+            }
+            if (end - i >= COMPRESS_MIN_RUN)
+            {
+                out = compress_write_literals(out, src + literal_start, i - literal_start);
+                out = compress_write_length(out, 0x80, end - i - COMPRESS_MIN_RUN);
+                i = end;
+                literal_start = i;
+                continue;
+            }
+        }
+
+        u32 value = compress_read_u32(src + i);
+        u32 hash = compress_hash(value);
+        u64 candidate = table[hash];
+        table[hash] = (u32)(i + 1);
+
+        if (candidate != 0 && compress_read_u32(src + candidate - 1) == value)
+        {
+            u64 match = candidate - 1;
+            u64 length = COMPRESS_MIN_RUN;
+            while (i + length < src_size && src[match + length] == src[i + length])
+            {
+                ++length;
+            }
+
+            out = compress_write_literals(out, src + literal_start, i - literal_start);
+            out = compress_write_length(out, 0xC0, length - COMPRESS_MIN_RUN);
+
+            u16 offset = (u16)(i - match);
+            MemoryCopy(out, &offset, sizeof(offset));
+            out += sizeof(offset);
+
+            i += length;
+            literal_start = i;
+            continue;
+        }
+
+        ++i;
+    }
+
+    out = compress_write_literals(out, src + literal_start, src_size - literal_start);
+
+    return (u64)(out - dst);
+}
+
+internal b32
+decompress_read_length(u8 **at, u8 *end, u8 token, u64 *length)
+{
+    *length = token & 0x3F;
+    if (*length < 0x3F)
+    {
+        return true;
+    }
+
+    for (u32 shift = 0; shift < 64; shift += 7)
+    {
+        if (*at >= end)
+        {
+            return false;
+        }
+        u8 byte = *(*at)++;
+        *length += (u64)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Decompress a single block.
+ *
+ * @return Number of bytes written to dst, or 0 if the input is malformed
+ *         or does not fit in dst_size bytes
+ */
+u64
+decompress_block(u8 *src, u64 src_size, u8 *dst, u64 dst_size)
+{
+    u8 *at = src;
+    u8 *end = src + src_size;
+    u64 out = 0;
+
+    while (at < end)
+    {
+        u8 token = *at++;
+
+        if (token < 0x80)
+        {
+            u64 run = (u64)token + 1;
+            if (run > (u64)(end - at) || run > dst_size - out) return 0;
+            MemoryCopy(dst + out, at, run);
+            at += run;
+            out += run;
+            continue;
+        }
+
+        u64 length;
+        if (!decompress_read_length(&at, end, token, &length)) return 0;
+        length += COMPRESS_MIN_RUN;
+        if (length > dst_size - out) return 0;
+
+        if (token < 0xC0)
+        {
+            MemoryZero(dst + out, length);
+        }
+        else
+        {
+            if ((u64)(end - at) < sizeof(u16)) return 0;
+            u16 offset;
+            MemoryCopy(&offset, at, sizeof(offset));
+            at += sizeof(offset);
+            if (offset == 0 || offset > out) return 0;
+
+            // Byte by byte, the source may overlap the bytes being written
+            u8 *from = dst + out - offset;
+            for (u64 k = 0; k < length; ++k)
+            {
+                dst[out + k] = from[k];
+            }
+        }
+        out += length;
+    }
+
+    return out;
+}
+
+/**
+ * Compress a buffer as a sequence of independent blocks.
+ *
+ * @param dst  Output buffer, at least COMPRESS_BOUND(src_size) bytes
+ * @return     Number of bytes written to dst
+ */
+u64
+compress_stream(u8 *src, u64 src_size, u8 *dst)
+{
+    u64 out = 0;
+    for (u64 offset = 0; offset < src_size; offset += COMPRESS_BLOCK_SIZE)
+    {
+        u32 raw_size = (u32)Min(COMPRESS_BLOCK_SIZE, src_size - offset);
+        u8 *block = dst + out + 2 * sizeof(u32);
+
+        u32 packed_size = (u32)compress_block(src + offset, raw_size, block);
+        if (packed_size >= raw_size)
+        {
+            // Incompressible, store it as is
+            MemoryCopy(block, src + offset, raw_size);
+            packed_size = raw_size;
+        }
+
+        MemoryCopy(dst + out, &raw_size, sizeof(u32));
+        MemoryCopy(dst + out + sizeof(u32), &packed_size, sizeof(u32));
+        out += 2 * sizeof(u32) + packed_size;
+    }
+    return out;
+}
+
+/**
+ * Decompress a stream written by compress_stream.
+ *
+ * @return Number of bytes written to dst, or 0 if the stream is malformed
+ */
+u64
+decompress_stream(u8 *src, u64 src_size, u8 *dst, u64 dst_size)
+{
+    u64 in = 0;
+    u64 out = 0;
+    while (in < src_size)
+    {
+        if (src_size - in < 2 * sizeof(u32)) return 0;
+
+        u32 raw_size, packed_size;
+        MemoryCopy(&raw_size, src + in, sizeof(u32));
+        MemoryCopy(&packed_size, src + in + sizeof(u32), sizeof(u32));
+        in += 2 * sizeof(u32);
+
+        if (packed_size > src_size - in || raw_size > dst_size - out) return 0;
+
+        if (packed_size == raw_size)
+        {
+            MemoryCopy(dst + out, src + in, raw_size);
+        }
+        else if (decompress_block(src + in, packed_size, dst + out, raw_size) != raw_size)
+        {
+            return 0;
+        }
+
+        in += packed_size;
+        out += raw_size;
+    }
+    return out;
+}
@@ -0,0 +1,40 @@
+#ifndef COMPRESS_H
+#define COMPRESS_H
+
+#include "core.h"
+
+// Byte-oriented LZ codec with a dedicated token for runs of zeroes.
+//
+// A stream is split in blocks of at most COMPRESS_BLOCK_SIZE bytes, each
+// compressed on its own, so both sides only ever need a fixed-size buffer:
+//
+//   u32 raw_size | u32 packed_size | packed_size bytes
+//
+// packed_size == raw_size means the block is stored uncompressed.
+//
+// Inside a block the data is a sequence of tokens:
+//
+//   0x00-0x7F  literal run, (t + 1) bytes follow
+//   0x80-0xBF  zero run, (t & 0x3F) + COMPRESS_MIN_RUN zeroes
+//   0xC0-0xFF  match, (t & 0x3F) + COMPRESS_MIN_RUN bytes copied from u16 offset back
+//
+// A length field of 0x3F is followed by a LEB128 varint with the rest of the length.
+
+#define COMPRESS_BLOCK_SIZE  KiloByte(64)
+#define COMPRESS_MIN_RUN     4
+#define COMPRESS_HASH_BITS   12
+
+// Worst case size of a compressed block (all literals)
+#define COMPRESS_BLOCK_BOUND(n) ((n) + (n) / 128 + 16)
+
+// Worst case size of a compressed stream: incompressible blocks are stored as
+// is, plus room for compress_block to overshoot before falling back to that
+#define COMPRESS_BOUND(n) ((n) + CeilIntegerDiv((n), COMPRESS_BLOCK_SIZE) * 2 * sizeof(u32) + COMPRESS_BLOCK_SIZE / 128 + 16)
+
+u64 compress_block(u8 *src, u64 src_size, u8 *dst);
+u64 decompress_block(u8 *src, u64 src_size, u8 *dst, u64 dst_size);
+
+u64 compress_stream(u8 *src, u64 src_size, u8 *dst);
+u64 decompress_stream(u8 *src, u64 src_size, u8 *dst, u64 dst_size);
+
+#endif // COMPRESS_H
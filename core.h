@@ -17,6 +17,12 @@
 #define global        static
 #define local_persist static
 
+#if COMPILER_MSVC
+# define thread_static __declspec(thread)
+#else
+# define thread_static __thread
+#endif
+
 ////////////////////////////////
 //~ rjf: Base Types
 
@@ -1,13 +1,29 @@
+#include <time.h>
+
 #include "arena.h"
 #include "layout.h"
 #include "players.h"
+#include "profiler.h"
+#include "input.h"
+#include "pool.h"
+#include "snapshot.h"
+#include "history.h"
+#include "schedule.h"
 #include "raylib/raylib.h"
 #define CLAY_IMPLEMENTATION
 
 #include "core.h"
 #include "arena.c"
 #include "string.c"
+#include "compress.c"
 #include "players.c"
+#include "timer.c"
+#include "profiler.c"
+#include "input.c"
+#include "pool.c"
+#include "snapshot.c"
+#include "history.c"
+#include "schedule.c"
 
 #include "clay.h"
 #include "layout.c"
@@ -23,17 +39,331 @@ HandleClayErrors(Clay_ErrorData errorData)
     printf("%s", errorData.errorText.chars);
 }
 
+// ============================================================================
+// Frame scheduler
+// ============================================================================
+//
+// The UI only changes in response to input, so once the screen has settled the
+// loop stops polling and EndDrawing blocks until the OS delivers an event
+// (EnableEventWaiting). Anything that animates on its own keeps the loop
+// awake: Clay's scroll momentum and a short settle window after the last input
+// (hover state catches up one frame late). The blinking cursor of a focused
+// textbox only needs a frame per toggle: raylib cannot wait with a timeout, so
+// the loop polls without blocking and then sleeps in GLFW until the next toggle
+// or the next event, whichever comes first. Pending autosaves are flushed right
+// before going to sleep instead of waking up for them.
+//
+// A replay never waits: there are no OS events to wake it up, the recorded
+// frames already are the ones that happened.
+
+#define FRAME_SETTLE_SECONDS   0.35  // Hover transitions after the last input
+#define FRAME_MAX_DELTA        (1.0f / 30.0f)
+#define AUTOSAVE_SECONDS       30.0
+
+typedef struct FrameScheduler FrameScheduler;
+struct FrameScheduler {
+    f64 lastActivityTime;
+    f64 lastSaveTime;
+    u64 savedVersion;   // history.version of the last save
+    b32 waiting;    // EndDrawing of the previous frame waited for events
+    f64 blinkWait;  // Seconds to sleep after EndDrawing, 0 when not blinking
+};
+
+// Part of the GLFW that raylib links in on desktop, raylib has no timed wait
+extern void glfwWaitEventsTimeout(double timeout);
+
+internal b32
+frame_has_input(void)
+{
+    Vector2 mouseDelta = input_mouse_delta();
+    Vector2 wheel = input_mouse_wheel();
+
+    return mouseDelta.x != 0 || mouseDelta.y != 0 ||
+           wheel.x != 0 || wheel.y != 0 || input_any_key_down() ||
+           input_mouse_down(MOUSE_BUTTON_LEFT) || input_mouse_down(MOUSE_BUTTON_RIGHT) ||
+           input_mouse_released(MOUSE_BUTTON_LEFT) || input_mouse_released(MOUSE_BUTTON_RIGHT) ||
+           input_window_resized();
+}
+
+/**
+ * Record this frame's activity, called once per frame before building the layout.
+ */
+internal void
+frame_scheduler_begin(FrameScheduler *scheduler, f64 now)
+{
+    // Waking up from an event wait means the OS delivered something (keys included)
+    if (scheduler->waiting || frame_has_input())
+    {
+        scheduler->lastActivityTime = now;
+    }
+}
+
+/**
+ * Decide whether EndDrawing may block until the next event.
+ *
+ * Call after the frame is built and before EndDrawing, so that the frame
+ * being presented is already the settled one.
+ */
+internal void
+frame_scheduler_end(FrameScheduler *scheduler, f64 now, PlayersList *players, EventsList *events)
+{
+    b32 animating = LayoutScrollAnimating() || now - scheduler->lastActivityTime < FRAME_SETTLE_SECONDS;
+    b32 blinking = data.focusedTextbox != TEXTBOX_NULL;
+
+    // Only changes to the olympiad are saved, not every mouse move
+    b32 dirty = history.version != scheduler->savedVersion;
+    if (dirty && (!animating || now - scheduler->lastSaveTime > AUTOSAVE_SECONDS))
+    {
+        ProfileBegin(ProfileZone_Autosave);
+        olympiad_save(players, events);
+        ProfileEnd(ProfileZone_Autosave);
+        scheduler->lastSaveTime = now;
+        scheduler->savedVersion = history.version;
+    }
+
+    if (input.mode == INPUT_REPLAY)
+    {
+        return;
+    }
+
+    // The blink sleeps in frame_scheduler_wait, EndDrawing itself must not block
+    b32 wait = !animating && !blinking;
+    if (wait != scheduler->waiting)
+    {
+        if (wait) EnableEventWaiting();
+        else      DisableEventWaiting();
+        scheduler->waiting = wait;
+    }
+    scheduler->blinkWait = !animating && blinking ?
+        TextInput_SecondsToBlink(&data.textInputs[data.focusedTextbox]) : 0;
+}
+
+/**
+ * Sleep until the next cursor blink or the next event, called after EndDrawing.
+ *
+ * EndDrawing has already reset raylib's pressed keys and queued characters, so
+ * the events delivered during the sleep show up in the next frame, the same as
+ * with EnableEventWaiting.
+ */
+internal void
+frame_scheduler_wait(FrameScheduler *scheduler)
+{
+    if (scheduler->blinkWait > 0)
+    {
+        glfwWaitEventsTimeout(scheduler->blinkWait);
+    }
+}
+
+// ============================================================================
+// Profiler overlay
+// ============================================================================
+//
+// F3 toggles it, F4 dumps the trace recorded so far (see profiler.h). The graph shows the CPU time of the last PROFILER_HISTORY
+// frames (sleeping in EndDrawing excluded) against the 60 and 30 fps budgets,
+// the table the last frame and the average per zone.
+
+#define PROFILER_GRAPH_MAX_MS 33.3f
+
+internal void
+profiler_draw_overlay(Font font)
+{
+    float fontSize = 16;
+    float lineHeight = 20;
+    float padding = 10;
+    float graphHeight = 80;
+    float width = PROFILER_HISTORY + 2 * padding + 60;
+    float height = padding * 3 + graphHeight + lineHeight * (2 + ProfileZone_COUNT);
+    float x = (float)GetScreenWidth() - width - padding;
+    float y = padding;
+
+    DrawRectangleRec((Rectangle){ x, y, width, height }, (Color){ 20, 20, 28, 220 });
+
+    // Frame time graph, newest frame on the right
+    float graphX = x + padding;
+    float graphY = y + padding;
+    float budgets[] = { 1000.0f / 60.0f, 1000.0f / 30.0f };
+    for (u32 i = 0; i < ArrayCount(budgets); i++)
+    {
+        float lineY = graphY + graphHeight * (1.0f - budgets[i] / PROFILER_GRAPH_MAX_MS);
+        DrawLineV((Vector2){ graphX, lineY }, (Vector2){ graphX + PROFILER_HISTORY, lineY }, (Color){ 120, 120, 140, 255 });
+        DrawTextEx(font, TextFormat("%.0f ms", budgets[i]), (Vector2){ graphX + PROFILER_HISTORY + 6, lineY - 8 }, 14, 0, LIGHTGRAY);
+    }
+    for (u32 age = 0; age < profiler.count; age++)
+    {
+        ProfileFrame *frame = profiler_frame(age);
+        float barHeight = graphHeight * ClampTop(frame->total_ms / PROFILER_GRAPH_MAX_MS, 1.0f);
+        Color color = frame->total_ms > budgets[1] ? RED : frame->total_ms > budgets[0] ? ORANGE : GREEN;
+        float barX = graphX + (float)(PROFILER_HISTORY - 1 - age);
+        DrawLineV((Vector2){ barX, graphY + graphHeight }, (Vector2){ barX, graphY + graphHeight - barHeight }, color);
+    }
+
+    float textY = graphY + graphHeight + padding;
+    ProfileFrame *last = profiler_frame(0);
+    DrawTextEx(font, TextFormat("frame %.2f ms   p50 %.2f ms   p99 %.2f ms",
+                                last ? last->total_ms : 0.0f, profiler_percentile(50), profiler_percentile(99)),
+               (Vector2){ graphX, textY }, fontSize, 0, RAYWHITE);
+    textY += lineHeight;
+
+    DrawTextEx(font, "zone", (Vector2){ graphX, textY }, fontSize, 0, GRAY);
+    DrawTextEx(font, "last", (Vector2){ graphX + 170, textY }, fontSize, 0, GRAY);
+    DrawTextEx(font, "avg", (Vector2){ graphX + 250, textY }, fontSize, 0, GRAY);
+    textY += lineHeight;
+
+    for (u32 zone = 0; zone < ProfileZone_COUNT; zone++)
+    {
+        float indent = (zone == ProfileZone_ClayEndLayout) ? 12.0f : 0.0f;  // Nested in Layout
+        DrawTextEx(font, profile_zone_names[zone], (Vector2){ graphX + indent, textY }, fontSize, 0, RAYWHITE);
+        DrawTextEx(font, TextFormat("%.2f", last ? last->zone_ms[zone] : 0.0f), (Vector2){ graphX + 170, textY }, fontSize, 0, RAYWHITE);
+        DrawTextEx(font, TextFormat("%.2f", profiler_zone_average((ProfileZone)zone)), (Vector2){ graphX + 250, textY }, fontSize, 0, RAYWHITE);
+        textY += lineHeight;
+    }
+}
+
+// ============================================================================
+// Replay benchmark
+// ============================================================================
+//
+// With --replay every frame's profile is kept and a report of the whole run
+// is printed at the end. The frames and their input are the recorded ones, so
+// two reports of the same recording compare the code, not the session.
+
+#define REPLAY_MAX_FRAMES Million(1)
+
+typedef struct ReplayStats ReplayStats;
+struct ReplayStats {
+    ProfileFrame *frames;
+    u64 count;
+};
+
+internal int
+replay_compare_f32(const void *a, const void *b)
+{
+    f32 x = *(const f32 *)a;
+    f32 y = *(const f32 *)b;
+    return (x > y) - (x < y);
+}
+
+internal void
+replay_report_row(const char *name, f32 *values, u64 count)
+{
+    f64 sum = 0;
+    for (u64 i = 0; i < count; i++)
+    {
+        sum += values[i];
+    }
+    qsort(values, count, sizeof(f32), replay_compare_f32);
+
+    printf("%-16s %8.3f %8.3f %8.3f %8.3f\n", name, sum / (f64)count,
+           values[(count - 1) / 2], values[(u64)((f64)(count - 1) * 0.99)], values[count - 1]);
+}
+
+internal void
+replay_report(ReplayStats *stats)
+{
+    if (stats->count == 0)
+    {
+        printf("Replay: no frames\n");
+        return;
+    }
+
+    Temp temp = scratch_get(0, 0);
+    f32 *values = push_array(temp.arena, f32, stats->count);
+
+    printf("Replay: %llu frames\n", (unsigned long long)stats->count);
+    printf("%-16s %8s %8s %8s %8s  (ms)\n", "", "mean", "p50", "p99", "max");
+
+    for (u64 i = 0; i < stats->count; i++) values[i] = stats->frames[i].total_ms;
+    replay_report_row("Frame", values, stats->count);
+
+    for (u32 zone = 0; zone < ProfileZone_COUNT; zone++)
+    {
+        for (u64 i = 0; i < stats->count; i++) values[i] = stats->frames[i].zone_ms[zone];
+        replay_report_row(profile_zone_names[zone], values, stats->count);
+    }
+
+    scratch_release(temp);
+}
+
+internal void
+print_usage(void)
+{
+    printf("Usage: enniolimpiadi [--record FILE | --replay FILE [--hidden]]\n");
+    printf("  --record FILE   record the input of this session (and the olympiad it starts from)\n");
+    printf("  --replay FILE   play a recording back as fast as possible and print frame times\n");
+    printf("  --hidden        with --replay, do not show the window\n");
+}
+
 int
-main(void)
+main(int argc, char **argv)
 {
     // Initialize ctx for using scratch arenas
     ctx_init();
 
-    Clay_Raylib_Initialize(1280, 720, "Enniolimpiadi 2026",
-        FLAG_WINDOW_RESIZABLE | FLAG_WINDOW_HIGHDPI | FLAG_MSAA_4X_HINT | FLAG_VSYNC_HINT);
+    const char *recordPath = NULL;
+    const char *replayPath = NULL;
+    b32 hidden = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if      (!strcmp(argv[i], "--record") && i + 1 < argc) recordPath = argv[++i];
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc) replayPath = argv[++i];
+        else if (!strcmp(argv[i], "--hidden"))                 hidden = true;
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+    if ((recordPath && replayPath) || (hidden && !replayPath))
+    {
+        print_usage();
+        return 1;
+    }
+
+    // Always recording, so that a stall can be dumped right after it happened
+    trace_set_enabled(true);
+
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players_list = players_list_init(arena, 64);
+    EventsList events_list = events_list_init(arena, 64);
+
+    ReplayStats replayStats = {0};
+    if (replayPath)
+    {
+        if (!input_replay_begin(arena, replayPath, &players_list, &events_list))
+        {
+            return 1;
+        }
+        replayStats.frames = push_array(arena_alloc(ARENA_HEADER_SIZE + REPLAY_MAX_FRAMES * sizeof(ProfileFrame) + 64),
+                                        ProfileFrame, REPLAY_MAX_FRAMES);
+        profiler_set_enabled(true);
+    }
+    else
+    {
+        olympiad_load(arena, &players_list, &events_list);
+    }
+
+    if (replayPath)
+    {
+        // Same window size as the recording, and no vsync: frames run back to back
+        s32 width, height;
+        input_replay_screen_size(&width, &height);
+        Clay_Raylib_Initialize(width, height, "Enniolimpiadi 2026",
+            FLAG_WINDOW_RESIZABLE | FLAG_WINDOW_HIGHDPI | FLAG_MSAA_4X_HINT | (hidden ? FLAG_WINDOW_HIDDEN : 0));
+    }
+    else
+    {
+        Clay_Raylib_Initialize(1280, 720, "Enniolimpiadi 2026",
+            FLAG_WINDOW_RESIZABLE | FLAG_WINDOW_HIGHDPI | FLAG_MSAA_4X_HINT | FLAG_VSYNC_HINT);
+
+        // Maximize window after creation to get proper dimensions
+        MaximizeWindow();
+    }
 
-    // Maximize window after creation to get proper dimensions
-    MaximizeWindow();
+    if (recordPath && !input_record_begin(recordPath, &players_list, &events_list))
+    {
+        return 1;
+    }
 
     // Increased with respect to the default
     Clay_SetMaxElementCount(32768);
@@ -58,16 +388,11 @@ main(void)
 
     Clay_SetDebugModeEnabled(false);
 
-    Arena *arena = arena_alloc(MegaByte(10));
-
-    PlayersList players_list = players_list_init(arena, 64);
-    EventsList events_list = events_list_init(arena, 64);
-
-    olympiad_load(arena, &players_list, &events_list);
-
     // Initialization of global data
     data.arena = arena;
     data.frameArena = arena_alloc(MegaByte(1));
+    snapshot_store_init(&snapshot_store, arena);
+    schedule_init(&schedule, 16, 4);
 
     data.yOffset = 0;
     data.fonts = fonts;
@@ -81,37 +406,81 @@ main(void)
     data.groupsPanelVisible   = true;
     data.knockoutPanelVisible = true;
 
-    f64 lastSaveTime = 0;
+    // The loaded olympiad is already on disk
+    FrameScheduler scheduler = { .savedVersion = history.version };
     while (!WindowShouldClose())
     {
-        f64 currentTime = GetTime();
-        if (currentTime - lastSaveTime > 30.0)
+        input_begin_frame();
+        if (input_replay_finished())
         {
-            olympiad_save(&players_list, &events_list);
-            lastSaveTime = currentTime;
+            break;
         }
 
-        Clay_SetLayoutDimensions((Clay_Dimensions) {
-            .width = GetScreenWidth(),
-            .height = GetScreenHeight()
-        });
+        profiler_frame_begin();
+        frame_scheduler_begin(&scheduler, input_time());
 
-        // Reset cursor state at start of frame (handlers will update it)
-        data.mouseCursor = MOUSE_CURSOR_DEFAULT;
+        // A replay always profiles, whatever was toggled during the recording
+        if (input_key_pressed(KEY_F3) && input.mode != INPUT_REPLAY)
+        {
+            profiler_set_enabled(!profiler.enabled);
+        }
+        if (input_key_pressed(KEY_F4))
+        {
+            const char *path = TextFormat("trace-%lld.json", (long long)time(NULL));
+            printf(trace_dump(path) ? "Trace written to %s\n" : "Cannot write %s\n", path);
+        }
 
-        Vector2 mousePosition = GetMousePosition();
-        Vector2 scrollDelta = GetMouseWheelMoveV();
+        // Cmd+Z undoes the last change, Cmd+Shift+Z redoes it (Ctrl on the other
+        // platforms). Not while typing: the text boxes keep the keys.
+        b32 command = input_key_down(KEY_LEFT_SUPER) || input_key_down(KEY_RIGHT_SUPER) ||
+                      input_key_down(KEY_LEFT_CONTROL) || input_key_down(KEY_RIGHT_CONTROL);
+        if (command && input_key_pressed(KEY_Z) && data.focusedTextbox == TEXTBOX_NULL)
+        {
+            if (input_key_down(KEY_LEFT_SHIFT) || input_key_down(KEY_RIGHT_SHIFT))
+            {
+                history_redo(&data.players, &data.tournaments);
+            }
+            else
+            {
+                history_undo(&data.players, &data.tournaments);
+            }
+        }
 
-        Clay_SetPointerState((Clay_Vector2) { mousePosition.x, mousePosition.y }, IsMouseButtonDown(0));
-        Clay_UpdateScrollContainers(true, (Clay_Vector2) { scrollDelta.x, scrollDelta.y }, GetFrameTime());
+        // Only the events changed since the last frame are looked at
+        schedule_update(&schedule, &data.players, &data.tournaments);
+
+        Clay_RenderCommandArray renderCommands = data.layoutCommands;
+        if (!LayoutCacheReusable())
+        {
+            Clay_SetLayoutDimensions((Clay_Dimensions) {
+                .width = GetScreenWidth(),
+                .height = GetScreenHeight()
+            });
 
-        Clay_RenderCommandArray renderCommands = CreateLayout();
+            // Reset cursor state at start of frame (handlers will update it, a cached frame keeps it)
+            data.mouseCursor = MOUSE_CURSOR_DEFAULT;
+
+            Vector2 mousePosition = input_mouse_position();
+            Vector2 scrollDelta = input_mouse_wheel();
+
+            Clay_SetPointerState((Clay_Vector2) { mousePosition.x, mousePosition.y }, input_mouse_down(0));
+            // After an event wait the frame time spans the whole sleep, do not let it jump scroll momentum
+            Clay_UpdateScrollContainers(true, (Clay_Vector2) { scrollDelta.x, scrollDelta.y }, Min(input_frame_time(), FRAME_MAX_DELTA));
+
+            ProfileBegin(ProfileZone_Layout);
+            renderCommands = CreateLayout();
+            ProfileEnd(ProfileZone_Layout);
+        }
 
         BeginDrawing();
         ClearBackground(BLACK);
+
+        ProfileBegin(ProfileZone_Render);
         Clay_Raylib_Render(renderCommands, fonts);
+        ProfileEnd(ProfileZone_Render);
 
         // Render text input cursor (after Clay, so it doesn't interfere with scrolling)
+        ProfileBegin(ProfileZone_TextCursor);
         if (data.focusedTextbox != TEXTBOX_NULL)
         {
             const char *inputIdStr = TextBoxInputIds[data.focusedTextbox];
@@ -127,8 +496,23 @@ main(void)
 
             TextInput_RenderCursor(&data.textInputs[data.focusedTextbox], bounding_box, scroll_data);
         }
+        ProfileEnd(ProfileZone_TextCursor);
+
+        frame_scheduler_end(&scheduler, input_time(), &data.players, &data.tournaments);
+        profiler_frame_end();
+
+        if (input.mode == INPUT_REPLAY && replayStats.count < REPLAY_MAX_FRAMES)
+        {
+            replayStats.frames[replayStats.count++] = *profiler_frame(0);
+        }
+
+        if (profiler.enabled)
+        {
+            profiler_draw_overlay(fonts[FONT_ID_BODY_16]);
+        }
 
         EndDrawing();
+        frame_scheduler_wait(&scheduler);
 
         SetMouseCursor(data.mouseCursor);
     }
@@ -143,5 +527,11 @@ main(void)
         printf("Failed to save state!\n");
     }
 
+    input_end();
+    if (replayPath)
+    {
+        replay_report(&replayStats);
+    }
+
     Clay_Raylib_Close();
 }
@@ -1,15 +1,262 @@
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "arena.h"
 #include "core.h"
 #include "arena.c"
 #include "string.c"
+#include "compress.c"
+#include "timer.c"
+#include "profiler.c"
 #include "players.c"
 
-int main(void)
+// Synthetic olympiad generator for load testing.
+//
+// Every knob has a default, so running it without arguments still produces a
+// usable olympiad.sav. The same seed always produces the same file.
+//
+//   --players N        number of players (capped to the list capacity)
+//   --events N         number of events (capped to the list capacity)
+//   --density F        probability that a player is registered to an event (0..1)
+//   --groups F         fraction of events using FORMAT_GROUP_KNOCKOUT (0..1)
+//   --started F        fraction of events that left the registration phase (0..1)
+//   --group-played F   fraction of group matches already played in started events (0..1)
+//   --rounds-played F  fraction of knockout rounds already played in started events (0..1)
+//   --seed N           random seed
+//   --out PATH         output file (default olympiad.sav)
+
+typedef struct GeneratorOptions GeneratorOptions;
+struct GeneratorOptions {
+    u32 num_players;
+    u32 num_events;
+    f64 density;
+    f64 groups;
+    f64 started;
+    f64 group_played;
+    f64 rounds_played;
+    u64 seed;
+    const char *out;
+};
+
+global u64 rng_state;
+
+// splitmix64: tiny, fast and good enough for test data
+internal u64
+rng_next(void)
+{
+    u64 z = (rng_state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+internal f64
+rng_f64(void)
+{
+    return (f64)(rng_next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+internal u32
+rng_range(u32 n)
+{
+    return (u32)(rng_next() % n);
+}
+
+internal String8
+generate_name(Arena *arena, char *prefix, u32 n)
+{
+    char buffer[MAX_STRING_SIZE];
+    int len = snprintf(buffer, sizeof(buffer), "%s%04u", prefix, n);
+    return str8_copy(arena, str8((u8 *)buffer, (u64)len));
+}
+
+/**
+ * Play the first rounds_to_play rounds of a heap-layout bracket with random winners.
+ *
+ * Slots already filled at a parent level are byes and are left untouched.
+ */
+internal void
+generate_play_bracket(u8 *bracket, u32 num_players, u32 rounds_to_play)
+{
+    u32 leaf_level = 0;
+    while ((1u << leaf_level) < num_players)
+    {
+        leaf_level++;
+    }
+
+    for (u32 round = 0; round < rounds_to_play && round < leaf_level; ++round)
+    {
+        u32 level = leaf_level - 1 - round;
+        u32 first = (1u << level) - 1;
+        u32 last = (1u << (level + 1)) - 1;
+        for (u32 pos = first; pos < last; ++pos)
+        {
+            u8 left = bracket[2 * pos + 1];
+            u8 right = bracket[2 * pos + 2];
+            if (bracket[pos] == 0 && left != 0 && right != 0)
+            {
+                bracket[pos] = rng_range(2) ? left : right;
+            }
+        }
+    }
+}
+
+internal u32
+generate_num_rounds(u32 num_players)
+{
+    u32 rounds = 0;
+    while ((1u << rounds) < num_players)
+    {
+        rounds++;
+    }
+    return rounds;
+}
+
+internal void
+generate_play_event(Event *event, GeneratorOptions *options)
+{
+    s32 positions[64];
+    u32 num_players = find_all_filled_slots(event->registrations, positions);
+    if (num_players < 2 || rng_f64() >= options->started)
+    {
+        return;
+    }
+
+    if (event->format == FORMAT_KNOCKOUT)
+    {
+        event->phase = PHASE_KNOCKOUT;
+        u32 rounds = (u32)(options->rounds_played * generate_num_rounds(num_players) + 0.5);
+        generate_play_bracket(event->bracket, num_players, rounds);
+        return;
+    }
+
+    event->phase = PHASE_GROUP;
+
+    GroupPhase *gp = &event->group_phase;
+    b32 all_played = true;
+    for (u32 g = 0; g < gp->num_groups; ++g)
+    {
+        for (u32 row = 0; row < MAX_GROUP_SIZE; ++row)
+        {
+            for (u32 col = row + 1; col < MAX_GROUP_SIZE; ++col)
+            {
+                if (gp->groups[g][row] == 0 || gp->groups[g][col] == 0) continue;
+
+                if (rng_f64() < options->group_played)
+                {
+                    u16 row_score = (u16)rng_range(6);
+                    u16 col_score = (u16)rng_range(6);
+                    gp->scores[g][row][col] = (MatchScore){ row_score, col_score };
+                    gp->scores[g][col][row] = (MatchScore){ col_score, row_score };
+                }
+                else
+                {
+                    all_played = false;
+                }
+            }
+        }
+    }
+
+    tournament_populate_bracket_from_groups(event);
+
+    if (all_played && options->rounds_played > 0)
+    {
+        event->phase = PHASE_KNOCKOUT;
+
+        u32 num_qualifiers = 0;
+        for (u32 i = 0; i < BRACKET_SIZE; ++i)
+        {
+            num_qualifiers += gp->bracket[i] != 0;
+        }
+        u32 rounds = (u32)(options->rounds_played * generate_num_rounds(num_qualifiers) + 0.5);
+        generate_play_bracket(gp->bracket, num_qualifiers, rounds);
+    }
+}
+
+internal void
+print_usage(void)
+{
+    printf("Usage: generate_save [--players N] [--events N] [--density F] [--groups F] [--started F]\n"
+           "                     [--group-played F] [--rounds-played F] [--seed N] [--out PATH]\n");
+}
+
+internal b32
+parse_options(int argc, char **argv, GeneratorOptions *options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        char *arg = argv[i];
+        char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value)
+        {
+            printf("Missing value for %s\n", arg);
+            print_usage();
+            return false;
+        }
+        ++i;
+
+        if      (!strcmp(arg, "--players"))       options->num_players = (u32)strtoul(value, NULL, 10);
+        else if (!strcmp(arg, "--events"))        options->num_events = (u32)strtoul(value, NULL, 10);
+        else if (!strcmp(arg, "--density"))       options->density = strtod(value, NULL);
+        else if (!strcmp(arg, "--groups"))        options->groups = strtod(value, NULL);
+        else if (!strcmp(arg, "--started"))       options->started = strtod(value, NULL);
+        else if (!strcmp(arg, "--group-played"))  options->group_played = strtod(value, NULL);
+        else if (!strcmp(arg, "--rounds-played")) options->rounds_played = strtod(value, NULL);
+        else if (!strcmp(arg, "--seed"))          options->seed = strtoull(value, NULL, 10);
+        else if (!strcmp(arg, "--out"))           options->out = value;
+        else
+        {
+            printf("Unknown option %s\n", arg);
+            print_usage();
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
 {
     ctx_init();
 
+    // Head and tail sentinels take two slots of each list
+    u32 capacity = MAX_NUM_ENTITIES - 2;
+
+    GeneratorOptions options = {
+        .num_players = capacity,
+        .num_events = capacity,
+        .density = 0.25,
+        .groups = 0.5,
+        .started = 0.75,
+        .group_played = 0.5,
+        .rounds_played = 0.5,
+        .seed = 1,
+        .out = olympiad_save_file,
+    };
+
+    // Help anywhere on the command line wins over the other options
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--help") || !strcmp(argv[i], "-h"))
+        {
+            print_usage();
+            return 0;
+        }
+    }
+
+    if (!parse_options(argc, argv, &options))
+    {
+        return 1;
+    }
+
+    if (options.num_players > capacity || options.num_events > capacity)
+    {
+        printf("Capping to %u players and %u events (list capacity)\n", capacity, capacity);
+        options.num_players = Min(options.num_players, capacity);
+        options.num_events = Min(options.num_events, capacity);
+    }
+
+    rng_state = options.seed;
+
     // Allocate arena for all allocations
     Arena *arena = arena_alloc(MegaByte(16));
 
@@ -17,57 +264,40 @@ int main(void)
     PlayersList players = players_list_init(arena, MAX_NUM_ENTITIES);
     EventsList events = events_list_init(arena, MAX_NUM_ENTITIES);
 
-    // Add players
-    players_list_add(&players, str8_lit("Alice"));
-    players_list_add(&players, str8_lit("Bob"));
-    players_list_add(&players, str8_lit("Charlie"));
-    players_list_add(&players, str8_lit("Player01"));
-    players_list_add(&players, str8_lit("Player02"));
-    players_list_add(&players, str8_lit("Player03"));
-    players_list_add(&players, str8_lit("Player04"));
-    players_list_add(&players, str8_lit("Player05"));
-    players_list_add(&players, str8_lit("Player06"));
-    players_list_add(&players, str8_lit("Player07"));
-    players_list_add(&players, str8_lit("Player08"));
-    players_list_add(&players, str8_lit("Player09"));
-    players_list_add(&players, str8_lit("Player10"));
-    players_list_add(&players, str8_lit("Player11"));
-    players_list_add(&players, str8_lit("Player12"));
-    players_list_add(&players, str8_lit("Player13"));
-    players_list_add(&players, str8_lit("Player14"));
-
-    // Add events
-    events_list_add(&events, str8_lit("Tennis"));
-    events_list_add(&events, str8_lit("Chess"));
-    events_list_add(&events, str8_lit("Torneo01"));
-    events_list_add(&events, str8_lit("Torneo02"));
-    events_list_add(&events, str8_lit("Torneo03"));
-    events_list_add(&events, str8_lit("Torneo04"));
-    events_list_add(&events, str8_lit("Torneo05"));
-    events_list_add(&events, str8_lit("Torneo06"));
-    events_list_add(&events, str8_lit("Torneo07"));
-    events_list_add(&events, str8_lit("Torneo08"));
-    events_list_add(&events, str8_lit("Torneo09"));
-    events_list_add(&events, str8_lit("Torneo10"));
-    events_list_add(&events, str8_lit("Torneo11"));
-    events_list_add(&events, str8_lit("Torneo12"));
-    events_list_add(&events, str8_lit("Torneo13"));
-    events_list_add(&events, str8_lit("Torneo14"));
-    events_list_add(&events, str8_lit("Torneo15"));
-    events_list_add(&events, str8_lit("Torneo16"));
-
-    // Register players to events
-    // Alice -> Tennis, Chess
-    register_player_to_event(&players, &events, str8_lit("Alice"), str8_lit("Tennis"));
-    register_player_to_event(&players, &events, str8_lit("Alice"), str8_lit("Chess"));
-
-    // Bob -> Tennis
-    register_player_to_event(&players, &events, str8_lit("Bob"), str8_lit("Tennis"));
-
-    // Charlie -> Chess
-    register_player_to_event(&players, &events, str8_lit("Charlie"), str8_lit("Chess"));
+    for (u32 i = 0; i < options.num_players; ++i)
+    {
+        players_list_add(&players, generate_name(arena, "Player", i + 1));
+    }
+
+    for (u32 i = 0; i < options.num_events; ++i)
+    {
+        u32 idx = events_list_add(&events, generate_name(arena, "Torneo", i + 1));
+        Event *event = events.events + idx;
+        event->phase = PHASE_REGISTRATION;
+        event->format = rng_f64() < options.groups ? FORMAT_GROUP_KNOCKOUT : FORMAT_KNOCKOUT;
+        event->group_phase.group_size = (u8)(3 + rng_range(3));
+    }
+
+    // Registrations go through the regular path so brackets and groups are built as in the app
+    u32 idx_tail = MAX_NUM_ENTITIES - 1;
+    for (u32 e = events.events->nxt; e != idx_tail; e = events.events[e].nxt)
+    {
+        for (u32 p = players.players->nxt; p != idx_tail; p = players.players[p].nxt)
+        {
+            if (rng_f64() < options.density)
+            {
+                register_player_to_event(&players, &events, players.players[p].name, events.events[e].name);
+            }
+        }
+    }
+
+    for (u32 e = events.events->nxt; e != idx_tail; e = events.events[e].nxt)
+    {
+        generate_play_event(events.events + e, &options);
+    }
 
     // Save to file
+    olympiad_save_file = options.out;
     b32 success = olympiad_save(&players, &events);
 
     if (success)
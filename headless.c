@@ -0,0 +1,791 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arena.h"
+#include "core.h"
+#include "arena.c"
+#include "string.c"
+#include "compress.c"
+#include "timer.c"
+#include "profiler.c"
+#include "players.c"
+#include "schedule.c"
+
+// Headless olympiad engine: the same players.c logic as the app, driven by a
+// script instead of a window. No raylib, no Clay, no GPU.
+//
+// Commands are read one per line from the files given on the command line, or
+// from stdin when there are none. Arguments are separated by spaces, double
+// quotes group an argument that contains spaces, # starts a comment.
+//
+//   add player NAME                     add a player
+//   add event NAME                      add an event
+//   remove player NAME                  remove a player (and its registrations)
+//   remove event NAME                   remove an event
+//   register PLAYER EVENT               register a player to an event
+//   unregister PLAYER EVENT             unregister a player from an event
+//   format EVENT knockout               pure single elimination
+//   format EVENT groups [SIZE [ADV]]    groups then knockout, ADV players advance per group
+//   start EVENT                         leave the registration phase
+//   score EVENT PLAYER1 PLAYER2 S1 S2   result of a group match
+//   group EVENT PLAYER PLAYER...        latecomers form a new group of an event in the group phase
+//   terminate EVENT                     close the group phase, start the knockout
+//   advance EVENT PLAYER                PLAYER won its current knockout match
+//   undo EVENT PLAYER                   undo the last advancement of PLAYER
+//   save [PATH] [--archive]             save (default olympiad.sav), compressed with --archive
+//   load [PATH]                         load (default olympiad.sav)
+//   export [PATH]                       dump the olympiad as JSON (default stdout)
+//   list                                print players and events
+//   schedule SLOTS COURTS               give every match to play a slot and a court, and print them
+//   trace [PATH]                        write the commands run so far as a Chrome trace (default trace.json)
+//
+// A failing command is reported on stderr and the script goes on; the exit
+// code is 1 if any command failed.
+
+#define HEADLESS_MAX_ARGS 8
+#define HEADLESS_MAX_LINE 1024
+
+typedef struct Headless Headless;
+struct Headless {
+    Arena *arena;
+    PlayersList players;
+    EventsList events;
+
+    const char *source;
+    u32 line;
+    u32 errors;
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+internal void
+headless_error(Headless *h, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%s:%u: ", h->source, h->line);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+
+    h->errors++;
+}
+
+/**
+ * Split a line into arguments, in place.
+ *
+ * @return The number of arguments, a comment or an empty line gives 0
+ */
+internal u32
+headless_tokenize(char *line, char *args[HEADLESS_MAX_ARGS])
+{
+    u32 argc = 0;
+    char *at = line;
+
+    while (*at)
+    {
+        while (*at == ' ' || *at == '\t' || *at == '\r' || *at == '\n') at++;
+        if (*at == 0 || *at == '#') break;
+        if (argc == HEADLESS_MAX_ARGS) break;
+
+        if (*at == '"')
+        {
+            args[argc++] = ++at;
+            while (*at && *at != '"') at++;
+        }
+        else
+        {
+            args[argc++] = at;
+            while (*at && *at != ' ' && *at != '\t' && *at != '\r' && *at != '\n') at++;
+        }
+
+        if (*at) *at++ = 0;
+    }
+
+    return argc;
+}
+
+internal u32
+headless_find_player(Headless *h, char *name)
+{
+    u32 idx = players_list_find(&h->players, str8_from_cstr(name));
+    if (idx == h->players.len - 1)
+    {
+        headless_error(h, "unknown player \"%s\"", name);
+        return 0;
+    }
+    return idx;
+}
+
+internal Event *
+headless_find_event(Headless *h, char *name)
+{
+    u32 idx = events_list_find(&h->events, str8_from_cstr(name));
+    if (idx == h->events.len - 1)
+    {
+        headless_error(h, "unknown event \"%s\"", name);
+        return NULL;
+    }
+    return h->events.events + idx;
+}
+
+internal b32
+headless_parse_u32(Headless *h, char *arg, u32 *out)
+{
+    char *end;
+    unsigned long value = strtoul(arg, &end, 10);
+    if (end == arg || *end != 0 || value > 0xFFFF)
+    {
+        headless_error(h, "invalid number \"%s\"", arg);
+        return false;
+    }
+    *out = (u32)value;
+    return true;
+}
+
+internal String8
+headless_name(Headless *h, char *arg)
+{
+    String8 name = str8_strip_whitespace(str8_from_cstr(arg));
+    if (name.len == 0 || name.len >= MAX_STRING_SIZE)
+    {
+        headless_error(h, "names must be 1 to %u characters long", MAX_STRING_SIZE - 1);
+        return (String8){0};
+    }
+    return str8_copy(h->arena, name);
+}
+
+// ============================================================================
+// Commands
+// ============================================================================
+
+internal void
+headless_add(Headless *h, char *kind, char *arg)
+{
+    String8 name = headless_name(h, arg);
+    if (name.len == 0) return;
+
+    if (!strcmp(kind, "player"))
+    {
+        if (players_list_find(&h->players, name) != h->players.len - 1)
+        {
+            headless_error(h, "player \"%s\" already exists", arg);
+        }
+        else if (h->players.first_free_idx == h->players.len - 1)
+        {
+            headless_error(h, "no room for more players");
+        }
+        else
+        {
+            players_list_add(&h->players, name);
+        }
+    }
+    else if (!strcmp(kind, "event"))
+    {
+        if (events_list_find(&h->events, name) != h->events.len - 1)
+        {
+            headless_error(h, "event \"%s\" already exists", arg);
+        }
+        else if (h->events.first_free_idx == h->events.len - 1)
+        {
+            headless_error(h, "no room for more events");
+        }
+        else
+        {
+            events_list_add(&h->events, name);
+        }
+    }
+    else
+    {
+        headless_error(h, "add what? (player or event)");
+    }
+}
+
+internal void
+headless_remove(Headless *h, char *kind, char *arg)
+{
+    if (!strcmp(kind, "player"))
+    {
+        if (headless_find_player(h, arg))
+        {
+            players_list_remove(&h->players, &h->events, str8_from_cstr(arg));
+        }
+    }
+    else if (!strcmp(kind, "event"))
+    {
+        if (headless_find_event(h, arg))
+        {
+            events_list_remove(&h->events, &h->players, str8_from_cstr(arg));
+        }
+    }
+    else
+    {
+        headless_error(h, "remove what? (player or event)");
+    }
+}
+
+internal void
+headless_register(Headless *h, char *player_name, char *event_name, b32 registered)
+{
+    u32 player_idx = headless_find_player(h, player_name);
+    Event *event = headless_find_event(h, event_name);
+    if (!player_idx || !event) return;
+
+    if (event->phase != PHASE_REGISTRATION)
+    {
+        headless_error(h, "\"%s\" is closed for registrations", event_name);
+        return;
+    }
+
+    b32 is_registered = (event->registrations >> player_idx) & 1;
+    if (is_registered == registered)
+    {
+        headless_error(h, "\"%s\" is %s registered to \"%s\"", player_name, registered ? "already" : "not", event_name);
+        return;
+    }
+
+    if (registered)
+    {
+        register_player_to_event(&h->players, &h->events, str8_from_cstr(player_name), str8_from_cstr(event_name));
+    }
+    else
+    {
+        unregister_player_from_event(&h->players, &h->events, str8_from_cstr(player_name), str8_from_cstr(event_name));
+    }
+}
+
+internal void
+headless_format(Headless *h, u32 argc, char **args)
+{
+    Event *event = headless_find_event(h, args[1]);
+    if (!event) return;
+
+    if (event->phase != PHASE_REGISTRATION)
+    {
+        headless_error(h, "the format of \"%s\" cannot change after the start", args[1]);
+        return;
+    }
+
+    if (!strcmp(args[2], "knockout"))
+    {
+        event->format = FORMAT_KNOCKOUT;
+        return;
+    }
+
+    if (strcmp(args[2], "groups"))
+    {
+        headless_error(h, "unknown format \"%s\" (knockout or groups)", args[2]);
+        return;
+    }
+
+    u32 group_size = event->group_phase.group_size;
+    u32 advance = event->group_phase.advance_per_group;
+    if (argc > 3 && !headless_parse_u32(h, args[3], &group_size)) return;
+    if (argc > 4 && !headless_parse_u32(h, args[4], &advance)) return;
+
+    // Same limits as the group size and advance buttons in the app
+    if (group_size < 2 || group_size > MAX_GROUP_SIZE || advance < 1 || advance > group_size - 1)
+    {
+        headless_error(h, "group size must be 2..%u and advance 1..size-1", MAX_GROUP_SIZE);
+        return;
+    }
+
+    event->format = FORMAT_GROUP_KNOCKOUT;
+    event->group_phase.group_size = (u8)group_size;
+    event->group_phase.advance_per_group = (u8)advance;
+
+    tournament_construct_groups(event);
+    tournament_populate_bracket_from_groups(event);
+}
+
+internal void
+headless_start(Headless *h, char *event_name)
+{
+    Event *event = headless_find_event(h, event_name);
+    if (event && !tournament_start(event))
+    {
+        headless_error(h, "\"%s\" cannot start (already started or less than 2 players)", event_name);
+    }
+}
+
+internal void
+headless_update_results(Headless *h, Event *event)
+{
+    results_update_event(&h->players, &h->events, (u32)(event - h->events.events));
+}
+
+internal void
+headless_late_group(Headless *h, u32 argc, char **args)
+{
+    Event *event = headless_find_event(h, args[1]);
+    if (!event) return;
+
+    if (event->format != FORMAT_GROUP_KNOCKOUT || event->phase != PHASE_GROUP)
+    {
+        headless_error(h, "\"%s\" is not in the group phase", args[1]);
+        return;
+    }
+
+    u64 group = 0;
+    for (u32 i = 2; i < argc; i++)
+    {
+        u32 player_idx = headless_find_player(h, args[i]);
+        if (!player_idx) return;
+        if ((event->registrations >> player_idx) & 1)
+        {
+            headless_error(h, "\"%s\" is already registered to \"%s\"", args[i], args[1]);
+            return;
+        }
+        group |= 1ULL << player_idx;
+    }
+
+    if (!register_late_group_to_event(&h->players, &h->events, (u32)(event - h->events.events), group))
+    {
+        headless_error(h, "a group has 2..%u players, an event at most %u groups", MAX_GROUP_SIZE, MAX_GROUPS);
+    }
+}
+
+internal void
+headless_score(Headless *h, char **args)
+{
+    Event *event = headless_find_event(h, args[1]);
+    u32 row_player = headless_find_player(h, args[2]);
+    u32 col_player = headless_find_player(h, args[3]);
+    u32 row_score, col_score;
+    if (!event || !row_player || !col_player) return;
+    if (!headless_parse_u32(h, args[4], &row_score) || !headless_parse_u32(h, args[5], &col_score)) return;
+
+    if (event->phase != PHASE_GROUP)
+    {
+        headless_error(h, "\"%s\" is not in the group phase", args[1]);
+        return;
+    }
+
+    GroupPhase *gp = &event->group_phase;
+    u32 group_idx = gp->player_group[row_player];
+    if (row_player == col_player || group_idx == GROUP_NONE || gp->player_group[col_player] != group_idx)
+    {
+        headless_error(h, "\"%s\" and \"%s\" do not play each other in a group", args[2], args[3]);
+        return;
+    }
+
+    tournament_set_group_score(event, group_idx, gp->player_slot[row_player], gp->player_slot[col_player],
+                               (u16)row_score, (u16)col_score);
+    headless_update_results(h, event);
+}
+
+internal void
+headless_advance(Headless *h, char *event_name, char *player_name, b32 undo)
+{
+    Event *event = headless_find_event(h, event_name);
+    u32 player_idx = headless_find_player(h, player_name);
+    if (!event || !player_idx) return;
+
+    if (event->phase != PHASE_KNOCKOUT)
+    {
+        headless_error(h, "\"%s\" is not in the knockout phase", event_name);
+        return;
+    }
+
+    u32 pos = tournament_find_bracket_slot(event, (u8)player_idx);
+    if (pos == BRACKET_SIZE)
+    {
+        headless_error(h, "\"%s\" is not in the \"%s\" bracket", player_name, event_name);
+        return;
+    }
+
+    if (undo)
+    {
+        // The deepest slot is the advancement to undo, clear it from its child
+        u8 *bracket = tournament_knockout_bracket(event);
+        if (2 * pos + 1 >= BRACKET_SIZE || (bracket[2 * pos + 1] != player_idx && bracket[2 * pos + 2] != player_idx))
+        {
+            headless_error(h, "\"%s\" has not advanced in \"%s\"", player_name, event_name);
+            return;
+        }
+        u32 child = bracket[2 * pos + 1] == player_idx ? 2 * pos + 1 : 2 * pos + 2;
+        tournament_undo_advance(event, child, (u8)player_idx);
+        headless_update_results(h, event);
+        return;
+    }
+
+    if (pos == 0)
+    {
+        headless_error(h, "\"%s\" already won \"%s\"", player_name, event_name);
+        return;
+    }
+
+    tournament_advance_winner(event, pos);
+    headless_update_results(h, event);
+}
+
+internal void
+headless_save(Headless *h, u32 argc, char **args)
+{
+    const char *path = olympiad_save_file;
+    b32 archive = false;
+    for (u32 i = 1; i < argc; ++i)
+    {
+        if (!strcmp(args[i], "--archive")) archive = true;
+        else path = args[i];
+    }
+
+    b32 success;
+    if (archive)
+    {
+        success = olympiad_save_archive(&h->players, &h->events, path);
+    }
+    else
+    {
+        // olympiad_save goes through the temp file for an atomic replace
+        const char *save_file = olympiad_save_file;
+        olympiad_save_file = path;
+        success = olympiad_save(&h->players, &h->events);
+        olympiad_save_file = save_file;
+    }
+
+    if (!success)
+    {
+        headless_error(h, "cannot save to %s", path);
+    }
+}
+
+internal void
+headless_load(Headless *h, u32 argc, char **args)
+{
+    const char *path = argc > 1 ? args[1] : olympiad_save_file;
+    if (!olympiad_load_file(h->arena, &h->players, &h->events, path))
+    {
+        headless_error(h, "cannot load %s", path);
+    }
+}
+
+internal void
+headless_trace(Headless *h, u32 argc, char **args)
+{
+    const char *path = argc > 1 ? args[1] : "trace.json";
+    if (!trace_dump(path))
+    {
+        headless_error(h, "cannot write %s", path);
+    }
+}
+
+internal void
+headless_list(Headless *h)
+{
+    u32 idx_tail = MAX_NUM_ENTITIES - 1;
+    char *phases[] = { "registration", "group", "knockout", "finished" };
+
+    printf("Players: %u\n", players_list_count(&h->players));
+    for (u32 p = h->players.players->nxt; p != idx_tail; p = h->players.players[p].nxt)
+    {
+        Player *player = h->players.players + p;
+        printf("  %.*s\n", (int)player->name.len, player->name.str);
+    }
+
+    printf("Events: %u\n", events_list_count(&h->events));
+    for (u32 e = h->events.events->nxt; e != idx_tail; e = h->events.events[e].nxt)
+    {
+        Event *event = h->events.events + e;
+        s32 positions[64];
+        u32 num_players = find_all_filled_slots(event->registrations, positions);
+        printf("  %.*s (%s, %s, %u players)\n", (int)event->name.len, event->name.str,
+               event->format == FORMAT_GROUP_KNOCKOUT ? "groups" : "knockout",
+               phases[event->phase], num_players);
+    }
+}
+
+internal void
+headless_print_match(Headless *h, ScheduledMatch *match)
+{
+    String8 event = h->events.events[match->event_idx].name;
+    String8 a = h->players.players[match->players[0]].name;
+    String8 b = h->players.players[match->players[1]].name;
+    printf("%.*s: %.*s - %.*s\n", (int)event.len, event.str, (int)a.len, a.str, (int)b.len, b.str);
+}
+
+/**
+ * Schedule every match to play from scratch and print it slot by slot, then
+ * the matches that did not fit.
+ */
+internal void
+headless_schedule(Headless *h, char **args)
+{
+    u32 num_slots, num_courts;
+    if (!headless_parse_u32(h, args[1], &num_slots) || !headless_parse_u32(h, args[2], &num_courts)) return;
+    if (num_slots < 1 || num_slots > SCHEDULE_MAX_SLOTS || num_courts < 1 || num_courts > SCHEDULE_MAX_COURTS)
+    {
+        headless_error(h, "slots must be 1..%u and courts 1..%u", SCHEDULE_MAX_SLOTS, SCHEDULE_MAX_COURTS);
+        return;
+    }
+
+    schedule_init(&schedule, num_slots, num_courts);
+    u32 unscheduled = schedule_update(&schedule, &h->players, &h->events);
+
+    printf("Schedule: %u matches, %u without a slot\n", schedule.num_matches, unscheduled);
+    for (u32 slot = 0; slot < num_slots; ++slot)
+    {
+        for (u32 court = 0; court < num_courts; ++court)
+        {
+            if (schedule.grid[slot][court] == 0) continue;
+            printf("  slot %u court %u  ", slot + 1, court + 1);
+            headless_print_match(h, schedule.matches + schedule.grid[slot][court] - 1);
+        }
+    }
+    for (u32 i = 0; i < schedule.num_matches; ++i)
+    {
+        if (schedule.matches[i].slot != SCHEDULE_NONE) continue;
+        printf("  no slot         ");
+        headless_print_match(h, schedule.matches + i);
+    }
+}
+
+// ============================================================================
+// JSON export
+// ============================================================================
+
+internal void
+export_string(FILE *f, String8 s)
+{
+    fputc('"', f);
+    for (u64 i = 0; i < s.len; ++i)
+    {
+        u8 c = s.str[i];
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (c < 0x20)         fprintf(f, "\\u%04x", c);
+        else                       fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+internal void
+export_player(FILE *f, Headless *h, u8 player_idx)
+{
+    if (player_idx == 0) fprintf(f, "null");
+    else                 export_string(f, h->players.players[player_idx].name);
+}
+
+internal void
+export_bracket(FILE *f, Headless *h, u8 *bracket)
+{
+    // Trailing empty slots are left out, the heap layout keeps the indices
+    u32 used = BRACKET_SIZE;
+    while (used > 0 && bracket[used - 1] == 0) used--;
+
+    fprintf(f, "[");
+    for (u32 i = 0; i < used; ++i)
+    {
+        if (i) fprintf(f, ",");
+        export_player(f, h, bracket[i]);
+    }
+    fprintf(f, "]");
+}
+
+internal void
+export_groups(FILE *f, Headless *h, GroupPhase *gp)
+{
+    fprintf(f, ",\"group_size\":%u,\"advance_per_group\":%u,\"groups\":[", gp->group_size, gp->advance_per_group);
+    for (u32 g = 0; g < gp->num_groups; ++g)
+    {
+        fprintf(f, "%s{\"players\":[", g ? "," : "");
+        b32 first = true;
+        for (u32 slot = 0; slot < MAX_GROUP_SIZE; ++slot)
+        {
+            if (gp->groups[g][slot] == 0) continue;
+            fprintf(f, first ? "" : ",");
+            export_player(f, h, gp->groups[g][slot]);
+            first = false;
+        }
+
+        // A match is played once either side scored, as in the standings
+        fprintf(f, "],\"matches\":[");
+        first = true;
+        for (u32 row = 0; row < MAX_GROUP_SIZE; ++row)
+        {
+            for (u32 col = row + 1; col < MAX_GROUP_SIZE; ++col)
+            {
+                MatchScore score = gp->scores[g][row][col];
+                if (gp->groups[g][row] == 0 || gp->groups[g][col] == 0) continue;
+                if (score.row_score == 0 && score.col_score == 0) continue;
+
+                fprintf(f, first ? "[" : ",[");
+                export_player(f, h, gp->groups[g][row]);
+                fprintf(f, ",");
+                export_player(f, h, gp->groups[g][col]);
+                fprintf(f, ",%u,%u]", score.row_score, score.col_score);
+                first = false;
+            }
+        }
+        fprintf(f, "]}");
+    }
+    fprintf(f, "]");
+}
+
+internal void
+headless_export(Headless *h, u32 argc, char **args)
+{
+    FILE *f = stdout;
+    if (argc > 1 && !(f = fopen(args[1], "w")))
+    {
+        headless_error(h, "cannot open %s", args[1]);
+        return;
+    }
+
+    u32 idx_tail = MAX_NUM_ENTITIES - 1;
+    char *phases[] = { "registration", "group", "knockout", "finished" };
+
+    fprintf(f, "{\"players\":[");
+    for (u32 p = h->players.players->nxt; p != idx_tail; p = h->players.players[p].nxt)
+    {
+        fprintf(f, p == h->players.players->nxt ? "" : ",");
+        export_player(f, h, (u8)p);
+    }
+
+    fprintf(f, "],\"events\":[");
+    for (u32 e = h->events.events->nxt; e != idx_tail; e = h->events.events[e].nxt)
+    {
+        Event *event = h->events.events + e;
+        fprintf(f, e == h->events.events->nxt ? "{\"name\":" : ",{\"name\":");
+        export_string(f, event->name);
+        fprintf(f, ",\"format\":\"%s\",\"phase\":\"%s\",\"players\":[",
+                event->format == FORMAT_GROUP_KNOCKOUT ? "groups" : "knockout", phases[event->phase]);
+
+        s32 positions[64];
+        u32 num_players = find_all_filled_slots(event->registrations, positions);
+        for (u32 i = 0; i < num_players; ++i)
+        {
+            fprintf(f, i ? "," : "");
+            export_player(f, h, (u8)positions[i]);
+        }
+        fprintf(f, "]");
+
+        if (event->format == FORMAT_GROUP_KNOCKOUT)
+        {
+            export_groups(f, h, &event->group_phase);
+        }
+
+        fprintf(f, ",\"bracket\":");
+        export_bracket(f, h, tournament_knockout_bracket(event));
+        fprintf(f, "}");
+    }
+    fprintf(f, "]}\n");
+
+    if (f != stdout) fclose(f);
+}
+
+// ============================================================================
+// Script runner
+// ============================================================================
+
+internal void
+headless_run_line(Headless *h, char *line)
+{
+    char *args[HEADLESS_MAX_ARGS];
+    u32 argc = headless_tokenize(line, args);
+    if (argc == 0) return;
+
+    char *cmd = args[0];
+
+    // Minimum argument count of each command, checked before dispatching
+    struct { char *name; u32 argc; } commands[] = {
+        { "add", 3 }, { "remove", 3 }, { "register", 3 }, { "unregister", 3 },
+        { "format", 3 }, { "start", 2 }, { "score", 6 }, { "group", 4 }, { "terminate", 2 },
+        { "advance", 3 }, { "undo", 3 }, { "save", 1 }, { "load", 1 },
+        { "export", 1 }, { "list", 1 }, { "schedule", 3 }, { "trace", 1 },
+    };
+
+    u32 i = 0;
+    while (i < ArrayCount(commands) && strcmp(commands[i].name, cmd)) i++;
+    if (i == ArrayCount(commands))
+    {
+        headless_error(h, "unknown command \"%s\"", cmd);
+        return;
+    }
+    if (argc < commands[i].argc)
+    {
+        headless_error(h, "%s needs %u arguments", cmd, commands[i].argc - 1);
+        return;
+    }
+
+    u64 start_ns = trace_begin();
+
+    if      (!strcmp(cmd, "add"))        headless_add(h, args[1], args[2]);
+    else if (!strcmp(cmd, "remove"))     headless_remove(h, args[1], args[2]);
+    else if (!strcmp(cmd, "register"))   headless_register(h, args[1], args[2], true);
+    else if (!strcmp(cmd, "unregister")) headless_register(h, args[1], args[2], false);
+    else if (!strcmp(cmd, "format"))     headless_format(h, argc, args);
+    else if (!strcmp(cmd, "start"))      headless_start(h, args[1]);
+    else if (!strcmp(cmd, "score"))      headless_score(h, args);
+    else if (!strcmp(cmd, "group"))      headless_late_group(h, argc, args);
+    else if (!strcmp(cmd, "advance"))    headless_advance(h, args[1], args[2], false);
+    else if (!strcmp(cmd, "undo"))       headless_advance(h, args[1], args[2], true);
+    else if (!strcmp(cmd, "save"))       headless_save(h, argc, args);
+    else if (!strcmp(cmd, "load"))       headless_load(h, argc, args);
+    else if (!strcmp(cmd, "export"))     headless_export(h, argc, args);
+    else if (!strcmp(cmd, "list"))       headless_list(h);
+    else if (!strcmp(cmd, "schedule"))   headless_schedule(h, args);
+    else if (!strcmp(cmd, "trace"))      headless_trace(h, argc, args);
+    else if (!strcmp(cmd, "terminate"))
+    {
+        Event *event = headless_find_event(h, args[1]);
+        if (event && event->phase != PHASE_GROUP)
+        {
+            headless_error(h, "\"%s\" is not in the group phase", args[1]);
+        }
+        else if (event)
+        {
+            tournament_terminate_group_phase(event);
+            headless_update_results(h, event);
+        }
+    }
+
+    // The trace keeps the name pointer: the command names are string literals
+    trace_end(commands[i].name, start_ns);
+}
+
+internal void
+headless_run_file(Headless *h, FILE *f, const char *source)
+{
+    char line[HEADLESS_MAX_LINE];
+
+    h->source = source;
+    h->line = 0;
+    while (fgets(line, sizeof(line), f))
+    {
+        h->line++;
+        headless_run_line(h, line);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ctx_init();
+    trace_set_enabled(true);
+
+    Headless h = {0};
+    h.arena = arena_alloc(MegaByte(16));
+    h.players = players_list_init(h.arena, MAX_NUM_ENTITIES);
+    h.events = events_list_init(h.arena, MAX_NUM_ENTITIES);
+
+    if (argc < 2)
+    {
+        headless_run_file(&h, stdin, "stdin");
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        FILE *f = fopen(argv[i], "r");
+        if (!f)
+        {
+            fprintf(stderr, "Cannot open %s\n", argv[i]);
+            return 1;
+        }
+        headless_run_file(&h, f, argv[i]);
+        fclose(f);
+    }
+
+    return h.errors ? 1 : 0;
+}
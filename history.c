@@ -0,0 +1,258 @@
+#include <assert.h>
+#include <stddef.h>
+
+#include "core.h"
+#include "players.h"
+#include "snapshot.h"
+#include "schedule.h"
+#include "history.h"
+
+History history;
+
+// Logged part of the entities, the fields after it are derived
+#define HISTORY_PLAYER_SIZE offsetof(Player, medals)
+#define HISTORY_EVENT_SIZE  offsetof(Event, medals)
+
+void
+history_clear(void)
+{
+    history.oldest = 0;
+    history.cursor = 0;
+    history.newest = 0;
+    history.version++;
+}
+
+void
+history_begin(void)
+{
+    assert(!history.recording);
+    history.recording = true;
+    history.num_players = 0;
+    history.num_events = 0;
+}
+
+void
+history_touch_player(PlayersList *players, u32 idx)
+{
+    assert(history.recording);
+    for (u32 i = 0; i < history.num_players; i++)
+    {
+        if (history.player_idx[i] == idx) return;
+    }
+
+    assert(history.num_players < HISTORY_MAX_PLAYERS);
+    u32 n = history.num_players++;
+    history.player_idx[n] = (u8)idx;
+    history.players[n] = players->players + idx;
+
+    // Byte copy, padding included, so that the commit finds no difference in it
+    MemoryCopy(&history.player_copies[n], history.players[n], sizeof(Player));
+}
+
+void
+history_touch_event(EventsList *events, u32 idx)
+{
+    assert(history.recording);
+    for (u32 i = 0; i < history.num_events; i++)
+    {
+        if (history.event_idx[i] == idx) return;
+    }
+
+    assert(history.num_events < HISTORY_MAX_EVENTS);
+    u32 n = history.num_events++;
+    history.event_idx[n] = (u8)idx;
+    history.events[n] = events->events + idx;
+    MemoryCopy(&history.event_copies[n], history.events[n], sizeof(Event));
+
+    // First change since load (or since its versions were dropped): keep the
+    // version it started from
+    if (snapshot_store.chunks && !snapshot_store.current[idx])
+    {
+        snapshot_take(&snapshot_store, history.events[n], idx);
+    }
+}
+
+/**
+ * Log the chunks of an entity that differ from its copy, from the
+ * `written`-th record of the action on.
+ *
+ * @return The records of the action written so far
+ */
+internal u64
+history_diff(HistoryTarget target, u8 idx, void *copy, void *live, u64 size, u64 written)
+{
+    u8 *before = (u8 *)copy;
+    u8 *after = (u8 *)live;
+
+    for (u64 offset = 0; offset < size; offset += 8)
+    {
+        u64 chunk = Min(8, size - offset);
+        if (MemoryCompare(before + offset, after + offset, chunk) == 0) continue;
+
+        HistoryRecord *record = &history.records[(history.cursor + written) % HISTORY_RECORDS];
+        MemoryZeroStruct(record);
+        record->target = (u8)target;
+        record->idx = idx;
+        record->size = (u8)chunk;
+        record->offset = (u32)offset;
+        MemoryCopy(&record->before, before + offset, chunk);
+        MemoryCopy(&record->after, after + offset, chunk);
+        written++;
+    }
+
+    return written;
+}
+
+void
+history_commit(void)
+{
+    assert(history.recording);
+    history.recording = false;
+
+    // The action goes where the undone ones were, they cannot be redone anymore
+    u64 written = 0;
+    for (u32 i = 0; i < history.num_players; i++)
+    {
+        written = history_diff(HISTORY_PLAYER, history.player_idx[i], &history.player_copies[i],
+                               history.players[i], HISTORY_PLAYER_SIZE, written);
+    }
+    for (u32 i = 0; i < history.num_events; i++)
+    {
+        written = history_diff(HISTORY_EVENT, history.event_idx[i], &history.event_copies[i],
+                               history.events[i], HISTORY_EVENT_SIZE, written);
+
+        // Skipped when the event did not change since its last version
+        if (snapshot_store.chunks)
+        {
+            snapshot_take(&snapshot_store, history.events[i], history.event_idx[i]);
+        }
+        schedule_mark_events(&schedule, 1ull << history.event_idx[i]);
+    }
+
+    if (written == 0) return;
+    history.version++;
+
+    // Wrapped over its own records: cannot be undone, nor can what came before
+    if (written > HISTORY_RECORDS)
+    {
+        history_clear();
+        return;
+    }
+
+    history.records[history.cursor % HISTORY_RECORDS].flags |= HISTORY_FIRST;
+    history.records[(history.cursor + written - 1) % HISTORY_RECORDS].flags |= HISTORY_LAST;
+    history.newest = history.cursor + written;
+    history.cursor = history.newest;
+
+    // Drop the oldest actions, whole, whose records have been overwritten
+    if (history.newest - history.oldest > HISTORY_RECORDS)
+    {
+        history.oldest = history.newest - HISTORY_RECORDS;
+        while (!(history.records[history.oldest % HISTORY_RECORDS].flags & HISTORY_FIRST))
+        {
+            history.oldest++;
+        }
+    }
+}
+
+/**
+ * Write one of the values of a record back into its entity.
+ *
+ * @return Bit of the entity in the touched mask of its kind
+ */
+internal u64
+history_write(PlayersList *players, EventsList *events, HistoryRecord *record, u64 value)
+{
+    u8 *base = record->target == HISTORY_PLAYER
+        ? (u8 *)(players->players + record->idx)
+        : (u8 *)(events->events + record->idx);
+    MemoryCopy(base + record->offset, &value, record->size);
+
+    return 1ull << record->idx;
+}
+
+/**
+ * Bring the sorted views and the results in line with the entities an undo
+ * or a redo changed.
+ */
+internal void
+history_refresh(PlayersList *players, EventsList *events, u64 touched_players, u64 touched_events)
+{
+    s32 positions[64];
+
+    u32 count = find_all_filled_slots(touched_players, positions);
+    for (u32 i = 0; i < count; i++)
+    {
+        u32 idx = (u32)positions[i];
+        Player *player = players->players + idx;
+        sorted_view_update(players->by_name, idx, 0, player->name);
+        sorted_view_update(players->by_registrations, idx, registration_count(player->registrations), player->name);
+        sorted_view_update(players->by_medals, idx, medal_key(player->medals), player->name);
+    }
+
+    count = find_all_filled_slots(touched_events, positions);
+    for (u32 i = 0; i < count; i++)
+    {
+        u32 idx = (u32)positions[i];
+        Event *event = events->events + idx;
+        sorted_view_update(events->by_name, idx, 0, event->name);
+        sorted_view_update(events->by_registrations, idx, registration_count(event->registrations), event->name);
+        results_update_event(players, events, idx);
+
+        // The version it is at may be the one it was restored to
+        if (snapshot_store.chunks)
+        {
+            snapshot_sync(&snapshot_store, event, idx);
+        }
+    }
+    schedule_mark_events(&schedule, touched_events);
+    history.version++;
+}
+
+b32
+history_can_undo(void)
+{
+    return history.cursor > history.oldest;
+}
+
+b32
+history_can_redo(void)
+{
+    return history.cursor < history.newest;
+}
+
+b32
+history_undo(PlayersList *players, EventsList *events)
+{
+    if (!history_can_undo()) return false;
+
+    u64 touched[2] = {0};
+    HistoryRecord *record;
+    do
+    {
+        history.cursor--;
+        record = &history.records[history.cursor % HISTORY_RECORDS];
+        touched[record->target] |= history_write(players, events, record, record->before);
+    } while (!(record->flags & HISTORY_FIRST));
+
+    history_refresh(players, events, touched[HISTORY_PLAYER], touched[HISTORY_EVENT]);
+    return true;
+}
+
+b32
+history_redo(PlayersList *players, EventsList *events)
+{
+    if (!history_can_redo()) return false;
+
+    u64 touched[2] = {0};
+    HistoryRecord *record;
+    do
+    {
+        record = &history.records[history.cursor % HISTORY_RECORDS];
+        history.cursor++;
+        touched[record->target] |= history_write(players, events, record, record->after);
+    } while (!(record->flags & HISTORY_LAST));
+
+    history_refresh(players, events, touched[HISTORY_PLAYER], touched[HISTORY_EVENT]);
+    return true;
+}
@@ -0,0 +1,121 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "core.h"
+#include "players.h"
+
+// Undo history: every change made by the user (scores, advances, phase
+// changes, registrations, renames, settings) is logged as the bytes of the
+// players and events it changed, a journal of byte differences rather than
+// one command record with its inverse per kind of action: the actions need no
+// inverse operation written for them, and a new action is undoable as soon
+// as it touches what it changes.
+//
+// An action is wrapped in history_begin/history_commit, and the entities it
+// may change are touched before changing them: the touch copies the whole
+// entity (an Event is several KB), the commit compares it with the copy and
+// logs every 8-byte chunk that differs, old and new value, as one record of a
+// fixed size ring. Undo writes back the old values of the records of the last
+// action, redo the new ones: each record in constant time, the action in time
+// proportional to the bytes it changed. A score or an advance is a couple of
+// records; a phase change rewrites groups, scores and brackets, and going back
+// to registration from a full group phase can log hundreds of them.
+//
+// Only the fields up to the derived ones (medals, records, stats) are logged:
+// those are recomputed by the results functions after an undo or a redo, and
+// the sorted views updated, as the list functions would.
+//
+// Adding or removing a player or an event clears the history, as does
+// loading: the records address the entities by index.
+//
+// The events an action changed are also snapshotted, see snapshot.h, and
+// marked for the schedule to look at, see schedule.h.
+
+#define HISTORY_RECORDS      16384  // Ring capacity, a power of two
+#define HISTORY_MAX_PLAYERS  MAX_NUM_ENTITIES   // Players a single action may change
+#define HISTORY_MAX_EVENTS   4                  // Events a single action may change
+
+typedef enum HistoryTarget {
+    HISTORY_PLAYER,
+    HISTORY_EVENT,
+} HistoryTarget;
+
+enum {
+    HISTORY_FIRST = 1 << 0,     // First record of its action
+    HISTORY_LAST  = 1 << 1,     // Last record of its action
+};
+
+typedef struct HistoryRecord HistoryRecord;
+struct HistoryRecord {
+    u8 target;      // HistoryTarget
+    u8 idx;         // Player or event index
+    u8 size;        // Bytes of the chunk, 1 to 8
+    u8 flags;       // HISTORY_FIRST, HISTORY_LAST
+    u32 offset;     // Of the chunk in the Player or Event
+    u64 before;
+    u64 after;
+};
+
+typedef struct History History;
+struct History {
+    HistoryRecord records[HISTORY_RECORDS];
+
+    // Records ever written, the ring slot is n % HISTORY_RECORDS. Actions
+    // between oldest and cursor can be undone, from cursor to newest redone.
+    u64 oldest;
+    u64 cursor;
+    u64 newest;
+
+    // Bumped by every change to the players and events: actions, undo, redo,
+    // and the additions, removals and loads that clear the history
+    u64 version;
+
+    // Action being recorded: the entities touched and their copies
+    b32 recording;
+    u32 num_players;
+    u32 num_events;
+    u8 player_idx[HISTORY_MAX_PLAYERS];
+    u8 event_idx[HISTORY_MAX_EVENTS];
+    Player *players[HISTORY_MAX_PLAYERS];
+    Event *events[HISTORY_MAX_EVENTS];
+    Player player_copies[HISTORY_MAX_PLAYERS];
+    Event event_copies[HISTORY_MAX_EVENTS];
+};
+
+extern History history;
+
+/**
+ * Forget every action, after the entities were added, removed or loaded.
+ */
+void history_clear(void);
+
+/**
+ * Start recording an action.
+ */
+void history_begin(void);
+
+/**
+ * Declare that the action may change a player or an event: call before
+ * changing it. Touching the same entity twice is harmless.
+ */
+void history_touch_player(PlayersList *players, u32 idx);
+void history_touch_event(EventsList *events, u32 idx);
+
+/**
+ * End the action, log what it changed and snapshot the events it changed.
+ * Discards what could be redone, unless nothing changed.
+ */
+void history_commit(void);
+
+/**
+ * Revert the last action, or apply again the last one reverted.
+ *
+ * @return Whether there was an action to undo (redo)
+ */
+b32 history_undo(PlayersList *players, EventsList *events);
+b32 history_redo(PlayersList *players, EventsList *events);
+
+b32 history_can_undo(void);
+b32 history_can_redo(void);
+
+#endif // HISTORY_H
@@ -0,0 +1,254 @@
+#include <stdio.h>
+
+#include "core.h"
+#include "arena.h"
+#include "string.h"
+#include "players.h"
+#include "input.h"
+
+#include "raylib/raylib.h"
+
+Input input;
+
+#define InputBitGet(bits, i) (((bits)[(i) / 64] >> ((i) % 64)) & 1)
+#define InputBitSet(bits, i) ((bits)[(i) / 64] |= 1ull << ((i) % 64))
+
+internal void
+input_poll(InputFrame *frame)
+{
+    f64 previousTime = frame->time;
+    MemoryZeroStruct(frame);
+
+    // raylib measures the frame time before EndDrawing sleeps, so after a wait
+    // GetFrameTime lags one frame behind: time the frames on the clock instead
+    frame->time = GetTime();
+    frame->frameTime = previousTime > 0 ? (f32)(frame->time - previousTime) : GetFrameTime();
+    frame->screenWidth = GetScreenWidth();
+    frame->screenHeight = GetScreenHeight();
+    frame->mousePosition = GetMousePosition();
+    frame->mouseDelta = GetMouseDelta();
+    frame->wheel = GetMouseWheelMoveV();
+    frame->windowResized = (u8)IsWindowResized();
+
+    for (int button = 0; button < INPUT_MOUSE_BUTTONS; button++)
+    {
+        frame->mouseDown     |= (u8)(IsMouseButtonDown(button) << button);
+        frame->mousePressed  |= (u8)(IsMouseButtonPressed(button) << button);
+        frame->mouseReleased |= (u8)(IsMouseButtonReleased(button) << button);
+    }
+
+    for (int key = KEY_SPACE; key <= KEY_KB_MENU; key++)
+    {
+        if (IsKeyDown(key))          InputBitSet(frame->keysDown, key);
+        if (IsKeyPressed(key))       InputBitSet(frame->keysPressed, key);
+        if (IsKeyPressedRepeat(key)) InputBitSet(frame->keysRepeated, key);
+    }
+
+    // Drain raylib's queue, characters beyond INPUT_MAX_CHARS in one frame are dropped
+    for (int c = GetCharPressed(); c != 0; c = GetCharPressed())
+    {
+        if (frame->numChars < INPUT_MAX_CHARS)
+        {
+            frame->chars[frame->numChars++] = c;
+        }
+    }
+}
+
+b32
+input_record_begin(const char *path, PlayersList *players, EventsList *events)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+    {
+        printf("Cannot create %s\n", path);
+        return false;
+    }
+
+    Temp temp = scratch_get(0, 0);
+    SaveWriter snapshot = olympiad_serialize(temp.arena, players, events);
+
+    InputRecordingHeader header = {
+        .magic = INPUT_RECORDING_MAGIC,
+        .version = INPUT_RECORDING_VERSION,
+        .frameSize = sizeof(InputFrame),
+        .snapshotSize = snapshot.offset,
+    };
+    b32 written = fwrite(&header, sizeof(header), 1, f) == 1 &&
+                  fwrite(snapshot.buffer, 1, snapshot.offset, f) == snapshot.offset &&
+                  fflush(f) == 0;
+
+    scratch_release(temp);
+
+    // A recording without its olympiad cannot be replayed
+    if (!written)
+    {
+        printf("Cannot write %s\n", path);
+        fclose(f);
+        remove(path);
+        return false;
+    }
+
+    input.mode = INPUT_RECORD;
+    input.file = f;
+    printf("Recording input to %s\n", path);
+
+    return true;
+}
+
+b32
+input_replay_begin(Arena *arena, const char *path, PlayersList *players, EventsList *events)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        printf("Cannot open %s\n", path);
+        return false;
+    }
+
+    InputRecordingHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 ||
+        header.magic != INPUT_RECORDING_MAGIC ||
+        header.version != INPUT_RECORDING_VERSION ||
+        header.frameSize != sizeof(InputFrame))
+    {
+        printf("%s is not a recording made by this build\n", path);
+        fclose(f);
+        return false;
+    }
+
+    // The olympiad goes through a file next to the recording, which also
+    // takes the replay's autosaves instead of olympiad.sav
+    String8 path8 = str8_from_cstr((char *)path);
+    olympiad_save_file = (char *)str8_cat(arena, path8, str8_lit(".sav\0")).str;
+    olympiad_temp_file = (char *)str8_cat(arena, path8, str8_lit(".tmp\0")).str;
+
+    Temp temp = scratch_get(&arena, 1);
+    u8 *snapshot = push_array(temp.arena, u8, header.snapshotSize);
+    b32 valid = fread(snapshot, 1, header.snapshotSize, f) == header.snapshotSize &&
+                olympiad_write_file(olympiad_save_file, NULL, snapshot, header.snapshotSize) &&
+                olympiad_load_file(arena, players, events, olympiad_save_file);
+    scratch_release(temp);
+
+    if (!valid)
+    {
+        printf("Cannot restore the olympiad of %s\n", path);
+        fclose(f);
+        return false;
+    }
+
+    input.mode = INPUT_REPLAY;
+    input.file = f;
+    input.hasPending = fread(&input.pending, sizeof(InputFrame), 1, f) == 1;
+
+    return true;
+}
+
+void
+input_replay_screen_size(s32 *width, s32 *height)
+{
+    *width = input.pending.screenWidth;
+    *height = input.pending.screenHeight;
+}
+
+void
+input_begin_frame(void)
+{
+    input.nextChar = 0;
+
+    if (input.mode == INPUT_REPLAY)
+    {
+        if (!input.hasPending)
+        {
+            input.finished = true;
+            return;
+        }
+
+        input.frame = input.pending;
+        input.hasPending = fread(&input.pending, sizeof(InputFrame), 1, input.file) == 1;
+
+        // The layout depends on the window size, follow the recorded one
+        if (input.frame.screenWidth != GetScreenWidth() || input.frame.screenHeight != GetScreenHeight())
+        {
+            SetWindowSize(input.frame.screenWidth, input.frame.screenHeight);
+        }
+    }
+    else
+    {
+        input_poll(&input.frame);
+
+        // A recording that misses a frame replays other frames: stop it there
+        if (input.mode == INPUT_RECORD && fwrite(&input.frame, sizeof(InputFrame), 1, input.file) != 1)
+        {
+            printf("Cannot write frame %llu of the recording, recording stopped\n",
+                   (unsigned long long)input.frameIndex);
+            input_end();
+            input.mode = INPUT_LIVE;
+        }
+    }
+
+    input.frameIndex++;
+}
+
+b32
+input_replay_finished(void)
+{
+    return input.finished;
+}
+
+void
+input_end(void)
+{
+    if (input.file)
+    {
+        fclose(input.file);
+        input.file = NULL;
+    }
+}
+
+Vector2 input_mouse_position(void)  { return input.frame.mousePosition; }
+Vector2 input_mouse_delta(void)     { return input.frame.mouseDelta; }
+Vector2 input_mouse_wheel(void)     { return input.frame.wheel; }
+b32 input_mouse_down(int button)     { return (input.frame.mouseDown >> button) & 1; }
+b32 input_mouse_pressed(int button)  { return (input.frame.mousePressed >> button) & 1; }
+b32 input_mouse_released(int button) { return (input.frame.mouseReleased >> button) & 1; }
+b32 input_key_down(int key)          { return (b32)InputBitGet(input.frame.keysDown, key); }
+b32 input_key_pressed(int key)       { return (b32)InputBitGet(input.frame.keysPressed, key); }
+b32 input_key_pressed_repeat(int key) { return (b32)InputBitGet(input.frame.keysRepeated, key); }
+b32 input_window_resized(void)       { return input.frame.windowResized; }
+f64 input_time(void)                 { return input.frame.time; }
+f32 input_frame_time(void)           { return input.frame.frameTime; }
+
+b32
+input_any_key_down(void)
+{
+    u64 any = 0;
+    for (u32 i = 0; i < ArrayCount(input.frame.keysDown); i++)
+    {
+        any |= input.frame.keysDown[i];
+    }
+    return any != 0;
+}
+
+b32
+input_has_events(void)
+{
+    u64 keys = 0;
+    for (u32 i = 0; i < ArrayCount(input.frame.keysPressed); i++)
+    {
+        keys |= input.frame.keysPressed[i] | input.frame.keysRepeated[i];
+    }
+    return keys != 0 || input.frame.numChars > 0 ||
+           input.frame.mousePressed != 0 || input.frame.mouseReleased != 0 ||
+           input.frame.wheel.x != 0 || input.frame.wheel.y != 0 ||
+           input.frame.mouseDelta.x != 0 || input.frame.mouseDelta.y != 0;
+}
+
+int
+input_char_pressed(void)
+{
+    if (input.nextChar >= input.frame.numChars)
+    {
+        return 0;
+    }
+    return input.frame.chars[input.nextChar++];
+}
@@ -0,0 +1,136 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdio.h>
+
+#include "core.h"
+#include "arena.h"
+#include "players.h"
+#include "raylib/raylib.h"
+
+// Input layer: the UI reads the mouse, keyboard and clock through input_*
+// instead of raylib, from a snapshot taken once per frame.
+//
+// Live:    the snapshot is polled from raylib.
+// Record:  same, and every snapshot is appended to a recording file, after a
+//          copy of the olympiad as it was when the recording started.
+// Replay:  snapshots come from a recording, clock included, so the same
+//          frames are built again whatever the machine's speed.
+
+#define INPUT_KEY_COUNT      512    // Above KEY_KB_MENU, the last raylib key
+#define INPUT_MAX_CHARS      16     // Characters typed in a single frame
+#define INPUT_MOUSE_BUTTONS  (MOUSE_BUTTON_BACK + 1)
+
+#define INPUT_RECORDING_MAGIC    0x504E4945  // "EINP"
+#define INPUT_RECORDING_VERSION  1
+
+typedef enum InputMode {
+    INPUT_LIVE,
+    INPUT_RECORD,
+    INPUT_REPLAY,
+} InputMode;
+
+typedef struct InputFrame InputFrame;
+struct InputFrame {
+    f64 time;
+    f32 frameTime;
+    s32 screenWidth;
+    s32 screenHeight;
+    Vector2 mousePosition;
+    Vector2 mouseDelta;
+    Vector2 wheel;
+    u8 mouseDown;       // Bit per mouse button
+    u8 mousePressed;
+    u8 mouseReleased;
+    u8 windowResized;
+    u32 numChars;
+    s32 chars[INPUT_MAX_CHARS];
+    u64 keysDown[INPUT_KEY_COUNT / 64];
+    u64 keysPressed[INPUT_KEY_COUNT / 64];
+    u64 keysRepeated[INPUT_KEY_COUNT / 64];
+};
+
+typedef struct InputRecordingHeader InputRecordingHeader;
+struct InputRecordingHeader {
+    u32 magic;
+    u32 version;
+    u32 frameSize;      // sizeof(InputFrame), recordings are not portable across builds
+    u32 reserved;
+    u64 snapshotSize;   // Save file bytes that follow the header
+};
+
+typedef struct Input Input;
+struct Input {
+    InputMode mode;
+    FILE *file;
+    InputFrame frame;
+    InputFrame pending;     // Replay: next frame, already read
+    b32 hasPending;
+    b32 finished;           // Replay: ran out of frames
+    u32 nextChar;           // Position in frame.chars of input_char_pressed
+    u64 frameIndex;
+};
+
+extern Input input;
+
+/**
+ * Start recording: writes the header and the current olympiad to path.
+ *
+ * @return Whether the file could be created and written, a partial file is removed
+ */
+b32 input_record_begin(const char *path, PlayersList *players, EventsList *events);
+
+/**
+ * Open a recording and load the olympiad it starts from.
+ *
+ * Saves made during the replay go to "<path>.sav", never to olympiad.sav.
+ *
+ * @return Whether the recording is valid and its olympiad could be loaded
+ */
+b32 input_replay_begin(Arena *arena, const char *path, PlayersList *players, EventsList *events);
+
+/**
+ * Screen size of the first recorded frame, to open the window at the same size.
+ */
+void input_replay_screen_size(s32 *width, s32 *height);
+
+/**
+ * Take this frame's snapshot. Call once per frame, before anything reads input.
+ */
+void input_begin_frame(void);
+
+/**
+ * Replay only: all the recorded frames have been played.
+ */
+b32 input_replay_finished(void);
+
+void input_end(void);
+
+Vector2 input_mouse_position(void);
+Vector2 input_mouse_delta(void);
+Vector2 input_mouse_wheel(void);
+b32 input_mouse_down(int button);
+b32 input_mouse_pressed(int button);
+b32 input_mouse_released(int button);
+b32 input_key_down(int key);
+b32 input_key_pressed(int key);
+b32 input_key_pressed_repeat(int key);
+b32 input_any_key_down(void);
+b32 input_window_resized(void);
+
+/**
+ * Whether this frame carries input events, not just state: a key pressed or
+ * repeated, a character typed, a button pressed or released, the wheel or the
+ * mouse moved.
+ */
+b32 input_has_events(void);
+
+/**
+ * Next character typed this frame (unicode codepoint), 0 when there are no more.
+ */
+int input_char_pressed(void);
+
+f64 input_time(void);
+f32 input_frame_time(void);
+
+#endif // INPUT_H
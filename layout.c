@@ -7,6 +7,11 @@
 #include "string.h"
 #include "players.h"
 #include "layout.h"
+#include "profiler.h"
+#include "input.h"
+#include "snapshot.h"
+#include "history.h"
+#include "schedule.h"
 
 #include "raylib/raylib.h"
 
@@ -121,14 +126,205 @@ str8_to_clay(String8 str)
 
 #define MAX_DISPLAY_NAME_LEN 14
 
+///////////////////////////////////////////////////////////////////////////////
+// Label cache
+
+// Keys: a name's string pointer, or one of these tags (never set in a user-space pointer) and a value
+#define LABEL_KEY_NUMBER    (1ull << 63)
+#define LABEL_KEY_SCORE     (1ull << 62)
+#define LABEL_KEY_GROUP     (1ull << 61)
+#define LABEL_KEY_TOMBSTONE (~0ull)
+
+internal Clay_String
+LabelCache_Static(String8 str)
+{
+    return (Clay_String){
+        .length = (int)str.len,
+        .chars = (const char *)str.str,
+        .isStaticallyAllocated = true
+    };
+}
+
+/**
+ * Find the entry of key, or the slot where it should be created.
+ *
+ * @param found Set when the returned entry already holds key
+ * @return NULL when key is not cached and every entry it may take is in use this frame
+ */
+internal LabelCacheEntry *
+LabelCache_Lookup(u64 key, bool *found)
+{
+    u32 home = (u32)((key * 0x9E3779B97F4A7C15ull) >> 32) & (LABEL_CACHE_SIZE - 1);
+    LabelCacheEntry *free_slot = NULL;
+    LabelCacheEntry *stale_slot = NULL;
+
+    *found = false;
+    for (u32 probe = 0; probe < LABEL_CACHE_PROBES; probe++)
+    {
+        LabelCacheEntry *entry = &data.labelCache[(home + probe) & (LABEL_CACHE_SIZE - 1)];
+        if (entry->key == key)
+        {
+            *found = true;
+            entry->frame = data.frameIndex;
+            return entry;
+        }
+        bool forgotten = entry->key == LABEL_KEY_TOMBSTONE && entry->frame != data.frameIndex;
+        if ((entry->key == 0 || forgotten) && !free_slot)
+        {
+            free_slot = entry;
+        }
+        if (entry->frame != data.frameIndex && !stale_slot)
+        {
+            stale_slot = entry;
+        }
+        if (entry->key == 0)
+        {
+            break;
+        }
+    }
+
+    // Neighbourhood full: evict an entry this frame does not draw
+    return free_slot ? free_slot : stale_slot;
+}
+
+internal Clay_String
+LabelCache_Insert(LabelCacheEntry *entry, u64 key, String8 label)
+{
+    assert(label.len <= LABEL_MAX_LEN);
+
+    if (!entry)
+    {
+        String8 copy = str8_copy(data.frameArena, label);
+        Clay_String result = LabelCache_Static(copy);
+        result.isStaticallyAllocated = false;
+        return result;
+    }
+
+    // A buffer that held another label is not static anymore for Clay
+    bool reused = entry->label.chars != NULL;
+    MemoryCopy(entry->text, label.str, label.len);
+    entry->key = key;
+    entry->frame = data.frameIndex;
+    entry->label = LabelCache_Static(str8((u8 *)entry->text, label.len));
+    entry->label.isStaticallyAllocated = !reused;
+    return entry->label;
+}
+
+/**
+ * A name ready for Clay, truncated with "..." past MAX_DISPLAY_NAME_LEN.
+ */
+Clay_String
+LabelCache_Name(String8 name)
+{
+    // Names live in data.arena and are never modified, they are labels already
+    if (name.len <= MAX_DISPLAY_NAME_LEN)
+    {
+        return LabelCache_Static(name);
+    }
+
+    u64 key = (u64)(uintptr_t)name.str;
+    bool found;
+    LabelCacheEntry *entry = LabelCache_Lookup(key, &found);
+    if (found)
+    {
+        return entry->label;
+    }
+
+    Temp temp = scratch_get(0, 0);
+    String8 truncated = str8_cat(temp.arena, str8(name.str, MAX_DISPLAY_NAME_LEN - 3), str8_lit("..."));
+    Clay_String label = LabelCache_Insert(entry, key, truncated);
+    scratch_release(temp);
+
+    return label;
+}
+
+Clay_String
+LabelCache_Number(u32 num)
+{
+    if (num < STR8_SMALL_U32_COUNT)
+    {
+        return LabelCache_Static(str8_from_small_u32(num));
+    }
+
+    u64 key = LABEL_KEY_NUMBER | num;
+    bool found;
+    LabelCacheEntry *entry = LabelCache_Lookup(key, &found);
+    if (found)
+    {
+        return entry->label;
+    }
+
+    Temp temp = scratch_get(0, 0);
+    Clay_String label = LabelCache_Insert(entry, key, str8_from_u32(temp.arena, num));
+    scratch_release(temp);
+
+    return label;
+}
+
+/**
+ * "X - Y" label of a group match result.
+ */
+Clay_String
+LabelCache_Score(u16 row_score, u16 col_score)
+{
+    u64 key = LABEL_KEY_SCORE | ((u64)row_score << 16) | col_score;
+    bool found;
+    LabelCacheEntry *entry = LabelCache_Lookup(key, &found);
+    if (found)
+    {
+        return entry->label;
+    }
+
+    Temp temp = scratch_get(0, 0);
+    String8 separator = str8_lit_comp(" - ");
+    String8 score = str8_cat(temp.arena, str8_cat(temp.arena, str8_from_u32(temp.arena, row_score), separator),
+                             str8_from_u32(temp.arena, col_score));
+    Clay_String label = LabelCache_Insert(entry, key, score);
+    scratch_release(temp);
+
+    return label;
+}
+
+/**
+ * "GROUP N" label, group_number starts from 1.
+ */
 Clay_String
-str8_to_clay_truncated(Arena *arena, String8 str, u64 max_len)
+LabelCache_Group(u32 group_number)
+{
+    u64 key = LABEL_KEY_GROUP | group_number;
+    bool found;
+    LabelCacheEntry *entry = LabelCache_Lookup(key, &found);
+    if (found)
+    {
+        return entry->label;
+    }
+
+    Temp temp = scratch_get(0, 0);
+    String8 group = str8_cat(temp.arena, str8_lit("GROUP "), str8_from_u32(temp.arena, group_number));
+    Clay_String label = LabelCache_Insert(entry, key, group);
+    scratch_release(temp);
+
+    return label;
+}
+
+/**
+ * Release the label of a name that is being replaced (rename, removal).
+ */
+void
+LabelCache_Forget(String8 name)
 {
-    if (str.len <= max_len) {
-        return str8_to_clay(str);
+    if (name.len <= MAX_DISPLAY_NAME_LEN)
+    {
+        return;
+    }
+
+    bool found;
+    LabelCacheEntry *entry = LabelCache_Lookup((u64)(uintptr_t)name.str, &found);
+    if (found)
+    {
+        // Keeps the probe chains of the entries after it intact
+        entry->key = LABEL_KEY_TOMBSTONE;
     }
-    String8 truncated = str8_cat(arena, str8(str.str, max_len - 3), str8_lit("..."));
-    return str8_to_clay(truncated);
 }
 
 void
@@ -160,6 +356,196 @@ RenderDuplicateWarning(Clay_String parentId, Clay_String message, u32 uniqueId)
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Windowed lists
+
+#define VIRTUAL_LIST_OVERSCAN 2  // Extra rows on each side, hover and scroll stay seamless
+
+/**
+ * Compute the rows of a list that intersect the visible part of its scroll
+ * container, from the container's position and scroll offset of the previous
+ * frame. Call before declaring the rows, inside the container.
+ *
+ * @param paddingTop Top padding of the container, rows start below it
+ */
+void
+VirtualList_Begin(VirtualList *list, Clay_ElementId containerId, u32 numRows, float childGap, float paddingTop)
+{
+    list->numRows = numRows;
+    list->childGap = childGap;
+    list->first = 0;
+    list->end = numRows;
+
+    // Row height of the previous frame, if the measured row still exists
+    Clay_ElementData measured = Clay_GetElementData(list->measureId);
+    if (measured.found && measured.boundingBox.height > 0)
+    {
+        list->rowHeight = measured.boundingBox.height;
+    }
+
+    Clay_ElementData container = Clay_GetElementData(containerId);
+    Clay_ScrollContainerData scroll = Clay_GetScrollContainerData(containerId);
+    if (list->rowHeight <= 0 || !container.found || !scroll.found)
+    {
+        return;
+    }
+
+    // Visible band in content coordinates: the container clipped to the screen
+    float screenTop = Max(container.boundingBox.y, 0.0f);
+    float screenBottom = Min(container.boundingBox.y + container.boundingBox.height, (float)GetScreenHeight());
+    float contentTop = container.boundingBox.y + paddingTop + scroll.scrollPosition->y;
+
+    float stride = list->rowHeight + childGap;
+    float visibleTop = screenTop - contentTop;
+    float visibleBottom = screenBottom - contentTop;
+
+    s64 first = (s64)(visibleTop / stride) - VIRTUAL_LIST_OVERSCAN;
+    s64 end = (s64)(visibleBottom / stride) + 1 + VIRTUAL_LIST_OVERSCAN;
+
+    list->first = (u32)ClampTop(ClampBot(first, 0), (s64)numRows);
+    list->end = (u32)ClampTop(ClampBot(end, (s64)list->first), (s64)numRows);
+}
+
+/**
+ * Whether the row must be declared. The first declared row is the one
+ * measured for the next frame.
+ */
+bool
+VirtualList_Declare(VirtualList *list, u32 row, Clay_ElementId rowId)
+{
+    if (row < list->first || row >= list->end)
+    {
+        return false;
+    }
+    if (row == list->first)
+    {
+        list->measureId = rowId;
+    }
+    return true;
+}
+
+/**
+ * Fixed-size element in place of the rows above (top) or below the window.
+ */
+void
+VirtualList_Spacer(VirtualList *list, Clay_ElementId spacerId, bool top)
+{
+    u32 skipped = top ? list->first : list->numRows - list->end;
+    if (skipped == 0)
+    {
+        return;
+    }
+
+    // The gap between the spacer and the next row is added by Clay
+    float height = (float)skipped * (list->rowHeight + list->childGap) - list->childGap;
+    CLAY(spacerId, {
+        .layout = { .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(height) } }
+    }) {}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Zoomable canvases
+
+#define MATRIX_LOD_ZOOM 0.75f  // Below this zoom group matrix cells drop their text
+#define CANVAS_CULL_MARGIN 256.0f  // Kept around the viewport: the boxes tested are a scroll step old
+
+internal u64
+LayoutHash(u64 hash, const void *bytes, u64 size)
+{
+    // FNV-1a
+    const u8 *at = (const u8 *)bytes;
+    for (u64 i = 0; i < size; i++)
+    {
+        hash = (hash ^ at[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+/**
+ * Decide whether the canvas may cull this frame, and compute its viewport.
+ *
+ * @param clipId Scroll container clipping the canvas, id 0 if only the screen clips it
+ */
+void
+CanvasCull_Begin(CanvasCull *cull, Event *tournament, float zoom, Clay_ElementId clipId)
+{
+    // Everything the size or the content of a group or match depends on
+    u64 hash = 0xCBF29CE484222325ull;
+    hash = LayoutHash(hash, &zoom, sizeof(zoom));
+    hash = LayoutHash(hash, &tournament->registrations, sizeof(tournament->registrations));
+    hash = LayoutHash(hash, &tournament->format, sizeof(tournament->format));
+    hash = LayoutHash(hash, tournament->bracket, sizeof(tournament->bracket));
+    hash = LayoutHash(hash, &tournament->group_phase.num_groups, sizeof(u8));
+    hash = LayoutHash(hash, &tournament->group_phase.group_size, sizeof(u8));
+    hash = LayoutHash(hash, &tournament->group_phase.advance_per_group, sizeof(u8));
+    hash = LayoutHash(hash, tournament->group_phase.groups, sizeof(tournament->group_phase.groups));
+    hash = LayoutHash(hash, tournament->group_phase.bracket, sizeof(tournament->group_phase.bracket));
+    hash = LayoutHash(hash, &tournament->phase, sizeof(tournament->phase));
+    hash = LayoutHash(hash, tournament->group_phase.scores,
+                      tournament->group_phase.num_groups * sizeof(tournament->group_phase.scores[0]));
+    int screen[2] = { GetScreenWidth(), GetScreenHeight() };
+    hash = LayoutHash(hash, screen, sizeof(screen));
+
+    cull->enabled = (cull->contentHash == hash && cull->lastFrame + 1 == data.frameIndex);
+    cull->contentHash = hash;
+    cull->lastFrame = data.frameIndex;
+
+    cull->viewport = (Clay_BoundingBox){ 0, 0, (float)screen[0], (float)screen[1] };
+    Clay_ElementData clip = Clay_GetElementData(clipId);
+    if (clipId.id != 0 && clip.found)
+    {
+        Clay_BoundingBox box = clip.boundingBox;
+        box.y += data.yOffset;
+        float x0 = Max(box.x, cull->viewport.x);
+        float y0 = Max(box.y, cull->viewport.y);
+        float x1 = Min(box.x + box.width, cull->viewport.x + cull->viewport.width);
+        float y1 = Min(box.y + box.height, cull->viewport.y + cull->viewport.height);
+        cull->viewport = (Clay_BoundingBox){ x0, y0, Max(x1 - x0, 0), Max(y1 - y0, 0) };
+    }
+
+    // Elements scrolling in are already there on the frame they show up
+    cull->viewport.x -= CANVAS_CULL_MARGIN;
+    cull->viewport.y -= CANVAS_CULL_MARGIN;
+    cull->viewport.width += 2 * CANVAS_CULL_MARGIN;
+    cull->viewport.height += 2 * CANVAS_CULL_MARGIN;
+}
+
+/**
+ * Replace an off-screen element by an empty one with the same id and size.
+ *
+ * @return Whether the element was culled, the caller skips its declaration
+ */
+bool
+CanvasCull_Skip(CanvasCull *cull, Clay_ElementId id)
+{
+    if (!cull->enabled)
+    {
+        return false;
+    }
+
+    Clay_ElementData element = Clay_GetElementData(id);
+    if (!element.found)
+    {
+        return false;
+    }
+
+    // Layout boxes do not include the global yOffset added to the render commands
+    Clay_BoundingBox box = element.boundingBox;
+    Clay_BoundingBox view = cull->viewport;
+    float y = box.y + data.yOffset;
+    bool visible = box.x < view.x + view.width && box.x + box.width > view.x &&
+                   y < view.y + view.height && y + box.height > view.y;
+    if (visible)
+    {
+        return false;
+    }
+
+    CLAY(id, {
+        .layout = { .sizing = { .width = CLAY_SIZING_FIXED(box.width), .height = CLAY_SIZING_FIXED(box.height) } }
+    }) {}
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Event Handlers
 
@@ -244,7 +630,11 @@ HandleEnrollPlayerFromDetail(Clay_ElementId elementId, Clay_PointerData pointerD
         Player *player = data.players.players + player_idx;
         Event *tournament = data.tournaments.events + tournament_idx;
 
+        history_begin();
+        history_touch_player(&data.players, player_idx);
+        history_touch_event(&data.tournaments, tournament_idx);
         register_player_to_event(&data.players, &data.tournaments, player->name, tournament->name);
+        history_commit();
     }
 }
 
@@ -265,7 +655,11 @@ HandleUnregisterPlayerFromDetail(Clay_ElementId elementId, Clay_PointerData poin
         // Only allow unregistration during registration phase
         if (tournament->phase == PHASE_REGISTRATION)
         {
+            history_begin();
+            history_touch_player(&data.players, player_idx);
+            history_touch_event(&data.tournaments, tournament_idx);
             unregister_player_from_event(&data.players, &data.tournaments, player->name, tournament->name);
+            history_commit();
         }
     }
 }
@@ -294,6 +688,40 @@ HandleDeletePlayer(Clay_ElementId elementId, Clay_PointerData pointerData, void
     }
 }
 
+/**
+ * Sort a list by a column header, clicking the active column again goes
+ * back to the most recent first order.
+ */
+void
+HandleListOrder(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData)
+{
+    data.mouseCursor = MOUSE_CURSOR_POINTING_HAND;
+    if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
+    {
+        ListOrderChoice *choice = (ListOrderChoice *)userData;
+        *choice->order = (*choice->order == choice->value) ? LIST_ORDER_RECENT : choice->value;
+    }
+}
+
+/**
+ * Column header label of a sortable list, highlighted when the list is
+ * sorted by it. Call inside the header element.
+ */
+void
+RenderListOrderHeader(Clay_String label, ListOrder *order, ListOrder value)
+{
+    ListOrderChoice *choice = push_array(data.frameArena, ListOrderChoice, 1);
+    choice->order = order;
+    choice->value = value;
+    Clay_OnHover(HandleListOrder, choice);
+
+    CLAY_TEXT(label, CLAY_TEXT_CONFIG({
+        .fontId = FONT_ID_BODY_16,
+        .fontSize = 12,
+        .textColor = (*order == value || Clay_Hovered()) ? dashAccentTeal : dashLabelText
+    }));
+}
+
 void
 HandleOuterContainerInteraction(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData)
 {
@@ -309,11 +737,11 @@ HandleZoomableHover(Clay_ElementId elementId, Clay_PointerData pointerData, void
     float *zoomLevel = (float *)userData;
 
     // Handle zoom with Cmd+/Cmd- while hovering over zoomable area
-    bool cmdPressed = IsKeyDown(KEY_LEFT_SUPER) || IsKeyDown(KEY_RIGHT_SUPER);
+    bool cmdPressed = input_key_down(KEY_LEFT_SUPER) || input_key_down(KEY_RIGHT_SUPER);
 
     if (cmdPressed)
     {
-        if (IsKeyPressed(KEY_RIGHT_BRACKET)) // Which is actually the "+" on the Mac with italian keyboard layout
+        if (input_key_pressed(KEY_RIGHT_BRACKET)) // Which is actually the "+" on the Mac with italian keyboard layout
         {
             // Zoom in (Cmd +)
             *zoomLevel += 0.1f;
@@ -322,7 +750,7 @@ HandleZoomableHover(Clay_ElementId elementId, Clay_PointerData pointerData, void
                 *zoomLevel = 3.0f;
             }
         }
-        if (IsKeyPressed(KEY_SLASH)) // Which is actually the "-" on the Mac with italian keyboard layout
+        if (input_key_pressed(KEY_SLASH)) // Which is actually the "-" on the Mac with italian keyboard layout
         {
             // Zoom out (Cmd -)
             *zoomLevel -= 0.1f;
@@ -347,7 +775,7 @@ HandleTextInput(Clay_ElementId elementId, Clay_PointerData pointerData, void *us
         data.focusedTextbox = textBoxEnum;
 
         Clay_BoundingBox inputBox = Clay_GetElementData(elementId).boundingBox;
-        Vector2 mousePos = GetMousePosition();
+        Vector2 mousePos = input_mouse_position();
 
         // Get scroll offset for this textbox
         const char *scrollIdStr = TextBoxScrollIds[textBoxEnum];
@@ -415,6 +843,7 @@ HandleAddEventButtonInteraction(Clay_ElementId elementId, Clay_PointerData point
             else
             {
                 events_list_add(&data.tournaments, eventNameStripped);
+                history_clear();
             }
         }
     }
@@ -442,6 +871,7 @@ HandleAddPlayerButtonInteraction(Clay_ElementId elementId, Clay_PointerData poin
             else
             {
                 players_list_add(&data.players, playerNameStripped);
+                history_clear();
             }
         }
     }
@@ -460,6 +890,9 @@ HandleTogglePlayerRegistration(Clay_ElementId elementId, Clay_PointerData pointe
         // Check if player is already registered to this tournament
         bool is_registered = (player->registrations >> data.selectedTournamentIdx) & 1;
 
+        history_begin();
+        history_touch_player(&data.players, player_idx);
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
         if (is_registered)
         {
             unregister_player_from_event(&data.players, &data.tournaments, player->name, tournament->name);
@@ -468,6 +901,7 @@ HandleTogglePlayerRegistration(Clay_ElementId elementId, Clay_PointerData pointe
         {
             register_player_to_event(&data.players, &data.tournaments, player->name, tournament->name);
         }
+        history_commit();
     }
 }
 
@@ -486,34 +920,26 @@ HandleAdvanceWinner(Clay_ElementId elementId, Clay_PointerData pointerData, void
     // Only allow changes when tournament is in progress
     if (tournament->phase == PHASE_REGISTRATION) return;
 
-    // Select the appropriate bracket based on tournament format
-    u8 *bracket = (tournament->format == FORMAT_GROUP_KNOCKOUT)
-        ? tournament->group_phase.bracket
-        : tournament->bracket;
-
-    // Calculate parent position in the bracket tree
-    u32 parent_pos = (bracket_pos - 1) / 2;
-
     // Right-click: undo advancement (cascade reset up the tree)
-    if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT))
+    // Left-click: advance non-TBD player
+    b32 undo = input_mouse_pressed(MOUSE_BUTTON_RIGHT);
+    b32 advance = !undo && player_idx != 0 && pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME;
+    if (!undo && !advance) return;
+
+    history_begin();
+    history_touch_event(&data.tournaments, data.selectedTournamentIdx);
+    if (undo)
     {
-        // Traverse up the tree and reset all ancestor slots that contain this player
-        u32 pos = bracket_pos;
-        while (pos > 0)
-        {
-            u32 parent = (pos - 1) / 2;
-            if (bracket[parent] == player_idx)
-            {
-                bracket[parent] = 0;
-            }
-            pos = parent;
-        }
+        tournament_undo_advance(tournament, bracket_pos, player_idx);
     }
-    // Left-click: advance non-TBD player
-    else if (player_idx != 0 && pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
+    else
     {
-        bracket[parent_pos] = player_idx;
+        tournament_advance_winner(tournament, bracket_pos);
     }
+    history_commit();
+
+    // A final or semifinal may have been decided or undone
+    results_update_event(&data.players, &data.tournaments, data.selectedTournamentIdx);
 }
 
 void
@@ -522,17 +948,12 @@ HandleStartTournament(Clay_ElementId elementId, Clay_PointerData pointerData, vo
     data.mouseCursor = MOUSE_CURSOR_POINTING_HAND;
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
+        // Only starts if we have at least 2 players
         Event *tournament = data.tournaments.events + data.selectedTournamentIdx;
-
-        // Only start if we have at least 2 players
-        s32 positions[64];
-        u32 num_players = find_all_filled_slots(tournament->registrations, positions);
-        if (num_players >= 2)
-        {
-            tournament->phase = (tournament->format == FORMAT_GROUP_KNOCKOUT)
-                ? PHASE_GROUP
-                : PHASE_KNOCKOUT;
-        }
+        history_begin();
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
+        tournament_start(tournament);
+        history_commit();
     }
 }
 
@@ -563,12 +984,12 @@ HandleConfirmReturnToRegistration(Clay_ElementId elementId, Clay_PointerData poi
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
         Event *tournament = data.tournaments.events + data.selectedTournamentIdx;
-        tournament->phase = PHASE_REGISTRATION;
+        history_begin();
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
+        tournament_return_to_registration(tournament);
+        history_commit();
+        results_update_event(&data.players, &data.tournaments, data.selectedTournamentIdx);
         data.confirmationModal = MODAL_NULL;
-
-        tournament_construct_groups(tournament);
-        tournament_construct_bracket(tournament);
-        tournament_populate_bracket_from_groups(tournament);
     }
 }
 
@@ -589,11 +1010,12 @@ HandleConfirmReturnToGroupPhase(Clay_ElementId elementId, Clay_PointerData point
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
         Event *tournament = data.tournaments.events + data.selectedTournamentIdx;
-        tournament->phase = PHASE_GROUP;
+        history_begin();
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
+        tournament_return_to_group_phase(tournament);
+        history_commit();
+        results_update_event(&data.players, &data.tournaments, data.selectedTournamentIdx);
         data.confirmationModal = MODAL_NULL;
-
-        tournament_construct_bracket(tournament);
-        tournament_populate_bracket_from_groups(tournament);
     }
 }
 
@@ -614,7 +1036,112 @@ HandleTerminateGroupPhase(Clay_ElementId elementId, Clay_PointerData pointerData
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
         Event *tournament = data.tournaments.events + data.selectedTournamentIdx;
-        tournament->phase = PHASE_KNOCKOUT;
+        history_begin();
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
+        tournament_terminate_group_phase(tournament);
+        history_commit();
+        results_update_event(&data.players, &data.tournaments, data.selectedTournamentIdx);
+    }
+}
+
+void
+HandleStepEventVersion(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData)
+{
+    data.mouseCursor = MOUSE_CURSOR_POINTING_HAND;
+    if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
+    {
+        s32 steps = *(s32 *)userData;
+        u32 event_idx = data.selectedTournamentIdx;
+        u32 version = snapshot_step(&snapshot_store, event_idx, steps);
+        if (version == 0) return;
+
+        // The players registered in either version may change, touch them all
+        Event *tournament = data.tournaments.events + event_idx;
+        Temp temp = scratch_get(0, 0);
+        Event *restored = push_array(temp.arena, Event, 1);
+        snapshot_read(&snapshot_store, event_idx, version, restored);
+        u64 registrations = tournament->registrations | restored->registrations;
+        scratch_release(temp);
+
+        history_begin();
+        history_touch_event(&data.tournaments, event_idx);
+        s32 positions[64];
+        u32 count = find_all_filled_slots(registrations, positions);
+        for (u32 i = 0; i < count; i++)
+        {
+            history_touch_player(&data.players, (u32)positions[i]);
+        }
+        snapshot_restore(&snapshot_store, &data.players, &data.tournaments, event_idx, version);
+        history_commit();
+    }
+}
+
+void
+HandleScheduleStep(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData)
+{
+    data.mouseCursor = MOUSE_CURSOR_POINTING_HAND;
+    if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
+    {
+        ScheduleStep *step = (ScheduleStep *)userData;
+        s32 slots = (s32)schedule.num_slots;
+        s32 courts = (s32)schedule.num_courts;
+        s32 first_slot = (s32)schedule.first_slot;
+
+        switch (step->setting)
+        {
+            case SCHEDULE_SETTING_SLOTS:
+                slots = Max(1, Min(slots + step->delta, SCHEDULE_MAX_SLOTS));
+                schedule_set_venue(&schedule, (u32)slots, (u32)courts);
+                break;
+            case SCHEDULE_SETTING_COURTS:
+                courts = Max(1, Min(courts + step->delta, SCHEDULE_MAX_COURTS));
+                schedule_set_venue(&schedule, (u32)slots, (u32)courts);
+                break;
+            case SCHEDULE_SETTING_FIRST_SLOT:
+                first_slot = Max(0, Min(first_slot + step->delta, slots - 1));
+                schedule_set_first_slot(&schedule, (u32)first_slot);
+                break;
+        }
+        schedule_update(&schedule, &data.players, &data.tournaments);
+    }
+}
+
+void
+HandleToggleLateEntry(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData)
+{
+    data.mouseCursor = MOUSE_CURSOR_POINTING_HAND;
+    if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
+    {
+        u32 player_idx = *(u32 *)userData;
+        if (data.lateGroupEventIdx != data.selectedTournamentIdx)
+        {
+            data.lateGroup = 0;
+            data.lateGroupEventIdx = data.selectedTournamentIdx;
+        }
+        data.lateGroup ^= 1ULL << player_idx;
+    }
+}
+
+void
+HandleFormLateGroup(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData)
+{
+    data.mouseCursor = MOUSE_CURSOR_POINTING_HAND;
+    if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
+    {
+        u32 event_idx = data.selectedTournamentIdx;
+
+        history_begin();
+        history_touch_event(&data.tournaments, event_idx);
+        s32 positions[64];
+        u32 count = find_all_filled_slots(data.lateGroup, positions);
+        for (u32 i = 0; i < count; i++)
+        {
+            history_touch_player(&data.players, (u32)positions[i]);
+        }
+        register_late_group_to_event(&data.players, &data.tournaments, event_idx, data.lateGroup);
+        history_commit();
+
+        data.lateGroup = 0;
     }
 }
 
@@ -626,7 +1153,11 @@ HandleConfirmDeleteTournament(Clay_ElementId elementId, Clay_PointerData pointer
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
         Event *tournament = data.tournaments.events + data.deleteTournamentIdx;
+        LabelCache_Forget(tournament->name);
+        snapshot_forget_event(&snapshot_store, data.deleteTournamentIdx);
+        schedule_forget_event(&schedule, data.deleteTournamentIdx);
         events_list_remove(&data.tournaments, &data.players, tournament->name);
+        history_clear();
         data.deleteTournamentIdx = 0;
         data.confirmationModal = MODAL_NULL;
     }
@@ -652,7 +1183,14 @@ HandleConfirmDeletePlayer(Clay_ElementId elementId, Clay_PointerData pointerData
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
         Player *player = data.players.players + data.deletePlayerIdx;
+        LabelCache_Forget(player->name);
+
+        // Their events are rebuilt without them, and the index may come back
+        schedule_mark_events(&schedule, player->registrations);
+        schedule_set_unavailable(&schedule, data.deletePlayerIdx, 0);
         players_list_remove(&data.players, &data.tournaments, player->name);
+        snapshot_forget_player(&snapshot_store, &data.tournaments, data.deletePlayerIdx);
+        history_clear();
         data.deletePlayerIdx = 0;
         data.confirmationModal = MODAL_NULL;
     }
@@ -678,7 +1216,10 @@ HandleSelectTournamentFormat(Clay_ElementId elementId, Clay_PointerData pointerD
     {
         TournamentFormat format = *(TournamentFormat *)userData;
         Event *tournament = data.tournaments.events + data.selectedTournamentIdx;
+        history_begin();
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
         tournament->format = format;
+        history_commit();
     }
 }
 
@@ -734,7 +1275,11 @@ HandleConfirmRenameEvent(Clay_ElementId elementId, Clay_PointerData pointerData,
                     return;
                 }
 
+                LabelCache_Forget(data.tournaments.events[data.renamingEventIdx].name);
+                history_begin();
+                history_touch_event(&data.tournaments, data.renamingEventIdx);
                 events_list_rename(&data.tournaments, data.renamingEventIdx, new_name);
+                history_commit();
             }
 
             // Clear rename state
@@ -811,7 +1356,11 @@ HandleConfirmRenamePlayer(Clay_ElementId elementId, Clay_PointerData pointerData
                     return;
                 }
 
+                LabelCache_Forget(data.players.players[data.renamingPlayerIdx].name);
+                history_begin();
+                history_touch_player(&data.players, data.renamingPlayerIdx);
                 players_list_rename(&data.players, data.renamingPlayerIdx, new_name);
+                history_commit();
             }
 
             // Clear rename state
@@ -843,12 +1392,15 @@ HandleIncrementGroupSize(Clay_ElementId elementId, Clay_PointerData pointerData,
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
         Event *tournament = data.tournaments.events + data.selectedTournamentIdx;
+        history_begin();
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
         if (tournament->group_phase.group_size < MAX_GROUP_SIZE)
         {
             tournament->group_phase.group_size++;
         }
 
         tournament_construct_groups(tournament);
+        history_commit();
     }
 }
 
@@ -860,12 +1412,15 @@ HandleDecrementGroupSize(Clay_ElementId elementId, Clay_PointerData pointerData,
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
         Event *tournament = data.tournaments.events + data.selectedTournamentIdx;
+        history_begin();
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
         if (tournament->group_phase.group_size > 2)
         {
             tournament->group_phase.group_size--;
         }
 
         tournament_construct_groups(tournament);
+        history_commit();
     }
 }
 
@@ -878,11 +1433,14 @@ HandleIncrementAdvancePerGroup(Clay_ElementId elementId, Clay_PointerData pointe
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
         Event *tournament = data.tournaments.events + data.selectedTournamentIdx;
+        history_begin();
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
         // Cannot advance more players than are in the group
         if (tournament->group_phase.advance_per_group < tournament->group_phase.group_size - 1)
         {
             tournament->group_phase.advance_per_group++;
         }
+        history_commit();
     }
 }
 
@@ -895,10 +1453,13 @@ HandleDecrementAdvancePerGroup(Clay_ElementId elementId, Clay_PointerData pointe
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
         Event *tournament = data.tournaments.events + data.selectedTournamentIdx;
+        history_begin();
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
         if (tournament->group_phase.advance_per_group > 1)
         {
             tournament->group_phase.advance_per_group--;
         }
+        history_commit();
     }
 }
 
@@ -927,7 +1488,7 @@ HandleMatrixCellClick(Clay_ElementId elementId, Clay_PointerData pointerData, vo
 
     if (pointerData.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME)
     {
-        double currentTime = GetTime();
+        double currentTime = input_time();
 
         // Check for double-click on the same cell
         if (data.lastClickCellId == cellData->cell_id &&
@@ -1008,25 +1569,18 @@ HandleConfirmScoreModal(Clay_ElementId elementId, Clay_PointerData pointerData,
             }
         }
 
-        // Save to the tournament's group phase
+        // Save to the tournament's group phase (mirror entry included)
         Event *tournament = data.tournaments.events + data.selectedTournamentIdx;
-        u32 g = data.scoreModalGroupIdx;
-        u32 row = data.scoreModalRowIdx;
-        u32 col = data.scoreModalColIdx;
-
-        // Store the score for this match
-        tournament->group_phase.scores[g][row][col].row_score = score1;
-        tournament->group_phase.scores[g][row][col].col_score = score2;
-
-        // Also store the mirror entry (col vs row) with swapped scores
-        tournament->group_phase.scores[g][col][row].row_score = score2;
-        tournament->group_phase.scores[g][col][row].col_score = score1;
+        history_begin();
+        history_touch_event(&data.tournaments, data.selectedTournamentIdx);
+        tournament_set_group_score(tournament, data.scoreModalGroupIdx,
+            data.scoreModalRowIdx, data.scoreModalColIdx, score1, score2);
+        history_commit();
+        results_update_event(&data.players, &data.tournaments, data.selectedTournamentIdx);
 
         // Close the modal
         data.modalScoreActive = false;
         data.focusedTextbox = TEXTBOX_NULL;
-
-        tournament_populate_bracket_from_groups(tournament);
     }
 }
 
@@ -1058,20 +1612,30 @@ HandleToggleKnockoutPanel(Clay_ElementId elementId, Clay_PointerData pointerData
 // Texbox functions
 
 void
-TextInput_ProcessKeyboard(TextInput *input)
+TextInput_UpdateBlink(TextInput *input, float dt)
 {
-    float dt = GetFrameTime();
-
-    // Update blink timer
     input->blinkTimer += dt;
     if (input->blinkTimer > 1.0f) {
         input->blinkTimer -= 1.0f;
     }
+}
+
+float
+TextInput_SecondsToBlink(TextInput *input)
+{
+    // Visible for the first half of the period, see TextInput_RenderCursor
+    return input->blinkTimer < 0.5f ? 0.5f - input->blinkTimer : 1.0f - input->blinkTimer;
+}
+
+void
+TextInput_ProcessKeyboard(TextInput *input)
+{
+    TextInput_UpdateBlink(input, input_frame_time());
 
     // Handle character input - insert at cursor position
     const float maxTextWidth = TEXTBOX_WIDTH - (TEXTBOX_PADDING * 2);
 
-    int key = GetCharPressed();
+    int key = input_char_pressed();
     while (key > 0)
     {
         // Clear duplicate warning when user types
@@ -1119,11 +1683,11 @@ TextInput_ProcessKeyboard(TextInput *input)
                 input->blinkTimer = 0.0f;
             }
         }
-        key = GetCharPressed();
+        key = input_char_pressed();
     }
 
     // Handle backspace - delete character before cursor
-    if (IsKeyPressed(KEY_BACKSPACE) || IsKeyPressedRepeat(KEY_BACKSPACE)) {
+    if (input_key_pressed(KEY_BACKSPACE) || input_key_pressed_repeat(KEY_BACKSPACE)) {
         // Clear duplicate warning when user deletes
         data.duplicateWarning = DUPLICATE_NONE;
         if (input->cursorPos > 0) {
@@ -1138,7 +1702,7 @@ TextInput_ProcessKeyboard(TextInput *input)
     }
 
     // Handle delete - delete character at cursor
-    if (IsKeyPressed(KEY_DELETE) || IsKeyPressedRepeat(KEY_DELETE)) {
+    if (input_key_pressed(KEY_DELETE) || input_key_pressed_repeat(KEY_DELETE)) {
         // Clear duplicate warning when user deletes
         data.duplicateWarning = DUPLICATE_NONE;
         if (input->cursorPos < input->len) {
@@ -1152,7 +1716,7 @@ TextInput_ProcessKeyboard(TextInput *input)
     }
 
     // Handle left arrow
-    if (IsKeyPressed(KEY_LEFT) || IsKeyPressedRepeat(KEY_LEFT)) {
+    if (input_key_pressed(KEY_LEFT) || input_key_pressed_repeat(KEY_LEFT)) {
         if (input->cursorPos > 0) {
             input->cursorPos--;
             input->blinkTimer = 0.0f;
@@ -1160,7 +1724,7 @@ TextInput_ProcessKeyboard(TextInput *input)
     }
 
     // Handle right arrow
-    if (IsKeyPressed(KEY_RIGHT) || IsKeyPressedRepeat(KEY_RIGHT)) {
+    if (input_key_pressed(KEY_RIGHT) || input_key_pressed_repeat(KEY_RIGHT)) {
         if (input->cursorPos < input->len) {
             input->cursorPos++;
             input->blinkTimer = 0.0f;
@@ -1168,13 +1732,13 @@ TextInput_ProcessKeyboard(TextInput *input)
     }
 
     // Handle Home key
-    if (IsKeyPressed(KEY_HOME)) {
+    if (input_key_pressed(KEY_HOME)) {
         input->cursorPos = 0;
         input->blinkTimer = 0.0f;
     }
 
     // Handle End key
-    if (IsKeyPressed(KEY_END)) {
+    if (input_key_pressed(KEY_END)) {
         input->cursorPos = input->len;
         input->blinkTimer = 0.0f;
     }
@@ -1350,6 +1914,21 @@ RenderHeaderButton(Clay_String text, Page page)
     }
 }
 
+/**
+ * Name of the player at a position of the medal table, "---" when fewer
+ * players won a medal.
+ */
+Clay_String
+MedalTable_Name(u32 position)
+{
+    SortedView *table = data.players.by_medals;
+    if (position >= sorted_view_count_keyed(table))
+    {
+        return CLAY_STRING("---");
+    }
+    return LabelCache_Name(table->entries[position].name);
+}
+
 void
 RenderDashboard(void)
 {
@@ -1425,8 +2004,7 @@ RenderDashboard(void)
                         .textColor = dashLabelText
                     }));
                     u32 tournaments_count = events_list_count(&data.tournaments);
-                    String8 tournaments_count_str8 = str8_from_u32(data.frameArena, tournaments_count);
-                    Clay_String tournaments_count_clay = str8_to_clay(tournaments_count_str8);
+                    Clay_String tournaments_count_clay = LabelCache_Number(tournaments_count);
                     CLAY_TEXT(tournaments_count_clay, CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_PRESS_START_2P,
                         .fontSize = 48,
@@ -1467,8 +2045,7 @@ RenderDashboard(void)
                         .textColor = dashLabelText
                     }));
                     u32 players_count = players_list_count(&data.players);
-                    String8 players_count_str8 = str8_from_u32(data.frameArena, players_count);
-                    Clay_String players_count_clay = str8_to_clay(players_count_str8);
+                    Clay_String players_count_clay = LabelCache_Number(players_count);
                     CLAY_TEXT(players_count_clay, CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_PRESS_START_2P,
                         .fontSize = 48,
@@ -1508,7 +2085,8 @@ RenderDashboard(void)
                         .fontSize = 12,
                         .textColor = dashLabelText
                     }));
-                    CLAY_TEXT(CLAY_STRING("?"), CLAY_TEXT_CONFIG({
+                    u32 finished_count = events_list_finished_count(&data.tournaments);
+                    CLAY_TEXT(LabelCache_Number(finished_count), CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_PRESS_START_2P,
                         .fontSize = 48,
                         .textColor = dashAccentGold
@@ -1574,7 +2152,7 @@ RenderDashboard(void)
                         .fontSize = 32,
                         .textColor = dashAccentGold
                     }));
-                    CLAY_TEXT(CLAY_STRING("---"), CLAY_TEXT_CONFIG({
+                    CLAY_TEXT(MedalTable_Name(0), CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_BODY_16,
                         .fontSize = 16,
                         .textColor = dashLabelText
@@ -1604,7 +2182,7 @@ RenderDashboard(void)
                         .fontSize = 32,
                         .textColor = { 140, 140, 140, 255 }
                     }));
-                    CLAY_TEXT(CLAY_STRING("---"), CLAY_TEXT_CONFIG({
+                    CLAY_TEXT(MedalTable_Name(1), CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_BODY_16,
                         .fontSize = 16,
                         .textColor = dashLabelText
@@ -1634,7 +2212,7 @@ RenderDashboard(void)
                         .fontSize = 32,
                         .textColor = { 180, 110, 45, 255 }
                     }));
-                    CLAY_TEXT(CLAY_STRING("---"), CLAY_TEXT_CONFIG({
+                    CLAY_TEXT(MedalTable_Name(2), CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_BODY_16,
                         .fontSize = 16,
                         .textColor = dashLabelText
@@ -1781,25 +2359,97 @@ RenderFormatOption(TournamentFormat format, TournamentFormat current_format,
     }
 }
 
+/**
+ * "< VERSION n / m >": steps the selected event back and forth through its
+ * versions, shown once it has more than one.
+ */
 void
-RenderRegistrationPanel(u32 tournament_idx, Event *tournament,
-    s32 *registered_positions, u32 registered_count)
+RenderVersionStepper(void)
 {
-    // Tournament format selector (radio-style list)
-    CLAY(CLAY_ID("FormatSelector"), {
+    u32 position;
+    u32 count = snapshot_count(&snapshot_store, data.selectedTournamentIdx, &position);
+    if (count < 2) return;
+
+    CLAY(CLAY_ID("VersionStepper"), {
         .layout = {
-            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .layoutDirection = CLAY_LEFT_TO_RIGHT,
             .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
-            .childGap = 4
+            .childGap = 8,
+            .childAlignment = { .x = CLAY_ALIGN_X_CENTER, .y = CLAY_ALIGN_Y_CENTER }
         }
     }) {
-        RenderFormatOption(FORMAT_KNOCKOUT, tournament->format,
-            CLAY_STRING("Single Elimination"),
-            CLAY_STRING("Direct knockout bracket"),
-            FORMAT_KNOCKOUT);
+        for (u32 i = 0; i < 2; i++)
+        {
+            s32 *steps = push_array(data.frameArena, s32, 1);
+            *steps = i == 0 ? -1 : 1;
+            b32 enabled = i == 0 ? position > 1 : position < count;
 
-        RenderFormatOption(FORMAT_GROUP_KNOCKOUT, tournament->format,
-            CLAY_STRING("Groups + Knockout"),
+            if (i == 1)
+            {
+                CLAY_TEXT(CLAY_STRING("VERSION"), CLAY_TEXT_CONFIG({
+                    .fontId = FONT_ID_BODY_16,
+                    .fontSize = 10,
+                    .textColor = dashLabelText
+                }));
+                CLAY_TEXT(LabelCache_Number(position), CLAY_TEXT_CONFIG({
+                    .fontId = FONT_ID_BODY_16,
+                    .fontSize = 13,
+                    .textColor = stringColor
+                }));
+                CLAY_TEXT(CLAY_STRING("/"), CLAY_TEXT_CONFIG({
+                    .fontId = FONT_ID_BODY_16,
+                    .fontSize = 13,
+                    .textColor = dashLabelText
+                }));
+                CLAY_TEXT(LabelCache_Number(count), CLAY_TEXT_CONFIG({
+                    .fontId = FONT_ID_BODY_16,
+                    .fontSize = 13,
+                    .textColor = stringColor
+                }));
+            }
+
+            CLAY(CLAY_IDI("VersionStep", i), {
+                .layout = {
+                    .sizing = {.width = CLAY_SIZING_FIXED(28), .height = CLAY_SIZING_FIXED(24)},
+                    .childAlignment = { .x = CLAY_ALIGN_X_CENTER, .y = CLAY_ALIGN_Y_CENTER }
+                },
+                .backgroundColor = enabled && Clay_Hovered() ? dashAccentOrange : COLOR_WHITE,
+                .cornerRadius = CLAY_CORNER_RADIUS(6),
+                .border = { .width = {2, 2, 2, 2}, .color = enabled ? dashAccentOrange : textInputBorderColor }
+            }) {
+                if (enabled)
+                {
+                    Clay_OnHover(HandleStepEventVersion, steps);
+                }
+                CLAY_TEXT(i == 0 ? CLAY_STRING("<") : CLAY_STRING(">"), CLAY_TEXT_CONFIG({
+                    .fontId = FONT_ID_BODY_16,
+                    .fontSize = 13,
+                    .textColor = !enabled ? textInputBorderColor : Clay_Hovered() ? COLOR_WHITE : dashAccentOrange
+                }));
+            }
+        }
+    }
+}
+
+void
+RenderRegistrationPanel(u32 tournament_idx, Event *tournament,
+    s32 *registered_positions, u32 registered_count)
+{
+    // Tournament format selector (radio-style list)
+    CLAY(CLAY_ID("FormatSelector"), {
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+            .childGap = 4
+        }
+    }) {
+        RenderFormatOption(FORMAT_KNOCKOUT, tournament->format,
+            CLAY_STRING("Single Elimination"),
+            CLAY_STRING("Direct knockout bracket"),
+            FORMAT_KNOCKOUT);
+
+        RenderFormatOption(FORMAT_GROUP_KNOCKOUT, tournament->format,
+            CLAY_STRING("Groups + Knockout"),
             CLAY_STRING("Round-robin groups, then bracket"),
             FORMAT_GROUP_KNOCKOUT);
     }
@@ -1873,8 +2523,8 @@ RenderRegistrationPanel(u32 tournament_idx, Event *tournament,
                             }));
                         }
                         // Value
-                        String8 size_str = str8_from_u32(data.frameArena, tournament->group_phase.group_size);
-                        CLAY_TEXT(str8_to_clay(size_str), CLAY_TEXT_CONFIG({
+                        Clay_String size_str = LabelCache_Number(tournament->group_phase.group_size);
+                        CLAY_TEXT(size_str, CLAY_TEXT_CONFIG({
                             .fontId = FONT_ID_PRESS_START_2P,
                             .fontSize = 20,
                             .textColor = dashAccentTeal
@@ -1958,8 +2608,8 @@ RenderRegistrationPanel(u32 tournament_idx, Event *tournament,
                             }));
                         }
                         // Value
-                        String8 advance_str = str8_from_u32(data.frameArena, tournament->group_phase.advance_per_group);
-                        CLAY_TEXT(str8_to_clay(advance_str), CLAY_TEXT_CONFIG({
+                        Clay_String advance_str = LabelCache_Number(tournament->group_phase.advance_per_group);
+                        CLAY_TEXT(advance_str, CLAY_TEXT_CONFIG({
                             .fontId = FONT_ID_PRESS_START_2P,
                             .fontSize = 20,
                             .textColor = dashAccentOrange
@@ -2022,6 +2672,8 @@ RenderRegistrationPanel(u32 tournament_idx, Event *tournament,
         }
     }
 
+    RenderVersionStepper();
+
     CLAY(CLAY_ID("RegisteredHeader"), {
         .layout = {
             .layoutDirection = CLAY_LEFT_TO_RIGHT,
@@ -2047,8 +2699,8 @@ RenderRegistrationPanel(u32 tournament_idx, Event *tournament,
             .backgroundColor = COLOR_WHITE,
             .cornerRadius = CLAY_CORNER_RADIUS(8)
         }) {
-            String8 count_str = str8_from_u32(data.frameArena, registered_count);
-            CLAY_TEXT(str8_to_clay(count_str), CLAY_TEXT_CONFIG({
+            Clay_String count_str = LabelCache_Number(registered_count);
+            CLAY_TEXT(count_str, CLAY_TEXT_CONFIG({
                 .fontId = FONT_ID_BODY_16,
                 .fontSize = 10,
                 .textColor = dashAccentTeal
@@ -2103,8 +2755,8 @@ RenderRegistrationPanel(u32 tournament_idx, Event *tournament,
                     .backgroundColor = dashAccentTeal,
                     .cornerRadius = CLAY_CORNER_RADIUS(10)
                 }) {
-                    String8 num_str = str8_from_u32(data.frameArena, i + 1);
-                    CLAY_TEXT(str8_to_clay(num_str), CLAY_TEXT_CONFIG({
+                    Clay_String num_str = LabelCache_Number(i + 1);
+                    CLAY_TEXT(num_str, CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_BODY_16,
                         .fontSize = 10,
                         .textColor = COLOR_WHITE
@@ -2116,7 +2768,7 @@ RenderRegistrationPanel(u32 tournament_idx, Event *tournament,
                         .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)}
                     }
                 }) {
-                    CLAY_TEXT(str8_to_clay_truncated(data.frameArena, player->name, MAX_DISPLAY_NAME_LEN), CLAY_TEXT_CONFIG({
+                    CLAY_TEXT(LabelCache_Name(player->name), CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_BODY_16,
                         .fontSize = 14,
                         .textColor = stringColor
@@ -2200,7 +2852,7 @@ RenderRegistrationPanel(u32 tournament_idx, Event *tournament,
                         }));
                     }
                     // Player name
-                    CLAY_TEXT(str8_to_clay_truncated(data.frameArena, player->name, MAX_DISPLAY_NAME_LEN), CLAY_TEXT_CONFIG({
+                    CLAY_TEXT(LabelCache_Name(player->name), CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_BODY_16,
                         .fontSize = 14,
                         .textColor = stringColor
@@ -2214,6 +2866,102 @@ RenderRegistrationPanel(u32 tournament_idx, Event *tournament,
 }
 
 // Render in-progress phase left panel content
+/**
+ * Latecomers of an event in the group phase: the players not registered to
+ * it, picked one by one, form an additional group.
+ */
+void
+RenderLateGroupPanel(Event *tournament)
+{
+    u64 picked = data.lateGroupEventIdx == data.selectedTournamentIdx ? data.lateGroup : 0;
+    u32 picked_count = registration_count(picked);
+    b32 can_form = picked_count >= 2 && picked_count <= MAX_GROUP_SIZE &&
+                   tournament->group_phase.num_groups < MAX_GROUPS;
+
+    CLAY(CLAY_ID("LateGroupCardOuter"), {
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)}
+        },
+        .cornerRadius = CLAY_CORNER_RADIUS(8)
+    }) {
+        CLAY(CLAY_ID("LateGroupAccentBar"), {
+            .layout = {
+                .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+                .padding = { 12, 12, 6, 6 },
+                .childAlignment = { .x = CLAY_ALIGN_X_CENTER, .y = CLAY_ALIGN_Y_CENTER }
+            },
+            .backgroundColor = dashAccentOrange,
+            .cornerRadius = { 8, 8, 0, 0 }
+        }) {
+            CLAY_TEXT(CLAY_STRING("LATE ENTRIES"), CLAY_TEXT_CONFIG({
+                .fontId = FONT_ID_BODY_16,
+                .fontSize = 12,
+                .textColor = COLOR_WHITE
+            }));
+        }
+        CLAY(CLAY_ID("LateGroupCard"), {
+            .layout = {
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+                .padding = { 8, 8, 8, 8 },
+                .childGap = 4
+            },
+            .backgroundColor = dashCardBg,
+            .cornerRadius = { 0, 0, 8, 8 }
+        }) {
+            u32 idx_tail = data.players.len - 1;
+            for (u32 player_idx = (data.players.players)->nxt; player_idx != idx_tail;
+                 player_idx = data.players.players[player_idx].nxt)
+            {
+                if ((tournament->registrations >> player_idx) & 1) continue;
+
+                Player *player = data.players.players + player_idx;
+                b32 isPicked = (picked >> player_idx) & 1;
+                u32 *pIdx = push_array(data.frameArena, u32, 1);
+                *pIdx = player_idx;
+
+                CLAY(CLAY_IDI("LateEntry", player_idx), {
+                    .layout = {
+                        .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+                        .padding = { 8, 8, 6, 6 }
+                    },
+                    .backgroundColor = isPicked ? dashAccentOrange : Clay_Hovered() ? dashCardBg : playerRowColor,
+                    .cornerRadius = CLAY_CORNER_RADIUS(4),
+                    .border = { .width = {1, 1, 1, 1}, .color = isPicked ? dashAccentOrange : textInputBorderColor }
+                }) {
+                    Clay_OnHover(HandleToggleLateEntry, pIdx);
+                    CLAY_TEXT(LabelCache_Name(player->name), CLAY_TEXT_CONFIG({
+                        .fontId = FONT_ID_BODY_16,
+                        .fontSize = 14,
+                        .textColor = isPicked ? COLOR_WHITE : stringColor
+                    }));
+                }
+            }
+
+            CLAY(CLAY_ID("FormLateGroupButton"), {
+                .layout = {
+                    .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+                    .padding = { 10, 10, 8, 8 },
+                    .childAlignment = { .x = CLAY_ALIGN_X_CENTER }
+                },
+                .backgroundColor = !can_form ? textInputBorderColor : Clay_Hovered() ? dashAccentPurple : dashAccentTeal,
+                .cornerRadius = CLAY_CORNER_RADIUS(8)
+            }) {
+                if (can_form)
+                {
+                    Clay_OnHover(HandleFormLateGroup, NULL);
+                }
+                CLAY_TEXT(CLAY_STRING("Form Group"), CLAY_TEXT_CONFIG({
+                    .fontId = FONT_ID_BODY_16,
+                    .fontSize = 14,
+                    .textColor = COLOR_WHITE
+                }));
+            }
+        }
+    }
+}
+
 void
 RenderInProgressPanel(s32 *registered_positions, u32 registered_count)
 {
@@ -2290,6 +3038,13 @@ RenderInProgressPanel(s32 *registered_positions, u32 registered_count)
         }));
     }
 
+    RenderVersionStepper();
+
+    if (tournament->format == FORMAT_GROUP_KNOCKOUT && tournament->phase == PHASE_GROUP)
+    {
+        RenderLateGroupPanel(tournament);
+    }
+
     if (tournament->format == FORMAT_GROUP_KNOCKOUT)
     {
         // Read-only group settings info - styled cards
@@ -2333,8 +3088,8 @@ RenderInProgressPanel(s32 *registered_positions, u32 registered_count)
                         .fontSize = 10,
                         .textColor = dashLabelText
                     }));
-                    String8 size_str = str8_from_u32(data.frameArena, tournament->group_phase.group_size);
-                    CLAY_TEXT(str8_to_clay(size_str), CLAY_TEXT_CONFIG({
+                    Clay_String size_str = LabelCache_Number(tournament->group_phase.group_size);
+                    CLAY_TEXT(size_str, CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_PRESS_START_2P,
                         .fontSize = 24,
                         .textColor = dashAccentTeal
@@ -2375,8 +3130,8 @@ RenderInProgressPanel(s32 *registered_positions, u32 registered_count)
                         .fontSize = 10,
                         .textColor = dashLabelText
                     }));
-                    String8 advance_str = str8_from_u32(data.frameArena, tournament->group_phase.advance_per_group);
-                    CLAY_TEXT(str8_to_clay(advance_str), CLAY_TEXT_CONFIG({
+                    Clay_String advance_str = LabelCache_Number(tournament->group_phase.advance_per_group);
+                    CLAY_TEXT(advance_str, CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_PRESS_START_2P,
                         .fontSize = 24,
                         .textColor = dashAccentOrange
@@ -2464,15 +3219,15 @@ RenderInProgressPanel(s32 *registered_positions, u32 registered_count)
                         .backgroundColor = dashAccentPurple,
                         .cornerRadius = CLAY_CORNER_RADIUS(10)
                     }) {
-                        String8 num_str = str8_from_u32(data.frameArena, i + 1);
-                        CLAY_TEXT(str8_to_clay(num_str), CLAY_TEXT_CONFIG({
+                        Clay_String num_str = LabelCache_Number(i + 1);
+                        CLAY_TEXT(num_str, CLAY_TEXT_CONFIG({
                             .fontId = FONT_ID_BODY_16,
                             .fontSize = 10,
                             .textColor = COLOR_WHITE
                         }));
                     }
                     // Player name
-                    CLAY_TEXT(str8_to_clay_truncated(data.frameArena, player->name, MAX_DISPLAY_NAME_LEN), CLAY_TEXT_CONFIG({
+                    CLAY_TEXT(LabelCache_Name(player->name), CLAY_TEXT_CONFIG({
                         .fontId = FONT_ID_BODY_16,
                         .fontSize = 14,
                         .textColor = stringColor
@@ -2756,8 +3511,11 @@ RenderKnockoutHeader(void)
 }
 
 void
-RenderKnockoutChart(u8 *bracket, u32 num_players)
+RenderKnockoutChart(u8 *bracket, u32 num_players, Event *tournament, Clay_ElementId clipId)
 {
+    CanvasCull *cull = &data.knockoutCanvas;
+    CanvasCull_Begin(cull, tournament, data.chartZoomLevel, clipId);
+
     CLAY(CLAY_ID("KnockoutBracketContainer"), {
         .layout = {
             .layoutDirection = CLAY_TOP_TO_BOTTOM,
@@ -2848,8 +3606,12 @@ RenderKnockoutChart(u8 *bracket, u32 num_players)
                                 .childAlignment = { .x = CLAY_ALIGN_X_CENTER, .y = CLAY_ALIGN_Y_CENTER }
                             }
                         }) {
+                            if (CanvasCull_Skip(cull, CLAY_IDI("MatchBorder", match_id)))
+                            {
+                                // Off-screen: only the box is declared, the connection curves still need it
+                            }
                             // BYE slots only exist in the first round
-                            if (round == 0 && player1_idx == 0 && player2_idx == 0)
+                            else if (round == 0 && player1_idx == 0 && player2_idx == 0)
                             {
                                 RenderByeSlot(match_id, zoom);
                             }
@@ -2862,12 +3624,12 @@ RenderKnockoutChart(u8 *bracket, u32 num_players)
                                 if (player1_idx != 0)
                                 {
                                     Player *player1 = data.players.players + player1_idx;
-                                    name1 = str8_to_clay_truncated(data.frameArena, player1->name, MAX_DISPLAY_NAME_LEN);
+                                    name1 = LabelCache_Name(player1->name);
                                 }
                                 if (player2_idx != 0)
                                 {
                                     Player *player2 = data.players.players + player2_idx;
-                                    name2 = str8_to_clay_truncated(data.frameArena, player2->name, MAX_DISPLAY_NAME_LEN);
+                                    name2 = LabelCache_Name(player2->name);
                                 }
 
                                 RenderMatchSlot(name1, name2, player1_idx, player2_idx, pos1, pos2, match_id, zoom);
@@ -2887,6 +3649,8 @@ void
 RenderGroupMatrix(Event *tournament, u32 group_idx, u32 players_in_group)
 {
     float zoom = data.groupMatrixZoomLevel;
+    // Zoomed far out the scores are unreadable anyway: cells become plain colored tiles
+    bool lod = (zoom < MATRIX_LOD_ZOOM);
     u16 cellWidth = (u16)(100 * zoom);
     u16 cellGap = (u16)(4 * zoom);
     u16 padH = (u16)(8 * zoom);
@@ -2948,7 +3712,7 @@ RenderGroupMatrix(Event *tournament, u32 group_idx, u32 players_in_group)
                         .backgroundColor = groupAccent,
                         .cornerRadius = CLAY_CORNER_RADIUS(cornerRad)
                     }) {
-                        CLAY_TEXT(str8_to_clay_truncated(data.frameArena, player->name, MAX_DISPLAY_NAME_LEN), CLAY_TEXT_CONFIG({
+                        CLAY_TEXT(LabelCache_Name(player->name), CLAY_TEXT_CONFIG({
                             .fontId = FONT_ID_BODY_16,
                             .fontSize = fontSizeMed,
                             .textColor = COLOR_WHITE
@@ -2984,7 +3748,7 @@ RenderGroupMatrix(Event *tournament, u32 group_idx, u32 players_in_group)
                         .backgroundColor = groupAccent,
                         .cornerRadius = CLAY_CORNER_RADIUS(cornerRad)
                     }) {
-                        CLAY_TEXT(str8_to_clay_truncated(data.frameArena, row_player->name, MAX_DISPLAY_NAME_LEN), CLAY_TEXT_CONFIG({
+                        CLAY_TEXT(LabelCache_Name(row_player->name), CLAY_TEXT_CONFIG({
                             .fontId = FONT_ID_BODY_16,
                             .fontSize = fontSizeMed,
                             .textColor = COLOR_WHITE
@@ -3001,19 +3765,40 @@ RenderGroupMatrix(Event *tournament, u32 group_idx, u32 players_in_group)
                             bool isDiagonal = (row == col);
                             bool isGroupPhase = (tournament->phase == PHASE_GROUP);
                             bool _showHover = (!isDiagonal && isGroupPhase);
+                            MatchScore score = tournament->group_phase.scores[group_idx][row][col];
+                            bool hasScore = (score.row_score != 0 || score.col_score != 0);
                             Clay_Color cell_bg_normal = isDiagonal ? textInputBorderColor : dashCardBg;
+                            Clay_Color cell_bg_hover = dashAccentTeal;
+                            if (lod && !isDiagonal)
+                            {
+                                cell_bg_normal = hasScore ? dashAccentTeal : dashCardBg;
+                                cell_bg_hover = dashAccentPurple;
+                            }
 
                             CLAY(CLAY_IDI("MatrixCell", cell_id), {
                                 .layout = {
-                                    .sizing = { .width = CLAY_SIZING_FIXED(cellWidth), .height = CLAY_SIZING_FIT(0) },
+                                    .sizing = { .width = CLAY_SIZING_FIXED(cellWidth),
+                                                .height = lod ? CLAY_SIZING_GROW(0) : CLAY_SIZING_FIT(0) },
                                     .padding = { padH, padH, padV, padV },
                                     .childAlignment = { .x = CLAY_ALIGN_X_CENTER, .y = CLAY_ALIGN_Y_CENTER }
                                 },
-                                .backgroundColor = (_showHover && Clay_Hovered()) ? dashAccentTeal : cell_bg_normal,
+                                .backgroundColor = (_showHover && Clay_Hovered()) ? cell_bg_hover : cell_bg_normal,
                                 .cornerRadius = CLAY_CORNER_RADIUS(cornerRad)
                             }) {
+                                if (lod)
+                                {
+                                    if (!isDiagonal && isGroupPhase)
+                                    {
+                                        MatrixCellData *pCellData = push_array(data.frameArena, MatrixCellData, 1);
+                                        pCellData->group_idx = group_idx;
+                                        pCellData->row_idx = row;
+                                        pCellData->col_idx = col;
+                                        pCellData->cell_id = cell_id;
+                                        Clay_OnHover(HandleMatrixCellClick, pCellData);
+                                    }
+                                }
                                 // Diagonal cells (player vs self) show dash
-                                if (isDiagonal)
+                                else if (isDiagonal)
                                 {
                                     CLAY_TEXT(CLAY_STRING("-"), CLAY_TEXT_CONFIG({
                                         .fontId = FONT_ID_BODY_16,
@@ -3034,18 +3819,10 @@ RenderGroupMatrix(Event *tournament, u32 group_idx, u32 players_in_group)
                                         Clay_OnHover(HandleMatrixCellClick, pCellData);
                                     }
 
-                                    // Get the score for this cell
-                                    MatchScore score = tournament->group_phase.scores[group_idx][row][col];
-                                    bool hasScore = (score.row_score != 0 || score.col_score != 0);
-
                                     if (hasScore)
                                     {
                                         // Display score as "X - Y"
-                                        String8 str8_row_score = str8_from_u32(data.frameArena, (u32)score.row_score);
-                                        String8 str8_col_score = str8_from_u32(data.frameArena, (u32)score.col_score);
-                                        String8 separator = str8_lit_comp(" - ");
-                                        String8 res = str8_cat(data.frameArena, str8_cat(data.frameArena, str8_row_score, separator), str8_col_score);
-                                        CLAY_TEXT(str8_to_clay(res), CLAY_TEXT_CONFIG({
+                                        CLAY_TEXT(LabelCache_Score(score.row_score, score.col_score), CLAY_TEXT_CONFIG({
                                             .fontId = FONT_ID_BODY_16,
                                             .fontSize = fontSizeMed,
                                             .textColor = (_showHover && Clay_Hovered())  ? COLOR_WHITE : dashAccentTeal
@@ -3165,8 +3942,13 @@ RenderGroupsKnockoutChart(Event *tournament)
                     .backgroundColor = { 245, 250, 250, 255 },
                     .cornerRadius = { 0, 0, 12, 12 },
                 }) {
+                    CanvasCull *cull = &data.groupsCanvas;
+                    CanvasCull_Begin(cull, tournament, data.groupMatrixZoomLevel, CLAY_ID("GroupsAndBracketContainer"));
+
                     for (u32 g = 0; g < num_groups; g++)
                     {
+                        if (CanvasCull_Skip(cull, CLAY_IDI("GroupOuter", g))) continue;
+
                         // Count actual players in this group
                         u32 players_in_group = 0;
                         for (u32 slot = 0; slot < MAX_GROUP_SIZE; slot++)
@@ -3220,10 +4002,7 @@ RenderGroupsKnockoutChart(Event *tournament)
                                     .backgroundColor = groupAccent,
                                     .cornerRadius = CLAY_CORNER_RADIUS(8)
                                 }) {
-                                    String8 group_prefix = str8_lit("GROUP ");
-                                    String8 group_num = str8_from_u32(data.frameArena, g + 1);
-                                    String8 group_label = str8_cat(data.frameArena, group_prefix, group_num);
-                                    CLAY_TEXT(str8_to_clay(group_label), CLAY_TEXT_CONFIG({
+                                    CLAY_TEXT(LabelCache_Group(g + 1), CLAY_TEXT_CONFIG({
                                         .fontId = FONT_ID_PRESS_START_2P,
                                         .fontSize = 16,
                                         .textColor = COLOR_WHITE
@@ -3389,7 +4168,8 @@ RenderGroupsKnockoutChart(Event *tournament)
                     .backgroundColor = { 255, 248, 248, 255 },
                     .cornerRadius = { 0, 0, 12, 12 }
                 }) {
-                    RenderKnockoutChart(tournament->group_phase.bracket, num_qualifiers);
+                    RenderKnockoutChart(tournament->group_phase.bracket, num_qualifiers, tournament,
+                                        CLAY_ID("GroupsAndBracketContainer"));
                 }
             }
             } // end KnockoutPanelRow
@@ -3545,7 +4325,7 @@ RenderTournamentRightPanel(u32 tournament_idx)
 
             if (tournament->format == FORMAT_KNOCKOUT)
             {
-                RenderKnockoutChart(tournament->bracket, num_players);
+                RenderKnockoutChart(tournament->bracket, num_players, tournament, (Clay_ElementId){0});
             }
             else // FORMAT_GROUP_KNOCKOUT
             {
@@ -3745,6 +4525,17 @@ RenderEventsHeader(void)
                     .textColor = COLOR_WHITE
                 }));
             }
+
+            // Search box, pushed to the right edge
+            CLAY_AUTO_ID({ .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } } }) {}
+
+            if (data.focusedTextbox == TEXTBOX_EventSearch)
+            {
+                TextInput_ProcessKeyboard(&data.textInputs[TEXTBOX_EventSearch]);
+            }
+
+            TextInput_Render(TEXTBOX_EventSearch, CLAY_STRING("EventSearchInput"),
+                CLAY_STRING("EventSearchInputScroll"), CLAY_STRING("Search events..."));
         }
     }
 }
@@ -3791,22 +4582,14 @@ RenderEventsList(void)
                         .sizing = { .width = CLAY_SIZING_GROW(0) }
                     }
                 }) {
-                    CLAY_TEXT(CLAY_STRING("EVENT NAME"), CLAY_TEXT_CONFIG({
-                        .fontId = FONT_ID_BODY_16,
-                        .fontSize = 12,
-                        .textColor = dashLabelText
-                    }));
+                    RenderListOrderHeader(CLAY_STRING("EVENT NAME"), &data.eventsOrder, LIST_ORDER_NAME);
                 }
                 CLAY(CLAY_ID("EventPlayersHeader"), {
                     .layout = {
                         .sizing = { .width = CLAY_SIZING_FIXED(150) }
                     }
                 }) {
-                    CLAY_TEXT(CLAY_STRING("PLAYERS"), CLAY_TEXT_CONFIG({
-                        .fontId = FONT_ID_BODY_16,
-                        .fontSize = 12,
-                        .textColor = dashLabelText
-                    }));
+                    RenderListOrderHeader(CLAY_STRING("PLAYERS"), &data.eventsOrder, LIST_ORDER_REGISTRATIONS);
                 }
                 CLAY(CLAY_ID("EventActionsHeader"), {
                     .layout = {
@@ -3828,11 +4611,35 @@ RenderEventsList(void)
                 },
                 .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
             }) {
-                // Event rows
-                u32 idx_tail = data.tournaments.len - 1;
+                // Event rows, only the visible ones are declared
+                // Rows come from a sorted view, or from the linked list when
+                // none applies. While searching only the matches are listed,
+                // in name order, straight from the name view range
+                TextInput *search = &data.textInputs[TEXTBOX_EventSearch];
+                SortedView *view = NULL;
+                SortedRange range = {0};
+                if (search->len > 0)
+                {
+                    view = data.tournaments.by_name;
+                    range = sorted_view_prefix(view, str8((u8 *)search->buffer, search->len));
+                }
+                else if (data.eventsOrder != LIST_ORDER_RECENT)
+                {
+                    view = (data.eventsOrder == LIST_ORDER_NAME) ? data.tournaments.by_name : data.tournaments.by_registrations;
+                    range.count = view->count;
+                }
+                u32 numRows = view ? range.count : events_list_count(&data.tournaments);
+
+                VirtualList *list = &data.eventsList;
+                VirtualList_Begin(list, CLAY_ID("EventListRows"), numRows, 0, 0);
+                VirtualList_Spacer(list, CLAY_ID("EventRowsAbove"), true);
+
                 u32 idx = (data.tournaments.events)->nxt;
-                while (idx != idx_tail)
+                for (u32 row = 0; row < numRows && row < list->end; row++, idx = data.tournaments.events[idx].nxt)
                 {
+                    if (view) idx = view->entries[range.first + row].idx;
+                    if (!VirtualList_Declare(list, row, CLAY_IDI("EventRow", idx))) continue;
+
                     Event *tournament = data.tournaments.events + idx;
 
                     CLAY(CLAY_IDI("EventRow", idx), {
@@ -3867,7 +4674,7 @@ RenderEventsList(void)
                         }) {
                             s32 positions[64];
                             u32 count = find_all_filled_slots(tournament->registrations, positions);
-                            CLAY_TEXT(str8_to_clay(str8_from_u32(data.frameArena, count)), CLAY_TEXT_CONFIG({
+                            CLAY_TEXT(LabelCache_Number(count), CLAY_TEXT_CONFIG({
                                 .fontId = FONT_ID_PRESS_START_2P,
                                 .fontSize = 24,
                                 .textColor = dashAccentTeal
@@ -3876,9 +4683,9 @@ RenderEventsList(void)
 
                         RenderEventsActions(idx);
                     }
-
-                    idx = tournament->nxt;
                 }
+
+                VirtualList_Spacer(list, CLAY_ID("EventRowsBelow"), false);
             }
         }
     }
@@ -4070,6 +4877,17 @@ RenderPlayersHeader(void)
                     .textColor = COLOR_WHITE
                 }));
             }
+
+            // Search box, pushed to the right edge
+            CLAY_AUTO_ID({ .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } } }) {}
+
+            if (data.focusedTextbox == TEXTBOX_PlayerSearch)
+            {
+                TextInput_ProcessKeyboard(&data.textInputs[TEXTBOX_PlayerSearch]);
+            }
+
+            TextInput_Render(TEXTBOX_PlayerSearch, CLAY_STRING("PlayerSearchInput"),
+                CLAY_STRING("PlayerSearchInputScroll"), CLAY_STRING("Search players..."));
         }
     }
 }
@@ -4116,22 +4934,14 @@ RenderPlayersList(void)
                         .sizing = { .width = CLAY_SIZING_GROW(0) }
                     }
                 }) {
-                    CLAY_TEXT(CLAY_STRING("PLAYER NAME"), CLAY_TEXT_CONFIG({
-                        .fontId = FONT_ID_BODY_16,
-                        .fontSize = 12,
-                        .textColor = dashLabelText
-                    }));
+                    RenderListOrderHeader(CLAY_STRING("PLAYER NAME"), &data.playersOrder, LIST_ORDER_NAME);
                 }
                 CLAY(CLAY_ID("PlayerRegistrationsHeader"), {
                     .layout = {
                         .sizing = { .width = CLAY_SIZING_FIXED(150) }
                     }
                 }) {
-                    CLAY_TEXT(CLAY_STRING("REGISTRATIONS"), CLAY_TEXT_CONFIG({
-                        .fontId = FONT_ID_BODY_16,
-                        .fontSize = 12,
-                        .textColor = dashLabelText
-                    }));
+                    RenderListOrderHeader(CLAY_STRING("REGISTRATIONS"), &data.playersOrder, LIST_ORDER_REGISTRATIONS);
                 }
                 CLAY(CLAY_ID("PlayerActionsHeader"), {
                     .layout = {
@@ -4153,11 +4963,35 @@ RenderPlayersList(void)
                 },
                 .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
             }) {
-                // Player rows
-                u32 idx_tail = data.players.len - 1;
+                // Player rows, only the visible ones are declared
+                // Rows come from a sorted view, or from the linked list when
+                // none applies. While searching only the matches are listed,
+                // in name order, straight from the name view range
+                TextInput *search = &data.textInputs[TEXTBOX_PlayerSearch];
+                SortedView *view = NULL;
+                SortedRange range = {0};
+                if (search->len > 0)
+                {
+                    view = data.players.by_name;
+                    range = sorted_view_prefix(view, str8((u8 *)search->buffer, search->len));
+                }
+                else if (data.playersOrder != LIST_ORDER_RECENT)
+                {
+                    view = (data.playersOrder == LIST_ORDER_NAME) ? data.players.by_name : data.players.by_registrations;
+                    range.count = view->count;
+                }
+                u32 numRows = view ? range.count : players_list_count(&data.players);
+
+                VirtualList *list = &data.playersList;
+                VirtualList_Begin(list, CLAY_ID("PlayerListRows"), numRows, 0, 0);
+                VirtualList_Spacer(list, CLAY_ID("PlayerRowsAbove"), true);
+
                 u32 idx = (data.players.players)->nxt;
-                while (idx != idx_tail)
+                for (u32 row = 0; row < numRows && row < list->end; row++, idx = data.players.players[idx].nxt)
                 {
+                    if (view) idx = view->entries[range.first + row].idx;
+                    if (!VirtualList_Declare(list, row, CLAY_IDI("PlayerRow", idx))) continue;
+
                     Player *player = data.players.players + idx;
 
                     CLAY(CLAY_IDI("PlayerRow", idx), {
@@ -4192,7 +5026,7 @@ RenderPlayersList(void)
                         }) {
                             s32 positions[64];
                             u32 count = find_all_filled_slots(player->registrations, positions);
-                            CLAY_TEXT(str8_to_clay(str8_from_u32(data.frameArena, count)), CLAY_TEXT_CONFIG({
+                            CLAY_TEXT(LabelCache_Number(count), CLAY_TEXT_CONFIG({
                                 .fontId = FONT_ID_PRESS_START_2P,
                                 .fontSize = 24,
                                 .textColor = dashAccentTeal
@@ -4201,9 +5035,9 @@ RenderPlayersList(void)
 
                         RenderPlayersActions(idx);
                     }
-
-                    idx = player->nxt;
                 }
+
+                VirtualList_Spacer(list, CLAY_ID("PlayerRowsBelow"), false);
             }
         }
     }
@@ -4257,11 +5091,30 @@ RenderPlayerStatCard(u32 idx, Clay_String label, Clay_String value, Clay_Color a
     }
 }
 
+/**
+ * Name of a knockout round, from tournament_round_of_slot.
+ */
+Clay_String
+RoundLabel(u32 round)
+{
+    switch (round)
+    {
+        case 0:  return CLAY_STRING("Vincitore");
+        case 1:  return CLAY_STRING("Finale");
+        case 2:  return CLAY_STRING("Semifinale");
+        case 3:  return CLAY_STRING("Quarti di finale");
+        case 4:  return CLAY_STRING("Ottavi di finale");
+        case 5:  return CLAY_STRING("Sedicesimi di finale");
+        default: return CLAY_STRING("Trentaduesimi di finale");
+    }
+}
+
 // Event row for player detail page
 void
 RenderPlayerEventRow(u32 tournament_idx, u32 player_idx)
 {
     Event *tournament = data.tournaments.events + tournament_idx;
+    PlayerRecord *record = &tournament->records[player_idx];
 
     // Determine phase color and label
     Clay_Color statusColor;
@@ -4384,6 +5237,16 @@ RenderPlayerEventRow(u32 tournament_idx, u32 player_idx)
                     .fontSize = 11,
                     .textColor = dashLabelText
                 }));
+
+                // Round reached in the knockout
+                if (((tournament->recorded >> player_idx) & 1) && record->bracket_slot != RECORD_NO_SLOT)
+                {
+                    CLAY_TEXT(RoundLabel(tournament_round_of_slot(record->bracket_slot)), CLAY_TEXT_CONFIG({
+                        .fontId = FONT_ID_BODY_16,
+                        .fontSize = 11,
+                        .textColor = statusColor
+                    }));
+                }
             }
 
             // Right: Unregister button (only active during registration phase)
@@ -4685,13 +5548,17 @@ RenderPlayerDetail(u32 player_idx)
             }
         }) {
             // Registrations stat card
-            String8 reg_count_str = str8_from_u32(data.frameArena, registration_count);
-            RenderPlayerStatCard(0, CLAY_STRING("ISCRIZIONI"), str8_to_clay(reg_count_str), dashAccentTeal);
-
-            // Placeholder stat cards - in a full implementation these would show actual match stats
-            RenderPlayerStatCard(1, CLAY_STRING("VITTORIE"), CLAY_STRING("-"), dashAccentGold);
-            RenderPlayerStatCard(2, CLAY_STRING("SCONFITTE"), CLAY_STRING("-"), dashAccentCoral);
-            RenderPlayerStatCard(3, CLAY_STRING("PUNTI"), CLAY_STRING("-"), dashAccentPurple);
+            Clay_String reg_count_str = LabelCache_Number(registration_count);
+            RenderPlayerStatCard(0, CLAY_STRING("ISCRIZIONI"), reg_count_str, dashAccentTeal);
+
+            // Match stats, kept up to date by the results functions
+            PlayerStats *stats = &player->stats;
+            RenderPlayerStatCard(1, CLAY_STRING("PARTITE"), LabelCache_Number(stats->played), dashAccentOrange);
+            RenderPlayerStatCard(2, CLAY_STRING("VITTORIE"), LabelCache_Number(stats->wins), dashAccentGold);
+            RenderPlayerStatCard(3, CLAY_STRING("PAREGGI"), LabelCache_Number(stats->draws), dashLabelText);
+            RenderPlayerStatCard(4, CLAY_STRING("SCONFITTE"), LabelCache_Number(stats->losses), dashAccentCoral);
+            RenderPlayerStatCard(5, CLAY_STRING("GOL"), LabelCache_Number(stats->goals_for), dashAccentPurple);
+            RenderPlayerStatCard(6, CLAY_STRING("CONCLUSI"), LabelCache_Number(stats->events_finished), dashAccentGold);
         }
 
         // Two-column layout
@@ -4758,11 +5625,18 @@ RenderPlayerDetail(u32 player_idx)
                     }
                     else
                     {
-                        for (u32 i = 0; i < registration_count; i++)
+                        VirtualList *list = &data.playerEventsList;
+                        VirtualList_Begin(list, CLAY_ID("PlayerEventsList"), registration_count, 8, 12);
+                        VirtualList_Spacer(list, CLAY_ID("PlayerEventsAbove"), true);
+
+                        for (u32 i = list->first; i < list->end; i++)
                         {
-                            u32 tournament_idx = registered_tournaments[i];
+                            u32 tournament_idx = (u32)registered_tournaments[i];
+                            VirtualList_Declare(list, i, CLAY_IDI("PD_EnrolledOuter", tournament_idx));
                             RenderPlayerEventRow(tournament_idx, player_idx);
                         }
+
+                        VirtualList_Spacer(list, CLAY_ID("PlayerEventsBelow"), false);
                     }
                 }
 
@@ -4797,23 +5671,30 @@ RenderPlayerDetail(u32 player_idx)
                     .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
                 }) {
                     // Iterate through all events and show ones player is NOT enrolled in
+                    u32 available_count = events_list_count(&data.tournaments) - registration_count;
+
+                    VirtualList *list = &data.availableEventsList;
+                    VirtualList_Begin(list, CLAY_ID("AvailableEventsList"), available_count, 8, 12);
+                    VirtualList_Spacer(list, CLAY_ID("AvailableEventsAbove"), true);
+
                     u32 idx_tail = data.tournaments.len - 1;
                     u32 idx = data.tournaments.events->nxt;
-                    u32 available_count = 0;
-
-                    while (idx != idx_tail)
+                    for (u32 row = 0; idx != idx_tail && row < list->end; idx = data.tournaments.events[idx].nxt)
                     {
-                        Event *tournament = data.tournaments.events + idx;
                         // Check if player is NOT registered to this tournament
                         bool is_registered = (player->registrations >> idx) & 1;
                         if (!is_registered)
                         {
-                            RenderAvailableEventRow(idx, player_idx);
-                            available_count++;
+                            if (VirtualList_Declare(list, row, CLAY_IDI("PD_AvailOuter", idx)))
+                            {
+                                RenderAvailableEventRow(idx, player_idx);
+                            }
+                            row++;
                         }
-                        idx = tournament->nxt;
                     }
 
+                    VirtualList_Spacer(list, CLAY_ID("AvailableEventsBelow"), false);
+
                     if (available_count == 0)
                     {
                         CLAY(CLAY_ID("NoAvailableEventsMessage"), {
@@ -4918,21 +5799,442 @@ RenderPlayers(void)
     }
 }
 
+void
+RenderResultsBanner(void)
+{
+    CLAY(CLAY_ID("ResultsBanner"), {
+        .layout = {
+            .layoutDirection = CLAY_LEFT_TO_RIGHT,
+            .sizing = {.height = CLAY_SIZING_FIT(0), .width = CLAY_SIZING_GROW(0)},
+            .padding = { 24, 24, 20, 20 },
+            .childAlignment = { .x = CLAY_ALIGN_X_CENTER, .y = CLAY_ALIGN_Y_CENTER }
+        },
+        .backgroundColor = dashAccentOrange,
+        .cornerRadius = CLAY_CORNER_RADIUS(16)
+    }) {
+        CLAY_TEXT(CLAY_STRING("MEDAGLIERE"), CLAY_TEXT_CONFIG({
+            .fontId = FONT_ID_PRESS_START_2P,
+            .fontSize = 36,
+            .textColor = COLOR_WHITE
+        }));
+    }
+}
+
+/**
+ * Fixed width cell of the medal table.
+ */
+void
+RenderMedalCell(Clay_ElementId id, Clay_String text, u16 fontId, u16 fontSize, Clay_Color color)
+{
+    CLAY(id, {
+        .layout = {
+            .sizing = { .width = CLAY_SIZING_FIXED(120) },
+            .childAlignment = { .x = CLAY_ALIGN_X_CENTER, .y = CLAY_ALIGN_Y_CENTER }
+        }
+    }) {
+        CLAY_TEXT(text, CLAY_TEXT_CONFIG({
+            .fontId = fontId,
+            .fontSize = fontSize,
+            .textColor = color
+        }));
+    }
+}
+
 void
 RenderResults(void)
 {
+    Clay_Color silverColor = { 140, 140, 140, 255 };
+    Clay_Color bronzeColor = { 180, 110, 45, 255 };
+
     CLAY(CLAY_ID("Results"), {
         .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
             .sizing = layoutExpand,
-            .padding = { 16, 16, 0, 0 },
-            .childGap = 16,
-            .childAlignment = {
-                .y = CLAY_ALIGN_Y_CENTER
+            .childGap = 20,
+            .padding = { 8, 8, 8, 8 }
+        },
+        .backgroundColor = dashBgGradientTop
+    }) {
+        RenderResultsBanner();
+
+        CLAY(CLAY_ID("MedalTableOuter"), {
+            .layout = {
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .sizing = layoutExpand
+            },
+            .cornerRadius = CLAY_CORNER_RADIUS(12)
+        }) {
+            CLAY(CLAY_ID("MedalTableAccent"), {
+                .layout = {
+                    .sizing = {.height = CLAY_SIZING_FIXED(6), .width = CLAY_SIZING_GROW(0)}
+                },
+                .backgroundColor = dashAccentGold,
+                .cornerRadius = { 12, 12, 0, 0 }
+            }) {}
+            CLAY(CLAY_ID("MedalTable"), {
+                .layout = {
+                    .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                    .sizing = layoutExpand,
+                    .childGap = 2,
+                },
+                .backgroundColor = dashCardBg,
+                .cornerRadius = { 0, 0, 12, 12 },
+            }) {
+                // Table header
+                CLAY(CLAY_ID("MedalTableHeader"), {
+                    .layout = {
+                        .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                        .sizing = {.height = CLAY_SIZING_FIT(0), .width = CLAY_SIZING_GROW(0)},
+                        .padding = { 20, 20, 12, 12 }
+                    },
+                    .backgroundColor = dashCardBg
+                }) {
+                    RenderMedalCell(CLAY_ID("MedalRankHeader"), CLAY_STRING("#"), FONT_ID_BODY_16, 12, dashLabelText);
+                    CLAY(CLAY_ID("MedalPlayerHeader"), {
+                        .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } }
+                    }) {
+                        CLAY_TEXT(CLAY_STRING("PLAYER NAME"), CLAY_TEXT_CONFIG({
+                            .fontId = FONT_ID_BODY_16,
+                            .fontSize = 12,
+                            .textColor = dashLabelText
+                        }));
+                    }
+                    RenderMedalCell(CLAY_ID("MedalGoldHeader"), CLAY_STRING("ORO"), FONT_ID_BODY_16, 12, dashAccentGold);
+                    RenderMedalCell(CLAY_ID("MedalSilverHeader"), CLAY_STRING("ARGENTO"), FONT_ID_BODY_16, 12, silverColor);
+                    RenderMedalCell(CLAY_ID("MedalBronzeHeader"), CLAY_STRING("BRONZO"), FONT_ID_BODY_16, 12, bronzeColor);
+                }
+
+                CLAY(CLAY_ID("MedalTableRows"), {
+                    .layout = {
+                        .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                        .sizing = layoutExpand
+                    },
+                    .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
+                }) {
+                    // Medalists lead the medal view, the rows are read straight from it
+                    SortedView *table = data.players.by_medals;
+                    u32 numRows = sorted_view_count_keyed(table);
+
+                    VirtualList *list = &data.resultsList;
+                    VirtualList_Begin(list, CLAY_ID("MedalTableRows"), numRows, 0, 0);
+                    VirtualList_Spacer(list, CLAY_ID("MedalRowsAbove"), true);
+
+                    for (u32 row = list->first; row < numRows && row < list->end; row++)
+                    {
+                        SortedViewEntry *entry = table->entries + row;
+                        if (!VirtualList_Declare(list, row, CLAY_IDI("MedalRow", entry->idx))) continue;
+
+                        // Tied players share the rank of the first of them
+                        u32 rank = row;
+                        while (rank > 0 && table->entries[rank - 1].key == entry->key)
+                        {
+                            rank--;
+                        }
+
+                        MedalCount medals = data.players.players[entry->idx].medals;
+
+                        CLAY(CLAY_IDI("MedalRow", entry->idx), {
+                            .layout = {
+                                .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                                .sizing = {.height = CLAY_SIZING_FIT(0), .width = CLAY_SIZING_GROW(0)},
+                                .childAlignment = { .y = CLAY_ALIGN_Y_CENTER },
+                                .padding = { 20, 20, 12, 12 }
+                            },
+                            .backgroundColor = Clay_Hovered() ? dashBgGradientTop : dashCardBg
+                        }) {
+                            RenderMedalCell(CLAY_IDI("MedalRank", entry->idx), LabelCache_Number(rank + 1),
+                                FONT_ID_PRESS_START_2P, 16, dashLabelText);
+                            CLAY(CLAY_IDI("MedalPlayer", entry->idx), {
+                                .layout = {
+                                    .sizing = { .width = CLAY_SIZING_GROW(0) },
+                                    .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+                                }
+                            }) {
+                                CLAY_TEXT(str8_to_clay(entry->name), CLAY_TEXT_CONFIG({
+                                    .fontId = FONT_ID_BODY_16,
+                                    .fontSize = 18,
+                                    .textColor = dashAccentPurple
+                                }));
+                            }
+                            RenderMedalCell(CLAY_IDI("MedalGold", entry->idx), LabelCache_Number(medals.gold),
+                                FONT_ID_PRESS_START_2P, 24, dashAccentGold);
+                            RenderMedalCell(CLAY_IDI("MedalSilver", entry->idx), LabelCache_Number(medals.silver),
+                                FONT_ID_PRESS_START_2P, 24, silverColor);
+                            RenderMedalCell(CLAY_IDI("MedalBronze", entry->idx), LabelCache_Number(medals.bronze),
+                                FONT_ID_PRESS_START_2P, 24, bronzeColor);
+                        }
+                    }
+
+                    VirtualList_Spacer(list, CLAY_ID("MedalRowsBelow"), false);
+                }
             }
+        }
+    }
+}
+
+void
+RenderScheduleBanner(void)
+{
+    CLAY(CLAY_ID("ScheduleBanner"), {
+        .layout = {
+            .layoutDirection = CLAY_LEFT_TO_RIGHT,
+            .sizing = {.height = CLAY_SIZING_FIT(0), .width = CLAY_SIZING_GROW(0)},
+            .padding = { 24, 24, 20, 20 },
+            .childAlignment = { .x = CLAY_ALIGN_X_CENTER, .y = CLAY_ALIGN_Y_CENTER }
+        },
+        .backgroundColor = dashAccentGold,
+        .cornerRadius = CLAY_CORNER_RADIUS(16)
+    }) {
+        CLAY_TEXT(CLAY_STRING("CALENDARIO"), CLAY_TEXT_CONFIG({
+            .fontId = FONT_ID_PRESS_START_2P,
+            .fontSize = 36,
+            .textColor = COLOR_WHITE
+        }));
+    }
+}
+
+/**
+ * Card with a venue setting and its -/+ buttons.
+ */
+void
+RenderScheduleStepper(Clay_String label, ScheduleSetting setting, u32 value)
+{
+    CLAY(CLAY_IDI("ScheduleSettingOuter", setting), {
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)}
         },
-        .backgroundColor = COLOR_BLACK
+        .cornerRadius = CLAY_CORNER_RADIUS(8)
     }) {
+        CLAY(CLAY_IDI("ScheduleSettingAccent", setting), {
+            .layout = {
+                .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(4)}
+            },
+            .backgroundColor = dashAccentGold,
+            .cornerRadius = { 8, 8, 0, 0 }
+        }) {}
+        CLAY(CLAY_IDI("ScheduleSettingCard", setting), {
+            .layout = {
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+                .padding = { 8, 8, 6, 8 },
+                .childGap = 4,
+                .childAlignment = { .x = CLAY_ALIGN_X_CENTER }
+            },
+            .backgroundColor = dashCardBg,
+            .cornerRadius = { 0, 0, 8, 8 }
+        }) {
+            CLAY_TEXT(label, CLAY_TEXT_CONFIG({
+                .fontId = FONT_ID_BODY_16,
+                .fontSize = 10,
+                .textColor = dashLabelText
+            }));
+            CLAY(CLAY_IDI("ScheduleSettingControls", setting), {
+                .layout = {
+                    .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                    .sizing = {.width = CLAY_SIZING_FIT(0), .height = CLAY_SIZING_FIT(0)},
+                    .childGap = 8,
+                    .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+                }
+            }) {
+                for (u32 i = 0; i < 2; i++)
+                {
+                    ScheduleStep *step = push_array(data.frameArena, ScheduleStep, 1);
+                    step->setting = setting;
+                    step->delta = i == 0 ? -1 : 1;
+
+                    if (i == 1)
+                    {
+                        CLAY_TEXT(LabelCache_Number(value), CLAY_TEXT_CONFIG({
+                            .fontId = FONT_ID_PRESS_START_2P,
+                            .fontSize = 20,
+                            .textColor = dashAccentGold
+                        }));
+                    }
 
+                    CLAY(CLAY_IDI("ScheduleSettingStep", setting * 2 + i), {
+                        .layout = {
+                            .sizing = {.width = CLAY_SIZING_FIXED(24), .height = CLAY_SIZING_FIXED(24)},
+                            .childAlignment = { .x = CLAY_ALIGN_X_CENTER, .y = CLAY_ALIGN_Y_CENTER }
+                        },
+                        .backgroundColor = Clay_Hovered() ? dashAccentPurple : dashAccentGold,
+                        .cornerRadius = CLAY_CORNER_RADIUS(12)
+                    }) {
+                        Clay_OnHover(HandleScheduleStep, step);
+                        CLAY_TEXT(i == 0 ? CLAY_STRING("-") : CLAY_STRING("+"), CLAY_TEXT_CONFIG({
+                            .fontId = FONT_ID_BODY_16,
+                            .fontSize = 16,
+                            .textColor = COLOR_WHITE
+                        }));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * A placed match: court, event and the two players.
+ */
+void
+RenderScheduledMatch(u32 slot, u32 court, ScheduledMatch *match)
+{
+    u32 id = slot * SCHEDULE_MAX_COURTS + court;
+    Event *event = data.tournaments.events + match->event_idx;
+
+    CLAY(CLAY_IDI("ScheduledMatch", id), {
+        .layout = {
+            .layoutDirection = CLAY_LEFT_TO_RIGHT,
+            .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+            .padding = { 12, 12, 6, 6 },
+            .childGap = 16,
+            .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+        },
+        .backgroundColor = Clay_Hovered() ? dashBgGradientTop : dashCardBg
+    }) {
+        CLAY(CLAY_IDI("ScheduledMatchCourt", id), {
+            .layout = { .sizing = { .width = CLAY_SIZING_FIXED(110) } }
+        }) {
+            CLAY_TEXT(CLAY_STRING("CAMPO "), CLAY_TEXT_CONFIG({
+                .fontId = FONT_ID_BODY_16,
+                .fontSize = 12,
+                .textColor = dashLabelText
+            }));
+            CLAY_TEXT(LabelCache_Number(court + 1), CLAY_TEXT_CONFIG({
+                .fontId = FONT_ID_BODY_16,
+                .fontSize = 12,
+                .textColor = dashLabelText
+            }));
+        }
+        CLAY(CLAY_IDI("ScheduledMatchEvent", id), {
+            .layout = { .sizing = { .width = CLAY_SIZING_PERCENT(0.3f) } }
+        }) {
+            CLAY_TEXT(LabelCache_Name(event->name), CLAY_TEXT_CONFIG({
+                .fontId = FONT_ID_BODY_16,
+                .fontSize = 16,
+                .textColor = dashAccentOrange
+            }));
+        }
+        CLAY_TEXT(LabelCache_Name(data.players.players[match->players[0]].name), CLAY_TEXT_CONFIG({
+            .fontId = FONT_ID_BODY_16,
+            .fontSize = 16,
+            .textColor = dashAccentPurple
+        }));
+        CLAY_TEXT(CLAY_STRING("-"), CLAY_TEXT_CONFIG({
+            .fontId = FONT_ID_BODY_16,
+            .fontSize = 16,
+            .textColor = dashLabelText
+        }));
+        CLAY_TEXT(LabelCache_Name(data.players.players[match->players[1]].name), CLAY_TEXT_CONFIG({
+            .fontId = FONT_ID_BODY_16,
+            .fontSize = 16,
+            .textColor = dashAccentPurple
+        }));
+    }
+}
+
+void
+RenderSchedule(void)
+{
+    CLAY(CLAY_ID("Schedule"), {
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = layoutExpand,
+            .childGap = 20,
+            .padding = { 8, 8, 8, 8 }
+        },
+        .backgroundColor = dashBgGradientTop
+    }) {
+        RenderScheduleBanner();
+
+        CLAY(CLAY_ID("ScheduleSettings"), {
+            .layout = {
+                .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+                .childGap = 8
+            }
+        }) {
+            RenderScheduleStepper(CLAY_STRING("TURNI"), SCHEDULE_SETTING_SLOTS, schedule.num_slots);
+            RenderScheduleStepper(CLAY_STRING("CAMPI"), SCHEDULE_SETTING_COURTS, schedule.num_courts);
+            RenderScheduleStepper(CLAY_STRING("TURNO ATTUALE"), SCHEDULE_SETTING_FIRST_SLOT, schedule.first_slot + 1);
+        }
+
+        if (schedule.num_unscheduled > 0)
+        {
+            CLAY(CLAY_ID("ScheduleUnscheduled"), {
+                .layout = {
+                    .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                    .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+                    .childGap = 8,
+                    .childAlignment = { .x = CLAY_ALIGN_X_CENTER }
+                }
+            }) {
+                CLAY_TEXT(CLAY_STRING("Partite senza turno:"), CLAY_TEXT_CONFIG({
+                    .fontId = FONT_ID_BODY_16,
+                    .fontSize = 14,
+                    .textColor = dashAccentCoral
+                }));
+                CLAY_TEXT(LabelCache_Number(schedule.num_unscheduled), CLAY_TEXT_CONFIG({
+                    .fontId = FONT_ID_BODY_16,
+                    .fontSize = 14,
+                    .textColor = dashAccentCoral
+                }));
+            }
+        }
+
+        CLAY(CLAY_ID("ScheduleSlots"), {
+            .layout = {
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .sizing = layoutExpand,
+                .childGap = 12
+            },
+            .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
+        }) {
+            // The slots to come that have matches, a card each
+            for (u32 slot = schedule.first_slot; slot < schedule.num_slots; slot++)
+            {
+                if (schedule.taken_courts[slot] == 0) continue;
+
+                CLAY(CLAY_IDI("ScheduleSlot", slot), {
+                    .layout = {
+                        .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                        .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+                        .childGap = 2
+                    },
+                    .backgroundColor = dashCardBg,
+                    .cornerRadius = CLAY_CORNER_RADIUS(12)
+                }) {
+                    CLAY(CLAY_IDI("ScheduleSlotHeader", slot), {
+                        .layout = {
+                            .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                            .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0)},
+                            .padding = { 12, 12, 8, 8 },
+                            .childGap = 8
+                        },
+                        .backgroundColor = dashAccentGold,
+                        .cornerRadius = { 12, 12, 0, 0 }
+                    }) {
+                        CLAY_TEXT(CLAY_STRING("TURNO"), CLAY_TEXT_CONFIG({
+                            .fontId = FONT_ID_PRESS_START_2P,
+                            .fontSize = 14,
+                            .textColor = COLOR_WHITE
+                        }));
+                        CLAY_TEXT(LabelCache_Number(slot + 1), CLAY_TEXT_CONFIG({
+                            .fontId = FONT_ID_PRESS_START_2P,
+                            .fontSize = 14,
+                            .textColor = COLOR_WHITE
+                        }));
+                    }
+
+                    for (u32 court = 0; court < schedule.num_courts; court++)
+                    {
+                        u16 match_idx = schedule.grid[slot][court];
+                        if (match_idx == 0) continue;
+                        RenderScheduledMatch(slot, court, schedule.matches + match_idx - 1);
+                    }
+                }
+            }
+        }
     }
 }
 
@@ -5393,9 +6695,7 @@ RenderRegisterScoreModal(void)
             }
 
             // Match info badge (Group X)
-            String8 group_prefix = str8_lit("GROUP ");
-            String8 group_num = str8_from_u32(data.frameArena, data.scoreModalGroupIdx + 1);
-            String8 group_label = str8_cat(data.frameArena, group_prefix, group_num);
+            Clay_String group_label = LabelCache_Group(data.scoreModalGroupIdx + 1);
             CLAY(CLAY_ID("ScoreGroupBadge"), {
                 .layout = {
                     .sizing = {.width = CLAY_SIZING_FIT(0), .height = CLAY_SIZING_FIT(0)},
@@ -5405,7 +6705,7 @@ RenderRegisterScoreModal(void)
                 .backgroundColor = dashAccentPurple,
                 .cornerRadius = CLAY_CORNER_RADIUS(6)
             }) {
-                CLAY_TEXT(str8_to_clay(group_label), CLAY_TEXT_CONFIG({
+                CLAY_TEXT(group_label, CLAY_TEXT_CONFIG({
                     .fontId = FONT_ID_PRESS_START_2P,
                     .fontSize = 12,
                     .textColor = COLOR_WHITE
@@ -5440,7 +6740,7 @@ RenderRegisterScoreModal(void)
                         .backgroundColor = dashAccentOrange,
                         .cornerRadius = CLAY_CORNER_RADIUS(6)
                     }) {
-                        CLAY_TEXT(str8_to_clay_truncated(data.frameArena, row_player->name, MAX_DISPLAY_NAME_LEN), CLAY_TEXT_CONFIG({
+                        CLAY_TEXT(LabelCache_Name(row_player->name), CLAY_TEXT_CONFIG({
                             .fontId = FONT_ID_BODY_16,
                             .fontSize = 14,
                             .textColor = COLOR_WHITE
@@ -5485,7 +6785,7 @@ RenderRegisterScoreModal(void)
                         .backgroundColor = dashAccentCoral,
                         .cornerRadius = CLAY_CORNER_RADIUS(6)
                     }) {
-                        CLAY_TEXT(str8_to_clay_truncated(data.frameArena, col_player->name, MAX_DISPLAY_NAME_LEN), CLAY_TEXT_CONFIG({
+                        CLAY_TEXT(LabelCache_Name(col_player->name), CLAY_TEXT_CONFIG({
                             .fontId = FONT_ID_BODY_16,
                             .fontSize = 14,
                             .textColor = COLOR_WHITE
@@ -5546,10 +6846,112 @@ RenderRegisterScoreModal(void)
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Layout cache
+//
+// Clay rebuilds the whole tree every frame and cannot rebuild a subtree, so the
+// cache works at frame granularity: when nothing in LayoutCacheKey changed the
+// previous render commands are drawn again. They stay valid because neither
+// Clay's arena nor frameArena are reset until the next CreateLayout.
+//
+// Handlers mutate the model in the middle of CreateLayout, so the elements
+// declared before the mutation show the old state. A key is only trusted after
+// two frames in a row were built with it, the second one from the updated model.
+
+#define LAYOUT_CACHE_STABLE_FRAMES 2
+
+internal LayoutCacheKey
+LayoutCacheKeyCurrent(void)
+{
+    // Compared byte for byte, the padding must be zero too
+    LayoutCacheKey key;
+    MemoryZeroStruct(&key);
+    key.screenWidth  = GetScreenWidth();
+    key.screenHeight = GetScreenHeight();
+    key.mousePosition = input_mouse_position();
+
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; button++)
+    {
+        key.mouseButtonsDown |= (u32)input_mouse_down(button) << button;
+    }
+
+    key.anyKeyDown = input_any_key_down();
+
+    key.page = data.selectedHeaderButton;
+    key.focusedTextbox = data.focusedTextbox;
+    key.chartZoomLevel = data.chartZoomLevel;
+    key.groupMatrixZoomLevel = data.groupMatrixZoomLevel;
+    key.yOffset = data.yOffset;
+
+    key.historyVersion = history.version;
+    key.scheduleVersion = schedule.version;
+    key.snapshotNextVersion = snapshot_store.next_version;
+    key.snapshotSelectedVersion = snapshot_store.current[data.selectedTournamentIdx];
+
+    return key;
+}
+
+/**
+ * Whether a scroll container is still moving on its own (drag momentum).
+ */
+bool
+LayoutScrollAnimating(void)
+{
+    Clay_Context *context = Clay_GetCurrentContext();
+    for (int32_t i = 0; i < context->scrollContainerDatas.length; i++)
+    {
+        Clay__ScrollContainerDataInternal *scroll = context->scrollContainerDatas.internalArray + i;
+        if (scroll->pointerScrollActive || scroll->scrollMomentum.x != 0 || scroll->scrollMomentum.y != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Check whether last frame's render commands can be drawn again, and advance
+ * the cache state for this frame.
+ *
+ * On a hit the caller must skip the Clay pointer/scroll updates as well as
+ * CreateLayout: Clay drops the scroll state of containers not declared since
+ * the last Clay_UpdateScrollContainers.
+ */
+bool
+LayoutCacheReusable(void)
+{
+    LayoutCacheKey key = LayoutCacheKeyCurrent();
+
+    // Events are handled in CreateLayout (typing, key repeats, the wheel in
+    // Clay_UpdateScrollContainers), the same state twice may carry new ones
+    bool same = MemoryMatchStruct(&key, &data.layoutCacheKey) && !key.mouseButtonsDown &&
+                !input_has_events() && !LayoutScrollAnimating();
+    data.layoutCacheKey = key;
+
+    if (!same)
+    {
+        data.layoutCacheStableFrames = 1;
+        return false;
+    }
+    if (data.layoutCacheStableFrames < LAYOUT_CACHE_STABLE_FRAMES)
+    {
+        data.layoutCacheStableFrames++;
+        return false;
+    }
+
+    // The cursor blinks while the rest of the screen is cached
+    if (data.focusedTextbox != TEXTBOX_NULL)
+    {
+        TextInput_UpdateBlink(&data.textInputs[data.focusedTextbox], input_frame_time());
+    }
+    return true;
+}
+
 Clay_RenderCommandArray
 CreateLayout(void)
 {
     data.frameArena->pos = ARENA_HEADER_SIZE;
+    data.frameIndex++;
 
     Clay_BeginLayout();
 
@@ -5584,6 +6986,7 @@ CreateLayout(void)
             RenderHeaderButton(CLAY_STRING("Events"),    PAGE_Events);
             RenderHeaderButton(CLAY_STRING("Players"),   PAGE_Players);
             RenderHeaderButton(CLAY_STRING("Results"),   PAGE_Results);
+            RenderHeaderButton(CLAY_STRING("Schedule"),  PAGE_Schedule);
         };
         switch (data.selectedHeaderButton)
         {
@@ -5599,6 +7002,9 @@ CreateLayout(void)
             case PAGE_Results:
                 RenderResults();
                 break;
+            case PAGE_Schedule:
+                RenderSchedule();
+                break;
         }
 
         // Render modal overlays (floating, rendered last so they appear on top)
@@ -5616,10 +7022,14 @@ CreateLayout(void)
         }
     }
 
+    ProfileBegin(ProfileZone_ClayEndLayout);
     Clay_RenderCommandArray renderCommands = Clay_EndLayout();
+    ProfileEnd(ProfileZone_ClayEndLayout);
 
     for (int32_t i = 0; i < renderCommands.length; i++) {
         Clay_RenderCommandArray_Get(&renderCommands, i)->boundingBox.y += data.yOffset;
     }
+
+    data.layoutCommands = renderCommands;
     return renderCommands;
 }
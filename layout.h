@@ -4,6 +4,7 @@
 #include "clay.h"
 #include "arena.h"
 #include "players.h"
+#include "schedule.h"
 #include "string.h"
 #include "raylib/raylib.h"
 
@@ -23,9 +24,40 @@ typedef enum Page
     PAGE_Events    = 1,
     PAGE_Players   = 2,
     PAGE_Results   = 3,
+    PAGE_Schedule  = 4,
 }
 Page;
 
+// Venue settings of the Schedule page, changed by its steppers
+typedef enum ScheduleSetting
+{
+    SCHEDULE_SETTING_SLOTS = 0,
+    SCHEDULE_SETTING_COURTS,
+    SCHEDULE_SETTING_FIRST_SLOT,
+}
+ScheduleSetting;
+
+typedef struct ScheduleStep ScheduleStep;
+struct ScheduleStep {
+    ScheduleSetting setting;
+    s32 delta;
+};
+
+// Row order of the Events and Players page lists
+typedef enum ListOrder
+{
+    LIST_ORDER_RECENT = 0,      // Linked list order, most recently added first
+    LIST_ORDER_NAME,
+    LIST_ORDER_REGISTRATIONS,   // Most registrations first
+}
+ListOrder;
+
+typedef struct ListOrderChoice ListOrderChoice;
+struct ListOrderChoice {
+    ListOrder *order;
+    ListOrder value;
+};
+
 #define TEXTBOX_LIST                                                         \
     X(TEXTBOX_NULL,        "",                    "")                        \
     X(TEXTBOX_Events,      "EventNameInput",      "EventNameInputScroll")    \
@@ -33,7 +65,9 @@ Page;
     X(TEXTBOX_EventRename, "EventRenameInput",    "EventRenameInputScroll")  \
     X(TEXTBOX_PlayerRename,"PlayerRenameInput",   "PlayerRenameInputScroll") \
     X(TEXTBOX_Score1,      "Score1Input",         "Score1InputScroll")       \
-    X(TEXTBOX_Score2,      "Score2Input",         "Score2InputScroll")
+    X(TEXTBOX_Score2,      "Score2Input",         "Score2InputScroll")       \
+    X(TEXTBOX_EventSearch, "EventSearchInput",    "EventSearchInputScroll")  \
+    X(TEXTBOX_PlayerSearch,"PlayerSearchInput",   "PlayerSearchInputScroll")
 
 typedef enum TextBoxEnum
 {
@@ -78,6 +112,84 @@ static const char *TextBoxScrollIds[] = {
 };
 
 
+// Everything outside the model that can change what CreateLayout produces.
+// Handlers run inside CreateLayout, so all the input state they look at is
+// here too; input events never reuse the cached layout (input_has_events).
+typedef struct LayoutCacheKey LayoutCacheKey;
+struct LayoutCacheKey {
+    int screenWidth;
+    int screenHeight;
+    Vector2 mousePosition;
+    u32 mouseButtonsDown;
+    b32 anyKeyDown;
+
+    Page page;
+    TextBoxEnum focusedTextbox;
+    float chartZoomLevel;
+    float groupMatrixZoomLevel;
+    float yOffset;
+
+    // The model: undo and redo change it outside CreateLayout, with the keys
+    // that did it still held
+    u64 historyVersion;
+    u64 scheduleVersion;
+    u32 snapshotNextVersion;
+    u32 snapshotSelectedVersion;
+};
+
+// Windowed list: only the rows intersecting the visible part of a scroll
+// container are declared, spacers stand in for the others so the content
+// size (and the scrollbar range) stays the same. Rows are assumed to share
+// the height measured on the first declared row of the previous frame.
+typedef struct VirtualList VirtualList;
+struct VirtualList {
+    Clay_ElementId measureId;  // Row measured next frame
+    float rowHeight;           // 0 until a row was laid out once: everything is declared
+    float childGap;
+    u32 numRows;
+    u32 first;                 // First declared row
+    u32 end;                   // One past the last declared row
+};
+
+// Interned labels: strings built from persistent data (truncated names,
+// numbers, scores) are made once in the cache and handed to Clay as
+// statically allocated, so Clay keys its text measurements on the pointer
+// instead of rehashing the content, and repeated frames allocate nothing.
+// A name is never edited in place (a rename points the entity to a new
+// string), so its pointer identifies its content.
+//
+// Every entry holds its label in its own buffer, so the cache takes a fixed
+// amount of memory however many labels are evicted or forgotten. Clay keys a
+// static string by pointer and length: a buffer that held another label may
+// still be measured as that one, so its new labels are handed to Clay as
+// dynamic strings, keyed on the content. An entry used by the frame being
+// laid out is not evicted, its text is still to be drawn: when all the
+// candidates are, the label is made in the frame arena.
+#define LABEL_CACHE_SIZE   512  // Power of two
+#define LABEL_CACHE_PROBES 8
+#define LABEL_MAX_LEN      16   // "GROUP 4294967295", the longest label
+
+typedef struct LabelCacheEntry LabelCacheEntry;
+struct LabelCacheEntry {
+    u64 key;            // 0: empty
+    Clay_String label;  // chars: text, NULL until the entry is first used
+    u64 frame;          // Last layout that used it
+    char text[LABEL_MAX_LEN];
+};
+
+// Culling state of a zoomable canvas (group matrices, knockout chart).
+// Elements whose previous-frame box lies outside the viewport are replaced by
+// a placeholder of the same id and size. Previous-frame boxes are only trusted
+// when the canvas was laid out on that frame with the same content and zoom,
+// and the viewport has a margin for the scrolling since then.
+typedef struct CanvasCull CanvasCull;
+struct CanvasCull {
+    u64 contentHash;
+    u64 lastFrame;
+    bool enabled;               // Placeholders allowed this frame
+    Clay_BoundingBox viewport;  // Visible region: screen, clipped by the canvas scroll container
+};
+
 typedef struct LayoutData LayoutData;
 struct LayoutData {
     Arena *arena;      // Persistent arena for allocations
@@ -137,6 +249,34 @@ struct LayoutData {
     // Panel visibility for Group+Knockout tournaments
     bool groupsPanelVisible;
     bool knockoutPanelVisible;
+
+    // Latecomers picked to form a new group of an event in the group phase
+    u64 lateGroup;
+    u32 lateGroupEventIdx;
+
+    // Incremented by CreateLayout
+    u64 frameIndex;
+
+    // Interned labels
+    LabelCacheEntry labelCache[LABEL_CACHE_SIZE];
+
+    // Zoomable canvases
+    CanvasCull groupsCanvas;
+    CanvasCull knockoutCanvas;
+
+    // Windowed lists
+    VirtualList eventsList;
+    VirtualList playersList;
+    VirtualList playerEventsList;
+    VirtualList availableEventsList;
+    VirtualList resultsList;
+    ListOrder eventsOrder;
+    ListOrder playersOrder;
+
+    // Retained layout: last frame's render commands and the key they were built with
+    LayoutCacheKey layoutCacheKey;
+    u32 layoutCacheStableFrames;
+    Clay_RenderCommandArray layoutCommands;
 };
 
 typedef enum
@@ -195,7 +335,20 @@ extern Clay_Color COLOR_BLUE;
 // Utility Functions
 
 Clay_String str8_to_clay(String8 str);
-Clay_String str8_to_clay_truncated(Arena *arena, String8 str, u64 max_len);
+
+Clay_String LabelCache_Name(String8 name);
+Clay_String LabelCache_Number(u32 num);
+Clay_String LabelCache_Score(u16 row_score, u16 col_score);
+Clay_String LabelCache_Group(u32 group_number);
+void LabelCache_Forget(String8 name);
+Clay_String MedalTable_Name(u32 position);
+Clay_String RoundLabel(u32 round);
+void RenderResultsBanner(void);
+void RenderMedalCell(Clay_ElementId id, Clay_String text, u16 fontId, u16 fontSize, Clay_Color color);
+void RenderScheduleBanner(void);
+void RenderScheduleStepper(Clay_String label, ScheduleSetting setting, u32 value);
+void RenderScheduledMatch(u32 slot, u32 court, ScheduledMatch *match);
+void RenderListOrderHeader(Clay_String label, ListOrder *order, ListOrder value);
 void RenderDuplicateWarning(Clay_String parentId, Clay_String message, u32 uniqueId);
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -209,6 +362,7 @@ void HandleGoBackFromPlayer(Clay_ElementId elementId, Clay_PointerData pointerDa
 void HandlePlayerEventRowClick(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
 void HandleDeleteTournament(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
 void HandleDeletePlayer(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
+void HandleListOrder(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
 void HandleOuterContainerInteraction(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
 void HandleZoomableHover(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
 void HandleTextInput(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
@@ -224,6 +378,10 @@ void HandleCancelReturnToRegistration(Clay_ElementId elementId, Clay_PointerData
 void HandleConfirmReturnToGroupPhase(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
 void HandleCancelReturnToGroupPhase(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
 void HandleTerminateGroupPhase(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
+void HandleStepEventVersion(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
+void HandleScheduleStep(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
+void HandleToggleLateEntry(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
+void HandleFormLateGroup(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
 void HandleConfirmDeleteTournament(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
 void HandleCancelDeleteTournament(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
 void HandleConfirmDeletePlayer(Clay_ElementId elementId, Clay_PointerData pointerData, void *userData);
@@ -248,6 +406,7 @@ void HandleToggleKnockoutPanel(Clay_ElementId elementId, Clay_PointerData pointe
 ///////////////////////////////////////////////////////////////////////////////
 // TextBox Functions
 
+float TextInput_SecondsToBlink(TextInput *input);
 void TextInput_ProcessKeyboard(TextInput *input);
 void TextInput_Render(TextBoxEnum textBoxEnum, Clay_String elementId, Clay_String scrollId, Clay_String placeholder);
 void TextInput_RenderCursor(TextInput *input, Clay_BoundingBox inputBox, Clay_ScrollContainerData scrollData);
@@ -262,7 +421,9 @@ void RenderDashboard(void);
 void RenderGoBackButton(void);
 void RenderTournamentBanner(u32 tournament_idx);
 void RenderFormatOption(TournamentFormat format, TournamentFormat current_format, Clay_String name, Clay_String description, u32 id);
+void RenderVersionStepper(void);
 void RenderRegistrationPanel(u32 tournament_idx, Event *tournament, s32 *registered_positions, u32 registered_count);
+void RenderLateGroupPanel(Event *tournament);
 void RenderInProgressPanel(s32 *registered_positions, u32 registered_count);
 
 // Match / Bracket Rendering
@@ -270,7 +431,7 @@ void RenderMatchSlot(Clay_String player1_name, Clay_String player2_name, u8 play
 void RenderByeSlot(u32 match_id, float zoom);
 void RenderGroupPhaseHeader(void);
 void RenderKnockoutHeader(void);
-void RenderKnockoutChart(u8 *bracket, u32 num_players);
+void RenderKnockoutChart(u8 *bracket, u32 num_players, Event *tournament, Clay_ElementId clipId);
 void RenderGroupMatrix(Event *tournament, u32 group_idx, u32 players_in_group);
 void RenderGroupsKnockoutChart(Event *tournament);
 
@@ -300,9 +461,19 @@ void RenderPlayerBanner(u32 player_idx);
 void RenderPlayerDetail(u32 player_idx);
 void RenderAvailableEventRow(u32 tournament_idx, u32 player_idx);
 
+// Zoomable canvases
+void CanvasCull_Begin(CanvasCull *cull, Event *tournament, float zoom, Clay_ElementId clipId);
+bool CanvasCull_Skip(CanvasCull *cull, Clay_ElementId id);
+
+// Windowed lists
+void VirtualList_Begin(VirtualList *list, Clay_ElementId containerId, u32 numRows, float childGap, float paddingTop);
+bool VirtualList_Declare(VirtualList *list, u32 row, Clay_ElementId rowId);
+void VirtualList_Spacer(VirtualList *list, Clay_ElementId spacerId, bool top);
+
 // Main Pages
 void RenderPlayers(void);
 void RenderResults(void);
+void RenderSchedule(void);
 
 // Modal Overlays
 void RenderConfirmationModal(void);
@@ -311,5 +482,7 @@ void RenderRegisterScoreModal(void);
 
 // Main Layout Entry Point
 Clay_RenderCommandArray CreateLayout(void);
+bool LayoutScrollAnimating(void);
+bool LayoutCacheReusable(void);
 
 #endif // LAYOUT_H
@@ -1,10 +1,13 @@
 #include <assert.h>
+#include <stddef.h>
 #include <stdio.h>
 
 #include "arena.h"
 #include "core.h"
 #include "string.h"
 #include "players.h"
+#include "compress.h"
+#include "profiler.h"
 
 /**
  * Find all filled slots in a bitmap and store their positions.
@@ -32,6 +35,496 @@ find_all_filled_slots(u64 bitmap, s32 positions[64])
     return count;
 }
 
+// ============================================================================
+// Sorted views
+// ============================================================================
+
+internal u8
+name_fold(u8 c)
+{
+    return (c >= 'A' && c <= 'Z') ? (u8)(c + ('a' - 'A')) : c;
+}
+
+/**
+ * Case-insensitive (ASCII) ordering of two names, the bytes break the ties
+ * between names that only differ by case.
+ *
+ * @return < 0, 0 or > 0 as a sorts before, equal to or after b
+ */
+internal s32
+name_order(String8 a, String8 b)
+{
+    u64 len = Min(a.len, b.len);
+    for (u64 i = 0; i < len; ++i)
+    {
+        s32 diff = (s32)name_fold(a.str[i]) - (s32)name_fold(b.str[i]);
+        if (diff != 0) return diff;
+    }
+    if (a.len != b.len) return a.len < b.len ? -1 : 1;
+
+    for (u64 i = 0; i < len; ++i)
+    {
+        s32 diff = (s32)a.str[i] - (s32)b.str[i];
+        if (diff != 0) return diff;
+    }
+    return 0;
+}
+
+/**
+ * Case-insensitive comparison of the first prefix.len bytes of name with
+ * prefix, a shorter name compares as its folded bytes followed by nothing.
+ */
+internal s32
+name_prefix_order(String8 name, String8 prefix)
+{
+    u64 len = Min(name.len, prefix.len);
+    for (u64 i = 0; i < len; ++i)
+    {
+        s32 diff = (s32)name_fold(name.str[i]) - (s32)name_fold(prefix.str[i]);
+        if (diff != 0) return diff;
+    }
+    return name.len < prefix.len ? -1 : 0;
+}
+
+internal u32
+registration_count(u64 registrations)
+{
+    return (u32)__builtin_popcountll(registrations);
+}
+
+/**
+ * Order of the entries of a view: greater keys first, then names ascending.
+ */
+internal s32
+sorted_view_order(SortedViewEntry *a, SortedViewEntry *b)
+{
+    if (a->key != b->key) return a->key > b->key ? -1 : 1;
+    return name_order(a->name, b->name);
+}
+
+void
+sorted_view_insert(SortedView *view, u32 idx, u32 key, String8 name)
+{
+    assert(view->count < MAX_NUM_ENTITIES);
+
+    SortedViewEntry entry = { .name = name, .key = key, .idx = idx };
+
+    // Binary search for the position, then shift the entries after it up by
+    // one: views hold at most MAX_NUM_ENTITIES entries, a memmove of a few
+    // hundred bytes is cheaper than maintaining a tree
+    u32 lo = 0;
+    u32 hi = view->count;
+    while (lo < hi)
+    {
+        u32 mid = lo + (hi - lo) / 2;
+        if (sorted_view_order(&view->entries[mid], &entry) <= 0) lo = mid + 1;
+        else                                                    hi = mid;
+    }
+
+    MemoryCopy(view->entries + lo + 1, view->entries + lo, (view->count - lo) * sizeof(SortedViewEntry));
+    view->entries[lo] = entry;
+    view->count++;
+}
+
+void
+sorted_view_remove(SortedView *view, u32 idx)
+{
+    u32 pos = 0;
+    while (pos < view->count && view->entries[pos].idx != idx)
+    {
+        pos++;
+    }
+    assert(pos < view->count);
+
+    view->count--;
+    MemoryCopy(view->entries + pos, view->entries + pos + 1, (view->count - pos) * sizeof(SortedViewEntry));
+}
+
+/**
+ * Move an entry after its key or name changed.
+ */
+void
+sorted_view_update(SortedView *view, u32 idx, u32 key, String8 name)
+{
+    sorted_view_remove(view, idx);
+    sorted_view_insert(view, idx, key, name);
+}
+
+/**
+ * Entries whose name starts with prefix, ignoring case. An empty prefix
+ * matches every entry. Only meaningful on views where every key is equal.
+ */
+SortedRange
+sorted_view_prefix(SortedView *view, String8 prefix)
+{
+    // Lower bound: first name not sorting before the prefix
+    u32 lo = 0;
+    u32 hi = view->count;
+    while (lo < hi)
+    {
+        u32 mid = lo + (hi - lo) / 2;
+        if (name_prefix_order(view->entries[mid].name, prefix) < 0) lo = mid + 1;
+        else                                                         hi = mid;
+    }
+
+    // Upper bound: first name sorting after the prefix
+    u32 first = lo;
+    hi = view->count;
+    while (lo < hi)
+    {
+        u32 mid = lo + (hi - lo) / 2;
+        if (name_prefix_order(view->entries[mid].name, prefix) <= 0) lo = mid + 1;
+        else                                                          hi = mid;
+    }
+
+    SortedRange range = { .first = first, .count = lo - first };
+    return range;
+}
+
+/**
+ * Number of entries with a non-zero key, they come first in the view.
+ */
+u32
+sorted_view_count_keyed(SortedView *view)
+{
+    u32 lo = 0;
+    u32 hi = view->count;
+    while (lo < hi)
+    {
+        u32 mid = lo + (hi - lo) / 2;
+        if (view->entries[mid].key != 0) lo = mid + 1;
+        else                             hi = mid;
+    }
+    return lo;
+}
+
+// ============================================================================
+// Results
+// ============================================================================
+//
+// Each event caches the medals its bracket awards and the record of each of
+// its players, each player the sums over all events. When an event changes,
+// results_update_event recomputes that event alone and applies the
+// difference to its players, so neither the medal table nor the player
+// pages ever rescan the events.
+
+/**
+ * Sort key of the medal table: golds first, then silvers, then bronzes.
+ */
+u32
+medal_key(MedalCount medals)
+{
+    return ((u32)medals.gold << 16) | ((u32)medals.silver << 8) | (u32)medals.bronze;
+}
+
+/**
+ * Loser of the match decided at bracket_pos, 0 if it was not played
+ * (undecided, or a bye: a player placed there without opponent).
+ */
+internal u8
+tournament_match_loser(u8 *bracket, u32 bracket_pos)
+{
+    u8 winner = bracket[bracket_pos];
+    u8 left = bracket[2 * bracket_pos + 1];
+    u8 right = bracket[2 * bracket_pos + 2];
+    if (winner == 0 || left == 0 || right == 0)
+    {
+        return 0;
+    }
+    return (winner == left) ? right : left;
+}
+
+EventMedals
+tournament_medals(Event *event)
+{
+    EventMedals medals = {0};
+    if (event->phase != PHASE_KNOCKOUT && event->phase != PHASE_FINISHED)
+    {
+        return medals;
+    }
+
+    u8 *bracket = tournament_knockout_bracket(event);
+
+    // Final at slot 0, semifinals at slots 1 and 2
+    u8 runner_up = tournament_match_loser(bracket, 0);
+    if (runner_up != 0)
+    {
+        medals.gold = bracket[0];
+        medals.silver = runner_up;
+    }
+    medals.bronze[0] = tournament_match_loser(bracket, 1);
+    medals.bronze[1] = tournament_match_loser(bracket, 2);
+
+    return medals;
+}
+
+internal void
+results_count_medals(PlayersList *players, EventMedals medals, s32 sign)
+{
+    Player *p = players->players;
+    if (medals.gold)      p[medals.gold].medals.gold        = (u8)(p[medals.gold].medals.gold + sign);
+    if (medals.silver)    p[medals.silver].medals.silver    = (u8)(p[medals.silver].medals.silver + sign);
+    if (medals.bronze[0]) p[medals.bronze[0]].medals.bronze = (u8)(p[medals.bronze[0]].medals.bronze + sign);
+    if (medals.bronze[1]) p[medals.bronze[1]].medals.bronze = (u8)(p[medals.bronze[1]].medals.bronze + sign);
+}
+
+/**
+ * Replace the medals an event awards, and move the players whose tally
+ * changed in the medal table.
+ */
+internal void
+results_set_event_medals(PlayersList *players, Event *event, EventMedals medals)
+{
+    EventMedals old = event->medals;
+    if (MemoryMatchStruct(&old, &medals))
+    {
+        return;
+    }
+
+    results_count_medals(players, old, -1);
+    results_count_medals(players, medals, +1);
+    event->medals = medals;
+
+    u8 touched[] = {
+        old.gold, old.silver, old.bronze[0], old.bronze[1],
+        medals.gold, medals.silver, medals.bronze[0], medals.bronze[1],
+    };
+    u64 moved = 0;
+    for (u32 i = 0; i < ArrayCount(touched); ++i)
+    {
+        u8 idx = touched[i];
+        if (idx == 0 || (moved & (1ULL << idx))) continue;
+        moved |= 1ULL << idx;
+
+        Player *player = players->players + idx;
+        sorted_view_update(players->by_medals, idx, medal_key(player->medals), player->name);
+    }
+}
+
+/**
+ * Round of a knockout slot: 0 for the winner, 1 for the final, 2 for the
+ * semifinals, and so on.
+ */
+u32
+tournament_round_of_slot(u32 bracket_slot)
+{
+    u32 round = 0;
+    for (u32 slot = bracket_slot + 1; slot > 1; slot /= 2)
+    {
+        round++;
+    }
+    return round;
+}
+
+internal void
+record_match(PlayerRecord *record, u32 goals_for, u32 goals_against, MatchResult result)
+{
+    record->played++;
+    record->goals_for += (u16)goals_for;
+    record->goals_against += (u16)goals_against;
+    if      (result == MATCH_RESULT_WIN)  record->wins++;
+    else if (result == MATCH_RESULT_DRAW) record->draws++;
+    else                                  record->losses++;
+}
+
+/**
+ * Records of all the players of an event, by player index, from its group
+ * matrix and knockout bracket.
+ */
+void
+tournament_records(Event *event, PlayerRecord records[MAX_NUM_ENTITIES])
+{
+    MemoryZeroTyped(records, MAX_NUM_ENTITIES);
+    for (u32 i = 0; i < MAX_NUM_ENTITIES; ++i)
+    {
+        records[i].bracket_slot = RECORD_NO_SLOT;
+    }
+
+    if (event->phase == PHASE_REGISTRATION)
+    {
+        return;
+    }
+
+    // Group matches, each pair once: a 0-0 is a match still to play
+    GroupPhase *gp = &event->group_phase;
+    if (event->format == FORMAT_GROUP_KNOCKOUT)
+    {
+        for (u32 g = 0; g < gp->num_groups; ++g)
+        {
+            for (u32 row = 0; row < MAX_GROUP_SIZE; ++row)
+            {
+                for (u32 col = row + 1; col < MAX_GROUP_SIZE; ++col)
+                {
+                    u8 row_player = gp->groups[g][row];
+                    u8 col_player = gp->groups[g][col];
+                    MatchScore score = gp->scores[g][row][col];
+                    if (row_player == 0 || col_player == 0 || (score.row_score == 0 && score.col_score == 0))
+                    {
+                        continue;
+                    }
+
+                    MatchResult row_result = score.row_score > score.col_score ? MATCH_RESULT_WIN
+                                           : score.row_score < score.col_score ? MATCH_RESULT_LOSE
+                                           : MATCH_RESULT_DRAW;
+                    MatchResult col_result = row_result == MATCH_RESULT_WIN  ? MATCH_RESULT_LOSE
+                                           : row_result == MATCH_RESULT_LOSE ? MATCH_RESULT_WIN
+                                           : MATCH_RESULT_DRAW;
+                    record_match(&records[row_player], score.row_score, score.col_score, row_result);
+                    record_match(&records[col_player], score.col_score, score.row_score, col_result);
+                }
+            }
+        }
+    }
+
+    if (event->phase != PHASE_KNOCKOUT && event->phase != PHASE_FINISHED)
+    {
+        return;
+    }
+
+    // Knockout matches, decided when the winner advanced. Descending so the
+    // last slot seen for a player is the deepest one
+    u8 *bracket = tournament_knockout_bracket(event);
+    for (u32 pos = BRACKET_SIZE; pos-- > 0;)
+    {
+        u8 player = bracket[pos];
+        if (player != 0)
+        {
+            records[player].bracket_slot = (u8)pos;
+        }
+
+        u8 loser = (2 * pos + 2 < BRACKET_SIZE) ? tournament_match_loser(bracket, pos) : 0;
+        if (loser != 0)
+        {
+            record_match(&records[player], 0, 0, MATCH_RESULT_WIN);
+            record_match(&records[loser], 0, 0, MATCH_RESULT_LOSE);
+        }
+    }
+
+    if (event->medals.gold != 0)
+    {
+        for (u32 i = 0; i < MAX_NUM_ENTITIES; ++i)
+        {
+            records[i].finished = (event->registrations >> i) & 1;
+        }
+    }
+}
+
+internal void
+results_add_record(PlayerStats *stats, PlayerRecord *record)
+{
+    stats->played          += record->played;
+    stats->wins            += record->wins;
+    stats->draws           += record->draws;
+    stats->losses          += record->losses;
+    stats->goals_for       += record->goals_for;
+    stats->goals_against   += record->goals_against;
+    stats->events_finished += record->finished;
+}
+
+internal void
+results_subtract_record(PlayerStats *stats, PlayerRecord *record)
+{
+    stats->played          -= record->played;
+    stats->wins            -= record->wins;
+    stats->draws           -= record->draws;
+    stats->losses          -= record->losses;
+    stats->goals_for       -= record->goals_for;
+    stats->goals_against   -= record->goals_against;
+    stats->events_finished -= record->finished;
+}
+
+/**
+ * Replace the records of an event's players, the old ones are taken out of
+ * the stats of the players that had them (maybe no longer registered).
+ */
+internal void
+results_set_event_records(PlayersList *players, Event *event, PlayerRecord records[MAX_NUM_ENTITIES], u64 recorded)
+{
+    s32 positions[64];
+    u32 count = find_all_filled_slots(event->recorded | recorded, positions);
+    for (u32 i = 0; i < count; ++i)
+    {
+        u32 idx = (u32)positions[i];
+        PlayerStats *stats = &players->players[idx].stats;
+        if ((event->recorded >> idx) & 1) results_subtract_record(stats, &event->records[idx]);
+        if ((recorded >> idx) & 1)        results_add_record(stats, &records[idx]);
+    }
+
+    MemoryCopy(event->records, records, sizeof(event->records));
+    event->recorded = recorded;
+}
+
+/**
+ * Recompute the medals and records of an event after its bracket, scores,
+ * registrations or phase changed.
+ */
+void
+results_update_event(PlayersList *players, EventsList *events, u32 event_idx)
+{
+    Event *event = events->events + event_idx;
+    results_set_event_medals(players, event, tournament_medals(event));
+
+    // After the medals: records read whether the final was played
+    PlayerRecord records[MAX_NUM_ENTITIES];
+    tournament_records(event, records);
+    results_set_event_records(players, event, records, event->registrations);
+}
+
+/**
+ * Recompute every medal from the brackets, after a load. Leaves the views
+ * alone: call before players_list_reindex.
+ */
+void
+results_rebuild(PlayersList *players, EventsList *events)
+{
+    for (u32 i = 0; i < players->len; ++i)
+    {
+        MemoryZeroStruct(&players->players[i].medals);
+        MemoryZeroStruct(&players->players[i].stats);
+    }
+    for (u32 i = 0; i < events->len; ++i)
+    {
+        MemoryZeroStruct(&events->events[i].medals);
+        events->events[i].recorded = 0;
+    }
+
+    u32 idx_tail = events->len - 1;
+    for (u32 idx = events->events->nxt; idx != idx_tail; idx = events->events[idx].nxt)
+    {
+        Event *event = events->events + idx;
+        event->medals = tournament_medals(event);
+        results_count_medals(players, event->medals, +1);
+
+        tournament_records(event, event->records);
+        event->recorded = event->registrations;
+        for (u32 i = 0; i < MAX_NUM_ENTITIES; ++i)
+        {
+            if ((event->recorded >> i) & 1) results_add_record(&players->players[i].stats, &event->records[i]);
+        }
+    }
+}
+
+/**
+ * Events whose final has been played.
+ */
+u32
+events_list_finished_count(EventsList *list)
+{
+    u32 idx_tail = list->len - 1;
+
+    u32 count = 0;
+    for (u32 idx = list->events->nxt; idx != idx_tail; idx = list->events[idx].nxt)
+    {
+        count += list->events[idx].medals.gold != 0;
+    }
+
+    return count;
+}
+
+// ============================================================================
+// Lists
+// ============================================================================
+
 PlayersList
 players_list_init(Arena *arena, u32 len)
 {
@@ -50,6 +543,9 @@ players_list_init(Arena *arena, u32 len)
 
     // Initialize the free list
     PlayersList players_list = { .players = players, .first_free_idx = 1, .len = len };
+    players_list.by_name = push_array(arena, SortedView, 1);
+    players_list.by_registrations = push_array(arena, SortedView, 1);
+    players_list.by_medals = push_array(arena, SortedView, 1);
 
     for (u32 i = 1; i < idx_tail; ++i)
     {
@@ -77,6 +573,8 @@ events_list_init(Arena *arena, u32 len)
 
     // Initialize the free list
     EventsList events_list = { .events = events, .first_free_idx = 1, .len = len };
+    events_list.by_name = push_array(arena, SortedView, 1);
+    events_list.by_registrations = push_array(arena, SortedView, 1);
 
     for (u32 i = 1; i < idx_tail; ++i)
     {
@@ -191,6 +689,12 @@ players_list_add(PlayersList *list, String8 name)
 
     // Player is not registered to anything
     player->registrations = 0;
+    MemoryZeroStruct(&player->medals);
+    MemoryZeroStruct(&player->stats);
+
+    sorted_view_insert(list->by_name, idx_player, 0, name);
+    sorted_view_insert(list->by_registrations, idx_player, 0, name);
+    sorted_view_insert(list->by_medals, idx_player, 0, name);
 
     return idx_player;
 }
@@ -227,6 +731,11 @@ events_list_add(EventsList *list, String8 name)
 
     // Event has no registered players
     event->registrations = 0;
+    MemoryZeroStruct(&event->medals);
+    event->recorded = 0;
+
+    sorted_view_insert(list->by_name, idx_event, 0, name);
+    sorted_view_insert(list->by_registrations, idx_event, 0, name);
 
     // Default group size and advance count for tournaments
     event->group_phase.group_size = 4;
@@ -247,6 +756,10 @@ players_list_rename(PlayersList *list, u32 idx, String8 name)
     // No duplicate found, the player can be renamed
     Player *player = list->players + idx;
     player->name = name;
+
+    sorted_view_update(list->by_name, idx, 0, name);
+    sorted_view_update(list->by_registrations, idx, registration_count(player->registrations), name);
+    sorted_view_update(list->by_medals, idx, medal_key(player->medals), name);
 }
 
 void
@@ -261,6 +774,45 @@ events_list_rename(EventsList *list, u32 idx, String8 name)
     // No duplicate found, the event can be renamed
     Event *event = list->events + idx;
     event->name = name;
+
+    sorted_view_update(list->by_name, idx, 0, name);
+    sorted_view_update(list->by_registrations, idx, registration_count(event->registrations), name);
+}
+
+/**
+ * Rebuild the sorted views from the linked list, after the list was filled
+ * without going through players_list_add (loading a save).
+ */
+void
+players_list_reindex(PlayersList *list)
+{
+    u32 idx_tail = list->len - 1;
+
+    list->by_name->count = 0;
+    list->by_registrations->count = 0;
+    list->by_medals->count = 0;
+    for (u32 idx = list->players->nxt; idx != idx_tail; idx = list->players[idx].nxt)
+    {
+        Player *player = list->players + idx;
+        sorted_view_insert(list->by_name, idx, 0, player->name);
+        sorted_view_insert(list->by_registrations, idx, registration_count(player->registrations), player->name);
+        sorted_view_insert(list->by_medals, idx, medal_key(player->medals), player->name);
+    }
+}
+
+void
+events_list_reindex(EventsList *list)
+{
+    u32 idx_tail = list->len - 1;
+
+    list->by_name->count = 0;
+    list->by_registrations->count = 0;
+    for (u32 idx = list->events->nxt; idx != idx_tail; idx = list->events[idx].nxt)
+    {
+        Event *event = list->events + idx;
+        sorted_view_insert(list->by_name, idx, 0, event->name);
+        sorted_view_insert(list->by_registrations, idx, registration_count(event->registrations), event->name);
+    }
 }
 
 void
@@ -289,15 +841,23 @@ players_list_remove(PlayersList *players, EventsList *events, String8 name)
 
         // Clear the bit for this player
         event->registrations &= ~(1ULL << idx);
+        sorted_view_update(events->by_registrations, (u32)positions[i], registration_count(event->registrations), event->name);
 
         // Update tournament bracket/groups
         tournament_construct_groups(event);
         tournament_construct_bracket(event);
         tournament_populate_bracket_from_groups(event);
+
+        // While the player is still in the views: the medals they lose here
+        // are all the medals they had
+        results_update_event(players, events, (u32)positions[i]);
     }
 
     prev->nxt = idx_nxt;
     next->prv = idx_prv;
+    sorted_view_remove(players->by_name, idx);
+    sorted_view_remove(players->by_registrations, idx);
+    sorted_view_remove(players->by_medals, idx);
 
     player->nxt = players->first_free_idx;
     players->first_free_idx = idx;
@@ -320,6 +880,11 @@ events_list_remove(EventsList *events, PlayersList *players, String8 name)
     Event *prev = head + idx_prv;
     Event *next = head + idx_nxt;
 
+    // Take back the medals and the records of this event
+    PlayerRecord no_records[MAX_NUM_ENTITIES] = {0};
+    results_set_event_medals(players, event, (EventMedals){0});
+    results_set_event_records(players, event, no_records, 0);
+
     // Unregister all players from this event
     s32 positions[64] = {0};
     u32 count = find_all_filled_slots(event->registrations, positions);
@@ -329,10 +894,13 @@ events_list_remove(EventsList *events, PlayersList *players, String8 name)
 
         // Clear the bit for this event
         player->registrations &= ~(1ULL << idx);
+        sorted_view_update(players->by_registrations, (u32)positions[i], registration_count(player->registrations), player->name);
     }
 
     prev->nxt = idx_nxt;
     next->prv = idx_prv;
+    sorted_view_remove(events->by_name, idx);
+    sorted_view_remove(events->by_registrations, idx);
 
     event->nxt = events->first_free_idx;
     events->first_free_idx = idx;
@@ -357,10 +925,14 @@ register_player_to_event(PlayersList *players, EventsList *events, String8 playe
     player->registrations |= (1ULL << event_idx);
     event->registrations |= (1ULL << player_idx);
 
+    sorted_view_update(players->by_registrations, player_idx, registration_count(player->registrations), player->name);
+    sorted_view_update(events->by_registrations, event_idx, registration_count(event->registrations), event->name);
+
     // Update tournament bracket/groups
     tournament_construct_groups(event);
     tournament_construct_bracket(event);
     tournament_populate_bracket_from_groups(event);
+    results_update_event(players, events, event_idx);
 }
 
 void
@@ -382,17 +954,62 @@ unregister_player_from_event(PlayersList *players, EventsList *events, String8 p
     player->registrations &= ~(1ULL << event_idx);
     event->registrations &= ~(1ULL << player_idx);
 
+    sorted_view_update(players->by_registrations, player_idx, registration_count(player->registrations), player->name);
+    sorted_view_update(events->by_registrations, event_idx, registration_count(event->registrations), event->name);
+
     // Update tournament bracket/groups
     tournament_construct_groups(event);
     tournament_construct_bracket(event);
     tournament_populate_bracket_from_groups(event);
+    results_update_event(players, events, event_idx);
 }
 
 /**
- * Construct the tournament bracket from registered players.
+ * Register latecomers to an event in the group phase as a new group, see
+ * tournament_add_group. Nothing changes when the group cannot be added.
  *
- * Places player indices into a binary tree array (heap-style layout).
- * For non-power-of-2 player counts, some players receive byes.
+ * @param group Bitmask of player indices, none registered to the event yet
+ */
+b32
+register_late_group_to_event(PlayersList *players, EventsList *events, u32 event_idx, u64 group)
+{
+    Event *event = events->events + event_idx;
+    assert((event->registrations & group) == 0);
+
+    s32 positions[64];
+    u32 count = find_all_filled_slots(group, positions);
+    u8 members[MAX_GROUP_SIZE];
+    if (count > MAX_GROUP_SIZE) return false;
+    for (u32 i = 0; i < count; i++)
+    {
+        members[i] = (u8)positions[i];
+    }
+
+    // Registered first: tournament_add_group checks it
+    event->registrations |= group;
+    if (!tournament_add_group(event, members, count))
+    {
+        event->registrations &= ~group;
+        return false;
+    }
+
+    for (u32 i = 0; i < count; i++)
+    {
+        Player *player = players->players + members[i];
+        player->registrations |= 1ULL << event_idx;
+        sorted_view_update(players->by_registrations, members[i], registration_count(player->registrations), player->name);
+    }
+    sorted_view_update(events->by_registrations, event_idx, registration_count(event->registrations), event->name);
+
+    results_update_event(players, events, event_idx);
+    return true;
+}
+
+/**
+ * Construct the tournament bracket from registered players.
+ *
+ * Places player indices into a binary tree array (heap-style layout).
+ * For non-power-of-2 player counts, some players receive byes.
  *
  * Example: 3 players (indices 3, 6, 8)
  *   - Player 3 at position 1 (bye to finals)
@@ -404,6 +1021,8 @@ unregister_player_from_event(PlayersList *players, EventsList *events, String8 p
 void
 tournament_construct_bracket(Event *event)
 {
+    TraceBegin(tournament_construct_bracket);
+
     // Clear the bracket
     MemoryZeroArray(event->bracket);
 
@@ -413,6 +1032,7 @@ tournament_construct_bracket(Event *event)
 
     if (num_players == 0)
     {
+        TraceEnd(tournament_construct_bracket);
         return;
     }
 
@@ -457,16 +1077,21 @@ tournament_construct_bracket(Event *event)
         fighting_start++;
         player_idx++;
     }
+
+    TraceEnd(tournament_construct_bracket);
 }
 
 void
 tournament_construct_groups(Event *event)
 {
+    TraceBegin(tournament_construct_groups);
+
     s32 positions[64];
     u32 num_players = find_all_filled_slots(event->registrations, positions);
 
     if (num_players == 0)
     {
+        TraceEnd(tournament_construct_groups);
         return;
     }
 
@@ -543,6 +1168,8 @@ tournament_construct_groups(Event *event)
             player_i++;
         }
     }
+
+    TraceEnd(tournament_construct_groups);
 }
 
 /**
@@ -567,9 +1194,9 @@ calculate_group_standings(Event *event, u32 group_idx, u8 *standings, u32 player
         s32 points;
         s32 goal_diff;
         s32 goals_for;
-    } PlayerStats;
+    } GroupStanding;
 
-    PlayerStats stats[MAX_GROUP_SIZE] = {0};
+    GroupStanding stats[MAX_GROUP_SIZE] = {0};
 
     // Calculate stats for each player in the group
     for (u32 slot = 0; slot < players_in_group; slot++)
@@ -627,7 +1254,7 @@ calculate_group_standings(Event *event, u32 group_idx, u8 *standings, u32 player
 
             if (swap)
             {
-                PlayerStats temp = stats[j];
+                GroupStanding temp = stats[j];
                 stats[j] = stats[j + 1];
                 stats[j + 1] = temp;
             }
@@ -641,27 +1268,297 @@ calculate_group_standings(Event *event, u32 group_idx, u8 *standings, u32 player
     }
 }
 
+// ============================================================================
+// Seeding
+// ============================================================================
+//
+// Standard seeding: in a bracket of 2^levels lines, seed s (from 0) plays
+// seed 2^levels - 1 - s in the first round, and seeds 0 and 1 can only meet
+// in the final, seeds 0 to 3 in the semifinals, and so on. The seed of a line
+// is read off the bits of the line, from the top of the bracket down: each
+// level mirrors the seeds of the half the line lies in.
+//
+// Qualifiers from groups are seeded by tier, every group winner first, then
+// every runner-up, and so on, each tier taking the next block of seeds.
+// Within a tier, which qualifier takes which seed is an assignment problem: a
+// seed costs more the earlier its line would meet the qualifiers of the same
+// group already seeded, and the cheapest assignment is found exactly with the
+// Hungarian algorithm, O(n^3) for a tier of n qualifiers, no backtracking.
+
+/**
+ * Seed (from 0) of a line (from 0, top to bottom) of a bracket of 2^levels lines.
+ */
+u32
+seeding_seed_of_line(u32 line, u32 levels)
+{
+    u32 seed = 0;
+    for (u32 level = 1; level <= levels; level++)
+    {
+        if ((line >> (levels - level)) & 1)
+        {
+            seed = (1u << level) - 1 - seed;
+        }
+    }
+    return seed;
+}
+
+/**
+ * Round (1 = first) in which the qualifiers of two different lines meet, if
+ * both keep winning.
+ */
+u32
+seeding_meeting_round(u32 line_a, u32 line_b)
+{
+    assert(line_a != line_b);
+    return 32 - (u32)__builtin_clz(line_a ^ line_b);
+}
+
+/**
+ * Minimum cost assignment of n rows to n columns (Hungarian algorithm with
+ * potentials, O(n^3)).
+ *
+ * @param cost       n * n costs, row major
+ * @param row_column Output: column assigned to each row
+ */
+internal void
+seeding_assign(Arena *arena, s64 *cost, u32 n, u32 *row_column)
+{
+    // 1-based, row and column 0 are the sentinel of the augmenting paths
+    s64 *u = push_array(arena, s64, n + 1);
+    s64 *v = push_array(arena, s64, n + 1);
+    s64 *min_slack = push_array(arena, s64, n + 1);
+    u32 *column_row = push_array(arena, u32, n + 1);
+    u32 *way = push_array(arena, u32, n + 1);
+    b32 *used = push_array(arena, b32, n + 1);
+    b32 *matched = push_array(arena, b32, n + 1);
+
+    // Start from the reduced costs, matching greedily the rows and columns
+    // they make free: only the rows left over are augmented
+    for (u32 i = 1; i <= n; i++)
+    {
+        u[i] = INT64_MAX;
+        for (u32 j = 1; j <= n; j++)
+        {
+            u[i] = Min(u[i], cost[(i - 1) * n + (j - 1)]);
+        }
+    }
+    for (u32 j = 1; j <= n; j++)
+    {
+        v[j] = INT64_MAX;
+    }
+    for (u32 i = 1; i <= n; i++)
+    {
+        for (u32 j = 1; j <= n; j++)
+        {
+            v[j] = Min(v[j], cost[(i - 1) * n + (j - 1)] - u[i]);
+        }
+    }
+    for (u32 i = 1; i <= n; i++)
+    {
+        for (u32 j = 1; j <= n; j++)
+        {
+            if (column_row[j] == 0 && cost[(i - 1) * n + (j - 1)] == u[i] + v[j])
+            {
+                column_row[j] = i;
+                matched[i] = true;
+                break;
+            }
+        }
+    }
+
+    for (u32 row = 1; row <= n; row++)
+    {
+        if (matched[row]) continue;
+
+        column_row[0] = row;
+        u32 column = 0;
+        for (u32 j = 0; j <= n; j++)
+        {
+            min_slack[j] = INT64_MAX;
+            used[j] = false;
+        }
+
+        // Grow the tree of tight edges until it reaches a free column
+        do
+        {
+            used[column] = true;
+            u32 i = column_row[column];
+            s64 delta = INT64_MAX;
+            u32 next = 0;
+            for (u32 j = 1; j <= n; j++)
+            {
+                if (used[j]) continue;
+                s64 slack = cost[(i - 1) * n + (j - 1)] - u[i] - v[j];
+                if (slack < min_slack[j])
+                {
+                    min_slack[j] = slack;
+                    way[j] = column;
+                }
+                if (min_slack[j] < delta)
+                {
+                    delta = min_slack[j];
+                    next = j;
+                }
+            }
+            for (u32 j = 0; j <= n; j++)
+            {
+                if (used[j])
+                {
+                    u[column_row[j]] += delta;
+                    v[j] -= delta;
+                }
+                else
+                {
+                    min_slack[j] -= delta;
+                }
+            }
+            column = next;
+        } while (column_row[column] != 0);
+
+        // Flip the augmenting path
+        do
+        {
+            u32 previous = way[column];
+            column_row[column] = column_row[previous];
+            column = previous;
+        } while (column != 0);
+    }
+
+    for (u32 j = 1; j <= n; j++)
+    {
+        row_column[column_row[j] - 1] = j - 1;
+    }
+}
+
+/**
+ * Seed qualifiers into the lines of the smallest bracket that holds them.
+ *
+ * @param groups Group of each qualifier
+ * @param tiers  Tier of each qualifier (its position in its group), in
+ *               non-decreasing order, with one qualifier per group per tier
+ * @param count  Number of qualifiers, taking the seeds from 0 in this order
+ *               unless that would make qualifiers of a group meet earlier
+ * @param lines  Output: line of each qualifier
+ * @return       Levels of the bracket, which has 2^levels lines
+ */
+u32
+seeding_assign_lines(u16 *groups, u16 *tiers, u32 count, u32 *lines)
+{
+    TraceBegin(seeding_assign_lines);
+
+    u32 levels = 0;
+    while ((1u << levels) < count)
+    {
+        levels++;
+    }
+    u32 num_lines = 1u << levels;
+
+    Temp temp = scratch_get(0, 0);
+
+    u32 *line_of_seed = push_array(temp.arena, u32, num_lines);
+    for (u32 line = 0; line < num_lines; line++)
+    {
+        line_of_seed[seeding_seed_of_line(line, levels)] = line;
+    }
+
+    // Qualifiers of each group chained from the last one seeded
+    u32 num_groups = 0;
+    for (u32 i = 0; i < count; i++)
+    {
+        num_groups = Max(num_groups, (u32)groups[i] + 1);
+    }
+    u32 *last_of_group = push_array(temp.arena, u32, num_groups);
+    u32 *previous_of_group = push_array(temp.arena, u32, count);
+    for (u32 g = 0; g < num_groups; g++)
+    {
+        last_of_group[g] = UINT32_MAX;
+    }
+
+    u32 tier_start = 0;
+    while (tier_start < count)
+    {
+        u32 n = 1;
+        while (tier_start + n < count && tiers[tier_start + n] == tiers[tier_start])
+        {
+            n++;
+        }
+
+        Temp tier_temp = temp_begin(temp.arena);
+        u32 *seed = push_array(tier_temp.arena, u32, n);
+
+        b32 separate = false;
+        for (u32 i = 0; i < n; i++)
+        {
+            seed[i] = i;
+            separate |= last_of_group[groups[tier_start + i]] != UINT32_MAX;
+        }
+
+        // Nobody seeded yet from these groups (the group winners): in order
+        if (separate)
+        {
+            // Meeting in round r costs 2^(levels - r): meeting one qualifier
+            // a round earlier weighs more than meeting all of them a round
+            // later. Ties go to the lowest seeds, in order.
+            s64 *cost = push_array(tier_temp.arena, s64, (u64)n * n);
+            for (u32 i = 0; i < n; i++)
+            {
+                u32 first = last_of_group[groups[tier_start + i]];
+                for (u32 j = 0; j < n; j++)
+                {
+                    u32 line = line_of_seed[tier_start + j];
+                    s64 penalty = 0;
+                    for (u32 other = first; other != UINT32_MAX; other = previous_of_group[other])
+                    {
+                        penalty += 1ll << (levels - seeding_meeting_round(line, lines[other]));
+                    }
+                    cost[(u64)i * n + j] = penalty;
+                }
+            }
+            seeding_assign(tier_temp.arena, cost, n, seed);
+        }
+
+        for (u32 i = 0; i < n; i++)
+        {
+            u32 q = tier_start + i;
+            lines[q] = line_of_seed[tier_start + seed[i]];
+            previous_of_group[q] = last_of_group[groups[q]];
+            last_of_group[groups[q]] = q;
+        }
+        temp_end(tier_temp);
+
+        tier_start += n;
+    }
+
+    scratch_release(temp);
+    TraceEnd(seeding_assign_lines);
+
+    return levels;
+}
+
 /**
  * Populate the tournament bracket from group phase qualifiers.
  *
  * Takes the top N players from each group (where N = advance_per_group)
- * and places them into the elimination bracket. Seeding is done to avoid
- * players from the same group meeting in early rounds when possible.
+ * and seeds them into the elimination bracket, group winners first (see
+ * Seeding): players from the same group meet as late as the number of
+ * qualifiers allows. The top seeds get the byes, placed directly in the
+ * second round.
  *
  * @param event The event/tournament with completed group phase
  */
 void
 tournament_populate_bracket_from_groups(Event *event)
 {
+    TraceBegin(tournament_populate_bracket_from_groups);
+
     // Clear the bracket
     MemoryZeroArray(event->group_phase.bracket);
 
     u32 num_groups = event->group_phase.num_groups;
     u32 advance_per_group = event->group_phase.advance_per_group;
 
-    // Collect all qualifiers from each group
-    u8 qualifiers[MAX_GROUPS * MAX_GROUP_SIZE];
-    u32 num_qualifiers = 0;
+    u8 standings[MAX_GROUPS][MAX_GROUP_SIZE];
+    u32 to_advance[MAX_GROUPS];
 
     for (u32 g = 0; g < num_groups; g++)
     {
@@ -675,77 +1572,277 @@ tournament_populate_bracket_from_groups(Event *event)
             }
         }
 
-        // Get standings for this group
-        u8 standings[MAX_GROUP_SIZE];
-        calculate_group_standings(event, g, standings, players_in_group);
+        calculate_group_standings(event, g, standings[g], players_in_group);
+        to_advance[g] = Min(advance_per_group, players_in_group);
+    }
+
+    // Collect the qualifiers tier by tier: every group's winner, then every
+    // group's runner-up...
+    u8 qualifiers[MAX_GROUPS * MAX_GROUP_SIZE];
+    u16 qualifier_groups[MAX_GROUPS * MAX_GROUP_SIZE];
+    u16 qualifier_tiers[MAX_GROUPS * MAX_GROUP_SIZE];
+    u32 num_qualifiers = 0;
 
-        // Take top N players from this group
-        u32 to_advance = advance_per_group;
-        if (to_advance > players_in_group)
+    for (u32 tier = 0; tier < advance_per_group; tier++)
+    {
+        for (u32 g = 0; g < num_groups; g++)
         {
-            to_advance = players_in_group;
-        }
+            if (tier >= to_advance[g]) continue;
 
-        for (u32 i = 0; i < to_advance; i++)
-        {
-            qualifiers[num_qualifiers++] = standings[i];
+            qualifiers[num_qualifiers] = standings[g][tier];
+            qualifier_groups[num_qualifiers] = (u16)g;
+            qualifier_tiers[num_qualifiers] = (u16)tier;
+            num_qualifiers++;
         }
     }
 
     if (num_qualifiers == 0)
     {
+        TraceEnd(tournament_populate_bracket_from_groups);
         return;
     }
 
-    // Find smallest power of 2 >= num_qualifiers
-    u32 bracket_size = 1;
-    while (bracket_size < num_qualifiers)
+    u32 lines[MAX_GROUPS * MAX_GROUP_SIZE];
+    u32 levels = seeding_assign_lines(qualifier_groups, qualifier_tiers, num_qualifiers, lines);
+    u32 leaf_start = (1u << levels) - 1;
+
+    for (u32 q = 0; q < num_qualifiers; q++)
     {
-        bracket_size *= 2;
+        u32 leaf_pos = leaf_start + lines[q];
+
+        // Opponent's seed past the last qualifier: a bye, straight to the parent
+        if (levels > 0 && seeding_seed_of_line(lines[q] ^ 1, levels) >= num_qualifiers)
+        {
+            event->group_phase.bracket[(leaf_pos - 1) / 2] = qualifiers[q];
+        }
+        else
+        {
+            event->group_phase.bracket[leaf_pos] = qualifiers[q];
+        }
     }
 
-    u32 byes = bracket_size - num_qualifiers;
+    TraceEnd(tournament_populate_bracket_from_groups);
+}
+
+/**
+ * The knockout bracket in use: the event's own one for pure knockout, the one
+ * fed by the groups for group + knockout.
+ */
+u8 *
+tournament_knockout_bracket(Event *event)
+{
+    return (event->format == FORMAT_GROUP_KNOCKOUT)
+        ? event->group_phase.bracket
+        : event->bracket;
+}
 
-    // Determine leaf level for this bracket size
-    u32 leaf_level = 0;
-    u32 tmp = bracket_size;
-    while (tmp > 1)
+/**
+ * Leave the registration phase. Needs at least 2 registered players.
+ *
+ * @return Whether the tournament was started
+ */
+b32
+tournament_start(Event *event)
+{
+    s32 positions[64];
+    u32 num_players = find_all_filled_slots(event->registrations, positions);
+    if (event->phase != PHASE_REGISTRATION || num_players < 2)
     {
-        leaf_level++;
-        tmp /= 2;
+        return false;
     }
 
-    u32 leaf_start = (1 << leaf_level) - 1;
+    event->phase = (event->format == FORMAT_GROUP_KNOCKOUT)
+        ? PHASE_GROUP
+        : PHASE_KNOCKOUT;
 
-    u32 qualifier_idx = 0;
+    return true;
+}
 
-    // Place bye players at parent level (they skip the first round)
-    for (u32 i = 0; i < byes && qualifier_idx < num_qualifiers; ++i)
+/**
+ * Record the result of a group match and reseed the knockout bracket.
+ *
+ * Both the (row, col) entry and its mirror (col, row) are written.
+ */
+void
+tournament_set_group_score(Event *event, u32 group_idx, u32 row, u32 col, u16 row_score, u16 col_score)
+{
+    assert(group_idx < MAX_GROUPS && row < MAX_GROUP_SIZE && col < MAX_GROUP_SIZE);
+
+    event->group_phase.scores[group_idx][row][col].row_score = row_score;
+    event->group_phase.scores[group_idx][row][col].col_score = col_score;
+
+    event->group_phase.scores[group_idx][col][row].row_score = col_score;
+    event->group_phase.scores[group_idx][col][row].col_score = row_score;
+
+    tournament_populate_bracket_from_groups(event);
+}
+
+/**
+ * Append a group of players to a group phase that has already started, e.g.
+ * latecomers. The groups already formed keep their players, scores and
+ * results; the bracket is reseeded, as after a score.
+ *
+ * The players must be registered to the event and not be in a group yet.
+ *
+ * @return Whether the group could be added: group phase, 2 to MAX_GROUP_SIZE
+ *         players, fewer than MAX_GROUPS groups
+ */
+b32
+tournament_add_group(Event *event, u8 *players, u32 count)
+{
+    GroupPhase *gp = &event->group_phase;
+    if (event->phase != PHASE_GROUP || count < 2 || count > MAX_GROUP_SIZE || gp->num_groups >= MAX_GROUPS)
     {
-        u32 leaf_pos = leaf_start + i * 2;
-        u32 parent_pos = (leaf_pos - 1) / 2;
-        event->group_phase.bracket[parent_pos] = qualifiers[qualifier_idx];
-        qualifier_idx++;
+        return false;
     }
 
-    // Place remaining players at leaf positions (they fight in first round)
-    u32 fighting_start = leaf_start + byes * 2;
+    u32 g = gp->num_groups++;
+    MemoryZeroArray(gp->scores[g]);
+    MemoryZeroArray(gp->results[g]);
 
-    while (qualifier_idx < num_qualifiers)
+    for (u32 s = 0; s < count; s++)
     {
-        event->group_phase.bracket[fighting_start] = qualifiers[qualifier_idx];
-        fighting_start++;
-        qualifier_idx++;
+        u8 player_idx = players[s];
+        assert((event->registrations >> player_idx) & 1);
+        assert(gp->player_group[player_idx] == GROUP_NONE);
+
+        gp->groups[g][s] = player_idx;
+        gp->player_group[player_idx] = (u8)g;
+        gp->player_slot[player_idx] = (u8)s;
+    }
+
+    tournament_populate_bracket_from_groups(event);
+    return true;
+}
+
+/**
+ * Advance the player at bracket_pos to the parent slot (they won the match).
+ */
+void
+tournament_advance_winner(Event *event, u32 bracket_pos)
+{
+    u8 *bracket = tournament_knockout_bracket(event);
+    if (bracket_pos == 0 || bracket_pos >= BRACKET_SIZE || bracket[bracket_pos] == 0)
+    {
+        return;
+    }
+
+    bracket[(bracket_pos - 1) / 2] = bracket[bracket_pos];
+}
+
+/**
+ * Undo the advancement of the player at bracket_pos: every ancestor slot
+ * holding that player is cleared (cascade reset up the tree).
+ */
+void
+tournament_undo_advance(Event *event, u32 bracket_pos, u8 player_idx)
+{
+    u8 *bracket = tournament_knockout_bracket(event);
+
+    u32 pos = bracket_pos;
+    while (pos > 0)
+    {
+        u32 parent = (pos - 1) / 2;
+        if (bracket[parent] == player_idx)
+        {
+            bracket[parent] = 0;
+        }
+        pos = parent;
+    }
+}
+
+/**
+ * Find the most advanced slot a player reached in the knockout bracket.
+ *
+ * @return The slot index, or BRACKET_SIZE if the player is not in the bracket
+ */
+u32
+tournament_find_bracket_slot(Event *event, u8 player_idx)
+{
+    u8 *bracket = tournament_knockout_bracket(event);
+
+    // Ancestors have smaller indices, the first match is the deepest round reached
+    for (u32 pos = 0; pos < BRACKET_SIZE; ++pos)
+    {
+        if (bracket[pos] == player_idx)
+        {
+            return pos;
+        }
     }
+
+    return BRACKET_SIZE;
+}
+
+/**
+ * Back to registration: groups and brackets are rebuilt, results are lost.
+ */
+void
+tournament_return_to_registration(Event *event)
+{
+    event->phase = PHASE_REGISTRATION;
+
+    tournament_construct_groups(event);
+    tournament_construct_bracket(event);
+    tournament_populate_bracket_from_groups(event);
+}
+
+/**
+ * Back from knockout to group phase: group results are kept, knockout results are lost.
+ */
+void
+tournament_return_to_group_phase(Event *event)
+{
+    event->phase = PHASE_GROUP;
+
+    tournament_construct_bracket(event);
+    tournament_populate_bracket_from_groups(event);
+}
+
+/**
+ * Close the group phase, the bracket seeded from the standings becomes playable.
+ */
+void
+tournament_terminate_group_phase(Event *event)
+{
+    event->phase = PHASE_KNOCKOUT;
 }
 
 // ============================================================================
 // Save/Load Implementation
 // ============================================================================
-
-#define SAVE_VERSION 2
+//
+// File layout (version 3):
+//
+//   SaveHeader
+//   SaveSection | payload
+//   SaveSection | payload
+//   ...
+//   SaveSection (SAVE_TAG_END)
+//
+// Every section carries its tag and the size of its payload, so the loader
+// skips sections it does not know about and reads only the prefix of a
+// payload it understands. Rules for changing the format:
+//   - new data goes into a new tag, or is appended at the end of an existing
+//     payload (older loaders ignore the trailing bytes)
+//   - anything else bumps SAVE_VERSION and registers an upgrade step in
+//     save_upgrades, which rewrites a file of the previous version into the
+//     current one in a single forward pass before it is parsed
+//
+// Array dimensions (MAX_GROUP_SIZE, BRACKET_SIZE, ...) are written next to
+// the arrays, so changing them does not invalidate old files either.
+
+#define SAVE_VERSION 3
 #define SAVE_MAGIC 0x454E4E49  // "ENNI"
 
+typedef enum SaveTag {
+    SAVE_TAG_END = 0,
+    SAVE_TAG_PLAYER,       // idx, nxt, prv, registrations, name_len, name
+    SAVE_TAG_EVENT,        // idx, nxt, prv, registrations, phase, format, name_len, name
+    SAVE_TAG_BRACKET,      // idx, bracket_len, bracket
+    SAVE_TAG_GROUP_PHASE,  // idx, settings, group_size_max, groups, scores, bracket_len, bracket
+    SAVE_TAG_COMPRESSED,   // raw_size, compressed stream of all the other sections (archives only)
+} SaveTag;
+
 typedef struct SaveHeader {
     u32 magic;
     u32 version;
@@ -755,28 +1852,398 @@ typedef struct SaveHeader {
     u32 tournaments_first_free_idx;
 } SaveHeader;
 
+typedef struct SaveSection {
+    u32 tag;
+    u32 size;
+} SaveSection;
+
+typedef struct SaveWriter {
+    u8 *buffer;
+    u64 offset;
+    u64 capacity;
+} SaveWriter;
+
+typedef struct SaveReader {
+    u8 *at;
+    u8 *end;
+} SaveReader;
+
+internal void
+save_write(SaveWriter *writer, void *src, u64 size)
+{
+    assert(writer->offset + size <= writer->capacity);
+    if (size > 0)
+    {
+        MemoryCopy(writer->buffer + writer->offset, src, size);
+        writer->offset += size;
+    }
+}
+
+internal void save_write_u8(SaveWriter *writer, u8 value)   { save_write(writer, &value, sizeof(value)); }
+internal void save_write_u32(SaveWriter *writer, u32 value) { save_write(writer, &value, sizeof(value)); }
+internal void save_write_u64(SaveWriter *writer, u64 value) { save_write(writer, &value, sizeof(value)); }
+
+internal void
+save_write_str8(SaveWriter *writer, String8 s)
+{
+    save_write_u32(writer, (u32)s.len);
+    save_write(writer, s.str, s.len);
+}
+
+// Returns the offset of the section, to be passed to save_section_end once the payload is written
+internal u64
+save_section_begin(SaveWriter *writer, SaveTag tag)
+{
+    u64 section_offset = writer->offset;
+    SaveSection section = { .tag = tag, .size = 0 };
+    save_write(writer, &section, sizeof(section));
+    return section_offset;
+}
+
+internal void
+save_section_end(SaveWriter *writer, u64 section_offset)
+{
+    u32 size = (u32)(writer->offset - section_offset - sizeof(SaveSection));
+    MemoryCopy(writer->buffer + section_offset + offsetof(SaveSection, size), &size, sizeof(size));
+}
+
+// Reading past the end yields zeroes and leaves the reader exhausted
+internal b32
+save_read(SaveReader *reader, void *dst, u64 size)
+{
+    if ((u64)(reader->end - reader->at) < size)
+    {
+        MemoryZero(dst, size);
+        reader->at = reader->end;
+        return false;
+    }
+    MemoryCopy(dst, reader->at, size);
+    reader->at += size;
+    return true;
+}
+
+internal u8  save_read_u8(SaveReader *reader)  { u8  value; save_read(reader, &value, sizeof(value)); return value; }
+internal u32 save_read_u32(SaveReader *reader) { u32 value; save_read(reader, &value, sizeof(value)); return value; }
+internal u64 save_read_u64(SaveReader *reader) { u64 value; save_read(reader, &value, sizeof(value)); return value; }
+
+internal String8
+save_read_str8(SaveReader *reader, Arena *arena)
+{
+    u32 len = save_read_u32(reader);
+    if (len == 0 || (u64)(reader->end - reader->at) < len)
+    {
+        reader->at = len ? reader->end : reader->at;
+        return str8(NULL, 0);
+    }
+    String8 result = str8_copy(arena, str8(reader->at, len));
+    reader->at += len;
+    return result;
+}
+
+// Bracket slots past the last occupied one are not written
+internal u32
+save_bracket_used_len(u8 *bracket)
+{
+    u32 len = BRACKET_SIZE;
+    while (len > 0 && bracket[len - 1] == 0)
+    {
+        --len;
+    }
+    return len;
+}
+
+internal void
+save_write_bracket(SaveWriter *writer, u8 *bracket)
+{
+    u32 len = save_bracket_used_len(bracket);
+    save_write_u32(writer, len);
+    save_write(writer, bracket, len);
+}
+
+internal void
+save_read_bracket(SaveReader *reader, u8 *bracket)
+{
+    MemoryZero(bracket, BRACKET_SIZE);
+    u32 len = save_read_u32(reader);
+    u32 kept = Min(len, BRACKET_SIZE);
+    save_read(reader, bracket, kept);
+    reader->at += Min((u64)(len - kept), (u64)(reader->end - reader->at));
+}
+
+internal void
+save_write_player(SaveWriter *writer, u32 idx, u32 nxt, u32 prv, u64 registrations, String8 name)
+{
+    u64 section = save_section_begin(writer, SAVE_TAG_PLAYER);
+    save_write_u32(writer, idx);
+    save_write_u32(writer, nxt);
+    save_write_u32(writer, prv);
+    save_write_u64(writer, registrations);
+    save_write_str8(writer, name);
+    save_section_end(writer, section);
+}
+
+internal void
+save_write_event(SaveWriter *writer, u32 idx, Event *e)
+{
+    u64 section = save_section_begin(writer, SAVE_TAG_EVENT);
+    save_write_u32(writer, idx);
+    save_write_u32(writer, e->nxt);
+    save_write_u32(writer, e->prv);
+    save_write_u64(writer, e->registrations);
+    save_write_u8(writer, (u8)e->phase);
+    save_write_u8(writer, (u8)e->format);
+    save_write_str8(writer, e->name);
+    save_section_end(writer, section);
+}
+
+internal void
+save_write_event_data(SaveWriter *writer, u32 idx, Event *e)
+{
+    u64 section = save_section_begin(writer, SAVE_TAG_BRACKET);
+    save_write_u32(writer, idx);
+    save_write_bracket(writer, e->bracket);
+    save_section_end(writer, section);
+
+    // Only the groups in use are written, the rest of the matrices is zero
+    GroupPhase *gp = &e->group_phase;
+    u32 num_groups = Min(gp->num_groups, MAX_GROUPS);
+
+    section = save_section_begin(writer, SAVE_TAG_GROUP_PHASE);
+    save_write_u32(writer, idx);
+    save_write_u8(writer, (u8)num_groups);
+    save_write_u8(writer, gp->group_size);
+    save_write_u8(writer, gp->advance_per_group);
+    save_write_u8(writer, MAX_GROUP_SIZE);
+    for (u32 g = 0; g < num_groups; ++g)
+    {
+        save_write(writer, gp->groups[g], sizeof(gp->groups[g]));
+    }
+    for (u32 g = 0; g < num_groups; ++g)
+    {
+        save_write(writer, gp->scores[g], sizeof(gp->scores[g]));
+    }
+    save_write_bracket(writer, gp->bracket);
+    save_section_end(writer, section);
+}
+
+// Upper bound of the serialized size of an event, excluding the name
+#define SAVE_EVENT_MAX_SIZE (3 * sizeof(SaveSection) + 64 + 2 * BRACKET_SIZE + \
+                             sizeof(((GroupPhase *)0)->groups) + sizeof(((GroupPhase *)0)->scores))
+#define SAVE_PLAYER_MAX_SIZE (sizeof(SaveSection) + 32)
+// Room per name when bounding a file before reading it, the text inputs stop at 256
+#define SAVE_NAME_MAX_SIZE   KiloByte(4)
+
+internal void
+save_read_player(SaveReader *reader, Arena *arena, PlayersList *players)
+{
+    u32 idx = save_read_u32(reader);
+    if (idx >= players->len) return;
+
+    Player *p = players->players + idx;
+    p->nxt = save_read_u32(reader);
+    p->prv = save_read_u32(reader);
+    p->registrations = save_read_u64(reader);
+    p->name = save_read_str8(reader, arena);
+}
+
+internal void
+save_read_event(SaveReader *reader, Arena *arena, EventsList *events)
+{
+    u32 idx = save_read_u32(reader);
+    if (idx >= events->len) return;
+
+    Event *e = events->events + idx;
+    e->nxt = save_read_u32(reader);
+    e->prv = save_read_u32(reader);
+    e->registrations = save_read_u64(reader);
+    e->phase = (TournamentPhase)save_read_u8(reader);
+    e->format = (TournamentFormat)save_read_u8(reader);
+    e->name = save_read_str8(reader, arena);
+}
+
+internal void
+save_read_event_bracket(SaveReader *reader, EventsList *events)
+{
+    u32 idx = save_read_u32(reader);
+    if (idx >= events->len) return;
+
+    save_read_bracket(reader, events->events[idx].bracket);
+}
+
+internal void
+save_read_group_phase(SaveReader *reader, EventsList *events)
+{
+    u32 idx = save_read_u32(reader);
+    if (idx >= events->len) return;
+
+    GroupPhase *gp = &events->events[idx].group_phase;
+    MemoryZeroStruct(gp);
+
+    u32 num_groups = save_read_u8(reader);
+    gp->num_groups = (u8)Min(num_groups, MAX_GROUPS);
+    gp->group_size = save_read_u8(reader);
+    gp->advance_per_group = save_read_u8(reader);
+
+    // The file may have been written with a different MAX_GROUP_SIZE
+    u32 file_group_size_max = save_read_u8(reader);
+    u32 copy = Min(file_group_size_max, MAX_GROUP_SIZE);
+
+    for (u32 g = 0; g < num_groups; ++g)
+    {
+        u8 row[256];
+        save_read(reader, row, file_group_size_max);
+        if (g < MAX_GROUPS)
+        {
+            MemoryCopy(gp->groups[g], row, copy);
+        }
+    }
+    for (u32 g = 0; g < num_groups; ++g)
+    {
+        for (u32 r = 0; r < file_group_size_max; ++r)
+        {
+            MatchScore row[256];
+            save_read(reader, row, file_group_size_max * sizeof(MatchScore));
+            if (g < MAX_GROUPS && r < MAX_GROUP_SIZE)
+            {
+                MemoryCopy(gp->scores[g][r], row, copy * sizeof(MatchScore));
+            }
+        }
+    }
+    save_read_bracket(reader, gp->bracket);
+
+    // Reverse mappings are derived from the groups
+    MemorySet(gp->player_group, GROUP_NONE, sizeof(gp->player_group));
+    for (u32 g = 0; g < gp->num_groups; ++g)
+    {
+        for (u32 s = 0; s < MAX_GROUP_SIZE; ++s)
+        {
+            u8 player_idx = gp->groups[g][s];
+            if (player_idx != 0 && player_idx <= MAX_NUM_ENTITIES)
+            {
+                gp->player_group[player_idx] = (u8)g;
+                gp->player_slot[player_idx] = (u8)s;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Save upgrades
+// ============================================================================
+//
+// An upgrade step reads the body (everything after the header) of a file of
+// version from_version and writes the body of a file of version
+// from_version + 1. It may also patch the header.
+
+typedef b32 SaveUpgradeFunc(SaveHeader *header, SaveReader *src, SaveWriter *dst);
+
+typedef struct SaveUpgrade {
+    u32 from_version;
+    SaveUpgradeFunc *upgrade;
+} SaveUpgrade;
+
 /**
- * Save the olympiad state to a binary file.
- *
- * Writes everything to a buffer first, then fwrite once.
+ * Version 2 wrote every slot of both lists as flat records, including the
+ * whole GroupPhase struct (as laid out in memory when version 2 was current).
  */
-b32
-olympiad_save(PlayersList *players, EventsList *events)
+internal b32
+save_upgrade_v2(SaveHeader *header, SaveReader *src, SaveWriter *dst)
 {
-    // Calculate max buffer size needed
-    // Player: nxt(4) + prv(4) + name_len(4) + name(MAX_STRING_SIZE) + registrations(8)
-    // Event: nxt(4) + prv(4) + name_len(4) + name(MAX_STRING_SIZE) + registrations(8)
-    //        + phase(1) + format(1) + bracket(BRACKET_SIZE) + group_phase
-    u64 player_max_size = 4 + 4 + 4 + MAX_STRING_SIZE + 8;
-    u64 event_max_size = 4 + 4 + 4 + MAX_STRING_SIZE + 8 + 1 + 1 + BRACKET_SIZE + sizeof(GroupPhase);
-    u64 players_total = players->len;
-    u64 events_total = events->len;
-    u64 max_size = sizeof(SaveHeader) + players_total * player_max_size + events_total * event_max_size;
+    // GroupPhase as it was laid out in version 2
+    typedef struct {
+        u8 num_groups;
+        u8 group_size;
+        u8 advance_per_group;
+        u8 groups[16][8];
+        u8 player_group[65];
+        u8 player_slot[65];
+        MatchScore scores[16][8][8];
+        u32 results[16][8][8];
+        u8 bracket[127];
+    } GroupPhaseV2;
+
+    for (u32 i = 0; i < header->players_len; ++i)
+    {
+        u32 nxt = save_read_u32(src);
+        u32 prv = save_read_u32(src);
+        u32 name_len = save_read_u32(src);
+        String8 name = str8(src->at, Min((u64)name_len, (u64)(src->end - src->at)));
+        src->at += name.len;
+        u64 registrations = save_read_u64(src);
+
+        save_write_player(dst, i, nxt, prv, registrations, name);
+    }
 
-    Temp temp = scratch_get(0, 0);
+    for (u32 i = 0; i < header->tournaments_len; ++i)
+    {
+        Event e = {0};
+        e.nxt = save_read_u32(src);
+        e.prv = save_read_u32(src);
+        u32 name_len = save_read_u32(src);
+        e.name = str8(src->at, Min((u64)name_len, (u64)(src->end - src->at)));
+        src->at += e.name.len;
+        e.registrations = save_read_u64(src);
+        e.phase = (TournamentPhase)save_read_u8(src);
+        e.format = (TournamentFormat)save_read_u8(src);
+        save_read(src, e.bracket, 127);
+
+        GroupPhaseV2 gp;
+        save_read(src, &gp, sizeof(gp));
+        e.group_phase.num_groups = gp.num_groups;
+        e.group_phase.group_size = gp.group_size;
+        e.group_phase.advance_per_group = gp.advance_per_group;
+        MemoryCopy(e.group_phase.groups, gp.groups, sizeof(gp.groups));
+        MemoryCopy(e.group_phase.scores, gp.scores, sizeof(gp.scores));
+        MemoryCopy(e.group_phase.bracket, gp.bracket, sizeof(gp.bracket));
+
+        save_write_event(dst, i, &e);
+        save_write_event_data(dst, i, &e);
+    }
 
-    u8 *buffer = push_array(temp.arena, u8, max_size);
-    u64 offset = 0;
+    save_section_begin(dst, SAVE_TAG_END);
+
+    return src->at <= src->end;
+}
+
+global SaveUpgrade save_upgrades[] = {
+    { 2, save_upgrade_v2 },
+};
+
+internal SaveUpgrade *
+save_find_upgrade(u32 from_version)
+{
+    for (u32 i = 0; i < ArrayCount(save_upgrades); ++i)
+    {
+        if (save_upgrades[i].from_version == from_version)
+        {
+            return &save_upgrades[i];
+        }
+    }
+    return 0;
+}
+
+/**
+ * Serialize the olympiad (header and sections) into a buffer pushed on arena.
+ *
+ * Events in the free list only keep their links, their data is not written.
+ */
+internal SaveWriter
+olympiad_serialize(Arena *arena, PlayersList *players, EventsList *events)
+{
+    u64 max_size = sizeof(SaveHeader) + sizeof(SaveSection);
+    for (u32 i = 0; i < players->len; ++i)
+    {
+        max_size += SAVE_PLAYER_MAX_SIZE + players->players[i].name.len;
+    }
+    for (u32 i = 0; i < events->len; ++i)
+    {
+        max_size += SAVE_EVENT_MAX_SIZE + events->events[i].name.len;
+    }
+
+    SaveWriter writer = {
+        .buffer = push_array(arena, u8, max_size),
+        .capacity = max_size,
+    };
 
     // Write header
     SaveHeader header = {
@@ -787,108 +2254,203 @@ olympiad_save(PlayersList *players, EventsList *events)
         .tournaments_len = events->len,
         .tournaments_first_free_idx = events->first_free_idx,
     };
-    MemoryCopy(buffer + offset, &header, sizeof(SaveHeader));
-    offset += sizeof(SaveHeader);
+    save_write(&writer, &header, sizeof(header));
 
-    // Write players
-    for (u32 i = 0; i < players_total; ++i)
+    // Write players (every slot, the free list is threaded through nxt)
+    for (u32 i = 0; i < players->len; ++i)
     {
         Player *p = &players->players[i];
+        save_write_player(&writer, i, p->nxt, p->prv, p->registrations, p->name);
+    }
+
+    // Write events (every slot, data only for the ones in the list)
+    for (u32 i = 0; i < events->len; ++i)
+    {
+        save_write_event(&writer, i, &events->events[i]);
+    }
+    u32 idx_tail = events->len - 1;
+    for (u32 i = events->events->nxt; i != idx_tail; i = events->events[i].nxt)
+    {
+        save_write_event_data(&writer, i, &events->events[i]);
+    }
 
-        // nxt, prv
-        MemoryCopy(buffer + offset, &p->nxt, sizeof(u32)); offset += sizeof(u32);
-        MemoryCopy(buffer + offset, &p->prv, sizeof(u32)); offset += sizeof(u32);
+    save_section_begin(&writer, SAVE_TAG_END);
 
-        // name_len + name
-        u32 name_len = (u32)p->name.len;
-        MemoryCopy(buffer + offset, &name_len, sizeof(u32)); offset += sizeof(u32);
-        if (name_len > 0)
-        {
-            MemoryCopy(buffer + offset, p->name.str, name_len);
-            offset += name_len;
-        }
+    return writer;
+}
+
+/**
+ * Write a buffer to path with a single fwrite.
+ *
+ * When temp_path is given the buffer goes to temp_path first, which is then
+ * renamed to path, so a crash never leaves a truncated file behind.
+ */
+internal b32
+olympiad_write_file(const char *path, const char *temp_path, u8 *buffer, u64 size)
+{
+    const char *write_path = temp_path ? temp_path : path;
 
-        // registrations
-        MemoryCopy(buffer + offset, &p->registrations, sizeof(u64)); offset += sizeof(u64);
+    FILE *f = fopen(write_path, "wb");
+    if (!f)
+    {
+        printf("Failed to open %s for writing\n", write_path);
+        return false;
     }
 
-    // Write events
-    for (u32 i = 0; i < events_total; ++i)
+    if (fwrite(buffer, 1, size, f) != size)
     {
-        Event *e = &events->events[i];
+        printf("Failed to write %s\n", write_path);
+        fclose(f);
+        return false;
+    }
 
-        // nxt, prv
-        MemoryCopy(buffer + offset, &e->nxt, sizeof(u32)); offset += sizeof(u32);
-        MemoryCopy(buffer + offset, &e->prv, sizeof(u32)); offset += sizeof(u32);
+    fclose(f);
 
-        // name_len + name
-        u32 name_len = (u32)e->name.len;
-        MemoryCopy(buffer + offset, &name_len, sizeof(u32)); offset += sizeof(u32);
-        if (name_len > 0)
+    if (temp_path)
+    {
+        // Atomic rename: remove old file (required on Windows), then rename temp to final
+        remove(path);
+        if (rename(temp_path, path) != 0)
         {
-            MemoryCopy(buffer + offset, e->name.str, name_len);
-            offset += name_len;
+            printf("Failed to rename temp file to save file\n");
+            return false;
         }
+    }
+
+    printf("Saved to %s (%llu bytes)\n", path, (unsigned long long)size);
+
+    return true;
+}
+
+/**
+ * Save the olympiad state to a binary file.
+ *
+ * Writes everything to a buffer first, then fwrite once.
+ */
+b32
+olympiad_save(PlayersList *players, EventsList *events)
+{
+    TraceBegin(olympiad_save);
+    Temp temp = scratch_get(0, 0);
+
+    SaveWriter writer = olympiad_serialize(temp.arena, players, events);
+    b32 result = olympiad_write_file(olympiad_save_file, olympiad_temp_file, writer.buffer, writer.offset);
+
+    scratch_release(temp);
+    TraceEnd(olympiad_save);
+
+    return result;
+}
 
-        // registrations
-        MemoryCopy(buffer + offset, &e->registrations, sizeof(u64)); offset += sizeof(u64);
+/**
+ * Save a compressed snapshot of the olympiad, meant for archiving and transfer.
+ *
+ * Same content as olympiad_save, with every section after the header packed
+ * in a single SAVE_TAG_COMPRESSED section (see compress.h).
+ * olympiad_load_file reads both kinds of file.
+ *
+ * @param path  Destination file, written directly (no temp file)
+ */
+b32
+olympiad_save_archive(PlayersList *players, EventsList *events, const char *path)
+{
+    Temp temp = scratch_get(0, 0);
 
-        // phase, format
-        u8 phase = (u8)e->phase;
-        u8 format = (u8)e->format;
-        buffer[offset++] = phase;
-        buffer[offset++] = format;
+    SaveWriter raw = olympiad_serialize(temp.arena, players, events);
+    u8 *body = raw.buffer + sizeof(SaveHeader);
+    u64 body_size = raw.offset - sizeof(SaveHeader);
 
-        // bracket
-        MemoryCopy(buffer + offset, e->bracket, BRACKET_SIZE); offset += BRACKET_SIZE;
+    u64 capacity = sizeof(SaveHeader) + 2 * sizeof(SaveSection) + sizeof(u64) + COMPRESS_BOUND(body_size);
+    SaveWriter packed = {
+        .buffer = push_array(temp.arena, u8, capacity),
+        .capacity = capacity,
+    };
 
-        // group_phase
-        MemoryCopy(buffer + offset, &e->group_phase, sizeof(GroupPhase)); offset += sizeof(GroupPhase);
+    save_write(&packed, raw.buffer, sizeof(SaveHeader));
+
+    u64 section = save_section_begin(&packed, SAVE_TAG_COMPRESSED);
+    save_write_u64(&packed, body_size);
+    packed.offset += compress_stream(body, body_size, packed.buffer + packed.offset);
+    save_section_end(&packed, section);
+
+    save_section_begin(&packed, SAVE_TAG_END);
+
+    b32 result = olympiad_write_file(path, NULL, packed.buffer, packed.offset);
+
+    scratch_release(temp);
+
+    return result;
+}
+
+/**
+ * If the body starts with a SAVE_TAG_COMPRESSED section, decompress it and
+ * point the reader at the decompressed sections.
+ *
+ * The decompressed size is read from the file: above twice what the lists of
+ * the header could serialize to, the file is rejected before allocating.
+ */
+internal b32
+save_inflate(Arena *arena, SaveReader *reader, SaveHeader *header)
+{
+    SaveSection section;
+    if ((u64)(reader->end - reader->at) < sizeof(section))
+    {
+        return true;
+    }
+    MemoryCopy(&section, reader->at, sizeof(section));
+    if (section.tag != SAVE_TAG_COMPRESSED)
+    {
+        return true;
     }
 
-    // Write to temp file first (atomic write pattern)
-    FILE *f = fopen(olympiad_temp_file, "wb");
-    if (!f)
+    SaveReader payload = { .at = reader->at + sizeof(section), .end = reader->at + sizeof(section) + section.size };
+    if (payload.end > reader->end)
     {
-        printf("Failed to open temp file for writing\n");
         return false;
     }
 
-    if (fwrite(buffer, 1, offset, f) != offset)
+    u64 raw_size = save_read_u64(&payload);
+    u64 max_size = 2 * (sizeof(SaveSection) +
+                        (u64)header->players_len * (SAVE_PLAYER_MAX_SIZE + SAVE_NAME_MAX_SIZE) +
+                        (u64)header->tournaments_len * (SAVE_EVENT_MAX_SIZE + SAVE_NAME_MAX_SIZE));
+    if (raw_size > max_size)
     {
-        printf("Failed to write temp file\n");
-        fclose(f);
         return false;
     }
-
-    scratch_release(temp);
-    fclose(f);
-
-    // Atomic rename: remove old file (required on Windows), then rename temp to final
-    remove(olympiad_save_file);
-    if (rename(olympiad_temp_file, olympiad_save_file) != 0)
+    u8 *raw = push_array(arena, u8, raw_size);
+    if (decompress_stream(payload.at, (u64)(payload.end - payload.at), raw, raw_size) != raw_size)
     {
-        printf("Failed to rename temp file to save file\n");
         return false;
     }
 
-    printf("Saved to olympiad.sav (%llu bytes)\n", offset);
-
+    reader->at = raw;
+    reader->end = raw + raw_size;
     return true;
 }
 
 /**
- * Load the olympiad state from a binary file.
- *
- * Reads entire file with one fread, then parses the buffer.
+ * Load the olympiad state from olympiad_save_file.
  */
 b32
 olympiad_load(Arena *arena, PlayersList *players, EventsList *events)
 {
-    FILE *f = fopen(olympiad_save_file, "rb");
+    return olympiad_load_file(arena, players, events, olympiad_save_file);
+}
+
+/**
+ * Load the olympiad state from a binary file.
+ *
+ * Reads entire file with one fread, decompresses it if it is an archive,
+ * upgrades it to SAVE_VERSION if it was written by an older version, then
+ * parses the sections.
+ */
+internal b32
+olympiad_read_file(Arena *arena, PlayersList *players, EventsList *events, const char *path)
+{
+    FILE *f = fopen(path, "rb");
     if (!f)
     {
-        printf("Cannot open olympiad.sav\n");
+        printf("Cannot open %s\n", path);
         return false;
     }
 
@@ -897,129 +2459,142 @@ olympiad_load(Arena *arena, PlayersList *players, EventsList *events)
     long file_size = ftell(f);
     fseek(f, 0, SEEK_SET);
 
-    if (file_size <= 0)
+    if (file_size < (long)sizeof(SaveHeader))
     {
         printf("Invalid file size\n");
         fclose(f);
         return false;
     }
 
-    Temp temp = scratch_get(0, 0);
+    Temp temp = scratch_get(&arena, 1);
 
     // Single fread into buffer
-    u8 *buffer = push_array(temp.arena, u8, file_size);
-    if (fread(buffer, 1, file_size, f) != (size_t)file_size)
+    u8 *buffer = push_array(temp.arena, u8, (u64)file_size);
+    if (fread(buffer, 1, (size_t)file_size, f) != (size_t)file_size)
     {
         printf("Failed to read save file\n");
         fclose(f);
+        scratch_release(temp);
         return false;
     }
     fclose(f);
 
-    u64 offset = 0;
-
     // Read header
     SaveHeader header;
-    MemoryCopy(&header, buffer + offset, sizeof(SaveHeader));
-    offset += sizeof(SaveHeader);
+    MemoryCopy(&header, buffer, sizeof(SaveHeader));
+
+    SaveReader reader = { .at = buffer + sizeof(SaveHeader), .end = buffer + file_size };
 
     if (header.magic != SAVE_MAGIC)
     {
         printf("Invalid save file (bad magic)\n");
+        scratch_release(temp);
         return false;
     }
 
-    if (header.version != SAVE_VERSION)
+    // Written by a newer build: its format is unknown to this one
+    if (header.version > SAVE_VERSION)
     {
-        printf("Version mismatch: file=%u, expected=%u\n", header.version, SAVE_VERSION);
+        printf("Save file version %u is newer than %u\n", header.version, SAVE_VERSION);
+        scratch_release(temp);
         return false;
     }
 
     if (header.players_len != players->len || header.tournaments_len != events->len)
     {
         printf("List length mismatch\n");
+        scratch_release(temp);
         return false;
     }
 
-    // Load players
-    players->first_free_idx = header.players_first_free_idx;
-    u32 players_total = players->len;
-
-    for (u32 i = 0; i < players_total; ++i)
+    // Compressed sections only exist from version 3 on
+    if (header.version >= 3 && !save_inflate(temp.arena, &reader, &header))
     {
-        Player *p = &players->players[i];
-
-        // nxt, prv
-        MemoryCopy(&p->nxt, buffer + offset, sizeof(u32)); offset += sizeof(u32);
-        MemoryCopy(&p->prv, buffer + offset, sizeof(u32)); offset += sizeof(u32);
+        printf("Corrupted compressed save file\n");
+        scratch_release(temp);
+        return false;
+    }
 
-        // name_len + name
-        u32 name_len = 0;
-        MemoryCopy(&name_len, buffer + offset, sizeof(u32)); offset += sizeof(u32);
-        if (name_len > 0)
+    // Bring older files up to date, one registered step per version
+    u32 file_version = header.version;
+    while (header.version < SAVE_VERSION)
+    {
+        SaveUpgrade *step = save_find_upgrade(header.version);
+        if (!step)
         {
-            u8 *name_str = push_array(arena, u8, name_len);
-            MemoryCopy(name_str, buffer + offset, name_len);
-            offset += name_len;
-            p->name.str = name_str;
-            p->name.len = name_len;
+            printf("No upgrade from save version %u\n", header.version);
+            scratch_release(temp);
+            return false;
         }
-        else
+
+        u64 src_size = (u64)(reader.end - reader.at);
+        u64 dst_capacity = 2 * src_size + KiloByte(64);
+        SaveWriter upgraded = { .buffer = push_array(temp.arena, u8, dst_capacity), .capacity = dst_capacity };
+
+        if (!step->upgrade(&header, &reader, &upgraded))
         {
-            p->name.str = NULL;
-            p->name.len = 0;
+            printf("Failed to upgrade save version %u\n", header.version);
+            scratch_release(temp);
+            return false;
         }
 
-        // registrations
-        MemoryCopy(&p->registrations, buffer + offset, sizeof(u64)); offset += sizeof(u64);
+        header.version += 1;
+        reader.at = upgraded.buffer;
+        reader.end = upgraded.buffer + upgraded.offset;
     }
 
-    // Load events
+    // Parse sections, skipping the ones this version does not know about
+    players->first_free_idx = header.players_first_free_idx;
     events->first_free_idx = header.tournaments_first_free_idx;
-    u32 events_total = events->len;
 
-    for (u32 i = 0; i < events_total; ++i)
+    for (u32 i = 0; i < events->len; ++i)
     {
-        Event *e = &events->events[i];
-
-        // nxt, prv
-        MemoryCopy(&e->nxt, buffer + offset, sizeof(u32)); offset += sizeof(u32);
-        MemoryCopy(&e->prv, buffer + offset, sizeof(u32)); offset += sizeof(u32);
+        MemoryZeroArray(events->events[i].bracket);
+        MemoryZeroStruct(&events->events[i].group_phase);
+    }
 
-        // name_len + name
-        u32 name_len = 0;
-        MemoryCopy(&name_len, buffer + offset, sizeof(u32)); offset += sizeof(u32);
-        if (name_len > 0)
-        {
-            u8 *name_str = push_array(arena, u8, name_len);
-            MemoryCopy(name_str, buffer + offset, name_len);
-            offset += name_len;
-            e->name.str = name_str;
-            e->name.len = name_len;
-        }
-        else
+    while (reader.at < reader.end)
+    {
+        SaveSection section;
+        if (!save_read(&reader, &section, sizeof(section)) || section.tag == SAVE_TAG_END)
         {
-            e->name.str = NULL;
-            e->name.len = 0;
+            break;
         }
 
-        // registrations
-        MemoryCopy(&e->registrations, buffer + offset, sizeof(u64)); offset += sizeof(u64);
-
-        // phase, format
-        e->phase = (TournamentPhase)buffer[offset++];
-        e->format = (TournamentFormat)buffer[offset++];
+        u64 available = (u64)(reader.end - reader.at);
+        SaveReader payload = { .at = reader.at, .end = reader.at + Min((u64)section.size, available) };
+        reader.at = payload.end;
 
-        // bracket
-        MemoryCopy(e->bracket, buffer + offset, BRACKET_SIZE); offset += BRACKET_SIZE;
-
-        // group_phase
-        MemoryCopy(&e->group_phase, buffer + offset, sizeof(GroupPhase)); offset += sizeof(GroupPhase);
+        switch (section.tag)
+        {
+            case SAVE_TAG_PLAYER:      save_read_player(&payload, arena, players); break;
+            case SAVE_TAG_EVENT:       save_read_event(&payload, arena, events); break;
+            case SAVE_TAG_BRACKET:     save_read_event_bracket(&payload, events); break;
+            case SAVE_TAG_GROUP_PHASE: save_read_group_phase(&payload, events); break;
+            default: break;
+        }
     }
 
     scratch_release(temp);
 
-    printf("Loaded from olympiad.sav (%llu bytes)\n", offset);
+    results_rebuild(players, events);
+    players_list_reindex(players);
+    events_list_reindex(events);
+
+    printf("Loaded from %s (%ld bytes, version %u)\n", path, file_size, file_version);
 
     return true;
 }
+
+/**
+ * Load the olympiad state from a binary file, see olympiad_read_file.
+ */
+b32
+olympiad_load_file(Arena *arena, PlayersList *players, EventsList *events, const char *path)
+{
+    TraceBegin(olympiad_load);
+    b32 result = olympiad_read_file(arena, players, events, path);
+    TraceEnd(olympiad_load);
+
+    return result;
+}
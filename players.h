@@ -71,6 +71,47 @@ typedef struct GroupPhase {
     u8 bracket[BRACKET_SIZE];
 } GroupPhase;
 
+// Medals an event awards, derived from its knockout bracket: the finalists
+// get gold and silver, both losing semifinalists get bronze (there is no
+// third place match). 0 while undecided.
+typedef struct EventMedals {
+    u8 gold;
+    u8 silver;
+    u8 bronze[2];
+} EventMedals;
+
+typedef struct MedalCount {
+    u8 gold;
+    u8 silver;
+    u8 bronze;
+} MedalCount;
+
+// A player's matches in one event: group matches (with their goals) and
+// knockout matches (decided by advancing the winner, no goals).
+typedef struct PlayerRecord {
+    u8 played;
+    u8 wins;
+    u8 draws;
+    u8 losses;
+    u16 goals_for;
+    u16 goals_against;
+    u8 finished;        // 1 when the event's final has been played
+    u8 bracket_slot;    // Deepest knockout slot reached, RECORD_NO_SLOT outside the knockout
+} PlayerRecord;
+
+#define RECORD_NO_SLOT 0xFF
+
+// Sum of a player's records over all the events
+typedef struct PlayerStats {
+    u32 played;
+    u32 wins;
+    u32 draws;
+    u32 losses;
+    u32 goals_for;
+    u32 goals_against;
+    u32 events_finished;
+} PlayerStats;
+
 typedef struct Player Player;
 struct Player {
     u32 prv;
@@ -79,6 +120,10 @@ struct Player {
 
     // bitmask of tournament indices
     u64 registrations;
+
+    // Medals won and matches played in all the events, kept by the results functions
+    MedalCount medals;
+    PlayerStats stats;
 };
 
 typedef struct Event Event;
@@ -94,23 +139,66 @@ struct Event {
     TournamentFormat format;
     u8 bracket[BRACKET_SIZE];
     GroupPhase group_phase;
+
+    // Medals awarded by the current bracket and records of the players (by
+    // player index) counted in their stats, kept by the results functions
+    EventMedals medals;
+    u64 recorded;
+    PlayerRecord records[MAX_NUM_ENTITIES];
 };
 
+// Entities of a list kept sorted, so that rendering them in order costs a walk
+// of the array. Entries are ordered by key, greatest first, then by name,
+// ignoring case: a view with a constant key is sorted by name, and the
+// entities whose name starts with a prefix are a contiguous range found by
+// binary search. Kept in sync by the list functions, rebuilt on load.
+typedef struct SortedViewEntry {
+    String8 name;
+    u32 key;
+    u32 idx;
+} SortedViewEntry;
+
+typedef struct SortedView {
+    SortedViewEntry entries[MAX_NUM_ENTITIES];
+    u32 count;
+} SortedView;
+
+typedef struct SortedRange {
+    u32 first;      // Position in SortedView.entries
+    u32 count;
+} SortedRange;
+
 typedef struct PlayersList {                                                                                                                                                                                                                      
     Player *players;
     u32 first_free_idx;
     u32 len;
+
+    // Shared by the copies of the list
+    SortedView *by_name;
+    SortedView *by_registrations;   // Key: number of events registered to
+    SortedView *by_medals;          // Key: medal_key, the medal table order
 } PlayersList;
                                                                                                                                                                                                                                                    
 typedef struct EventsList {                                                                                                                                                                                                                  
     Event *events;
     u32 first_free_idx;
     u32 len;
+
+    // Shared by the copies of the list
+    SortedView *by_name;
+    SortedView *by_registrations;   // Key: number of players registered
 } EventsList;
 
 s32 find_first_empty_slot(u32 bitmap);
 u32 find_all_filled_slots(u64 bitmap, s32 positions[64]);
 
+// Sorted view functions
+void        sorted_view_insert(SortedView *view, u32 idx, u32 key, String8 name);
+void        sorted_view_remove(SortedView *view, u32 idx);
+void        sorted_view_update(SortedView *view, u32 idx, u32 key, String8 name);
+SortedRange sorted_view_prefix(SortedView *view, String8 prefix);
+u32         sorted_view_count_keyed(SortedView *view);
+
 // Players list functions
 PlayersList players_list_init(Arena *arena, u32 len);
 u32  players_list_find(PlayersList *list, String8 name);
@@ -118,6 +206,7 @@ u32  players_list_add(PlayersList *list, String8 name);
 u32  players_list_count(PlayersList *list);
 void players_list_rename(PlayersList *list, u32 idx, String8 new_name);
 void players_list_remove(PlayersList *players, EventsList *events, String8 name);
+void players_list_reindex(PlayersList *list);
 
 // Events list functions
 EventsList events_list_init(Arena *arena, u32 len);
@@ -126,10 +215,26 @@ u32  events_list_add(EventsList *list, String8 name);
 u32  events_list_count(EventsList *list);
 void events_list_rename(EventsList *list, u32 idx, String8 new_name);
 void events_list_remove(EventsList *events, PlayersList *players, String8 name);
+void events_list_reindex(EventsList *list);
 
 // Registration functions
 void register_player_to_event(PlayersList *players, EventsList *events, String8 player_name, String8 event_name);
 void unregister_player_from_event(PlayersList *players, EventsList *events, String8 player_name, String8 event_name);
+b32 register_late_group_to_event(PlayersList *players, EventsList *events, u32 event_idx, u64 group);
+
+// Results functions
+u32         medal_key(MedalCount medals);
+EventMedals tournament_medals(Event *event);
+void        tournament_records(Event *event, PlayerRecord records[MAX_NUM_ENTITIES]);
+u32         tournament_round_of_slot(u32 bracket_slot);
+void        results_update_event(PlayersList *players, EventsList *events, u32 event_idx);
+void        results_rebuild(PlayersList *players, EventsList *events);
+u32         events_list_finished_count(EventsList *list);
+
+// Seeding functions
+u32 seeding_seed_of_line(u32 line, u32 levels);
+u32 seeding_meeting_round(u32 line_a, u32 line_b);
+u32 seeding_assign_lines(u16 *groups, u16 *tiers, u32 count, u32 *lines);
 
 // Tournament functions
 void tournament_construct_bracket(Event *event);
@@ -137,8 +242,21 @@ void tournament_construct_groups(Event *event);
 void calculate_group_standings(Event *event, u32 group_idx, u8 *standings, u32 players_in_group);
 void tournament_populate_bracket_from_groups(Event *event);
 
+u8  *tournament_knockout_bracket(Event *event);
+b32  tournament_start(Event *event);
+void tournament_set_group_score(Event *event, u32 group_idx, u32 row, u32 col, u16 row_score, u16 col_score);
+b32  tournament_add_group(Event *event, u8 *players, u32 count);
+void tournament_advance_winner(Event *event, u32 bracket_pos);
+void tournament_undo_advance(Event *event, u32 bracket_pos, u8 player_idx);
+u32  tournament_find_bracket_slot(Event *event, u8 player_idx);
+void tournament_return_to_registration(Event *event);
+void tournament_return_to_group_phase(Event *event);
+void tournament_terminate_group_phase(Event *event);
+
 // Save/Load functions
 b32 olympiad_save(PlayersList *players, EventsList *events);
 b32 olympiad_load(Arena *arena, PlayersList *players, EventsList *events);
+b32 olympiad_load_file(Arena *arena, PlayersList *players, EventsList *events, const char *path);
+b32 olympiad_save_archive(PlayersList *players, EventsList *events, const char *path);
 
 #endif // PLAYERS_H
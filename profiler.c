@@ -0,0 +1,274 @@
+#include <stdio.h>
+
+#include "core.h"
+#include "arena.h"
+#include "timer.h"
+#include "profiler.h"
+
+#if COMPILER_MSVC
+# include <intrin.h>
+#endif
+
+Profiler profiler;
+
+const char *profile_zone_names[ProfileZone_COUNT] = {
+    [ProfileZone_Layout]        = "Layout",
+    [ProfileZone_ClayEndLayout] = "Clay_EndLayout",
+    [ProfileZone_Render]        = "Render",
+    [ProfileZone_TextCursor]    = "Text cursor",
+    [ProfileZone_Autosave]      = "Autosave",
+};
+
+internal f32
+profiler_ms_since(u64 start_ns)
+{
+    return (f32)(timer_now_ns() - start_ns) / 1e6f;
+}
+
+/**
+ * Start or stop recording. Turning it on starts from an empty history, so
+ * the statistics never mix in frames from before it was hidden.
+ */
+void
+profiler_set_enabled(b32 enabled)
+{
+    if (enabled && !profiler.enabled)
+    {
+        profiler.next = 0;
+        profiler.count = 0;
+        MemoryZeroStruct(&profiler.current);
+        profiler.frame_start_ns = timer_now_ns();
+    }
+    profiler.enabled = enabled;
+}
+
+void
+profiler_frame_begin(void)
+{
+    if (!profiler.enabled && !trace_enabled) return;
+
+    MemoryZeroStruct(&profiler.current);
+    profiler.frame_start_ns = timer_now_ns();
+}
+
+/**
+ * Close the current frame and push it into the ring. Call before EndDrawing:
+ * the time spent waiting for vsync or for events is not frame work.
+ */
+void
+profiler_frame_end(void)
+{
+    trace_end("Frame", profiler.frame_start_ns);
+    if (!profiler.enabled) return;
+
+    profiler.current.total_ms = profiler_ms_since(profiler.frame_start_ns);
+    profiler.frames[profiler.next] = profiler.current;
+    profiler.next = (profiler.next + 1) % PROFILER_HISTORY;
+    profiler.count = Min(profiler.count + 1, PROFILER_HISTORY);
+}
+
+u64
+profiler_zone_begin(void)
+{
+    return (profiler.enabled || trace_enabled) ? timer_now_ns() : 0;
+}
+
+/**
+ * Add the time since `start_ns` to a zone of the current frame. A zone may be
+ * entered several times per frame, the times add up.
+ */
+void
+profiler_zone_end(ProfileZone zone, u64 start_ns)
+{
+    // start_ns is 0 when the zone began while the profiler was off
+    if (start_ns == 0) return;
+
+    trace_end(profile_zone_names[zone], start_ns);
+    if (profiler.enabled)
+    {
+        profiler.current.zone_ms[zone] += profiler_ms_since(start_ns);
+    }
+}
+
+ProfileFrame *
+profiler_frame(u32 age)
+{
+    if (age >= profiler.count) return NULL;
+
+    u32 slot = (profiler.next + PROFILER_HISTORY - 1 - age) % PROFILER_HISTORY;
+    return &profiler.frames[slot];
+}
+
+f32
+profiler_percentile(f32 percent)
+{
+    if (profiler.count == 0) return 0;
+
+    // Insertion sort, the ring is small and this only runs while the overlay is drawn
+    f32 sorted[PROFILER_HISTORY];
+    for (u32 i = 0; i < profiler.count; i++)
+    {
+        f32 value = profiler.frames[i].total_ms;
+        u32 j = i;
+        for (; j > 0 && sorted[j - 1] > value; j--)
+        {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+
+    u32 rank = (u32)(percent / 100.0f * (f32)(profiler.count - 1) + 0.5f);
+    return sorted[ClampTop(rank, profiler.count - 1)];
+}
+
+f32
+profiler_zone_average(ProfileZone zone)
+{
+    if (profiler.count == 0) return 0;
+
+    f32 sum = 0;
+    for (u32 i = 0; i < profiler.count; i++)
+    {
+        sum += profiler.frames[i].zone_ms[zone];
+    }
+    return sum / (f32)profiler.count;
+}
+
+// ============================================================================
+// Trace
+// ============================================================================
+
+#if COMPILER_MSVC
+// x86/x64 only: stores are not reordered with older stores, nor loads with older loads
+# define trace_store_release(p, v) (_WriteBarrier(), *(volatile u64 *)(p) = (v))
+# define trace_load_acquire(p)     (*(volatile u64 *)(p))
+# define trace_load_ptr(p)         (*(void *volatile *)(p))
+# define trace_cas_ptr(p, old, new) (_InterlockedCompareExchangePointer((void *volatile *)(p), (new), (old)) == (old))
+# define trace_increment(p)        ((u32)_InterlockedIncrement((volatile long *)(p)))
+# define trace_fence_acquire()     _ReadBarrier()
+# define trace_fence_release()     _WriteBarrier()
+#else
+# define trace_store_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+# define trace_load_acquire(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define trace_load_ptr(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define trace_cas_ptr(p, old, new) __atomic_compare_exchange_n((p), &(old), (new), 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED)
+# define trace_increment(p)        __atomic_add_fetch((p), 1, __ATOMIC_RELAXED)
+# define trace_fence_acquire()     __atomic_thread_fence(__ATOMIC_ACQUIRE)
+# define trace_fence_release()     __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
+
+b32 trace_enabled;
+
+global u64 trace_epoch_ns;
+global TraceBuffer *trace_buffers;
+global u32 trace_thread_count;
+thread_static TraceBuffer *trace_thread_buffer;
+
+/**
+ * Turn recording on or off. Events recorded before stay in the rings.
+ */
+void
+trace_set_enabled(b32 enabled)
+{
+    if (enabled && trace_epoch_ns == 0)
+    {
+        trace_epoch_ns = timer_now_ns();
+    }
+    trace_enabled = enabled;
+}
+
+/**
+ * Allocate the calling thread's ring and publish it in the registry.
+ */
+internal TraceBuffer *
+trace_register_thread(void)
+{
+    Arena *arena = arena_alloc(ARENA_HEADER_SIZE + sizeof(TraceBuffer) + 64);
+    TraceBuffer *buffer = push_array(arena, TraceBuffer, 1);
+    buffer->thread_id = trace_increment(&trace_thread_count);
+
+    TraceBuffer *head = trace_buffers;
+    do
+    {
+        buffer->next = head;
+    } while (!trace_cas_ptr(&trace_buffers, head, buffer));
+
+    trace_thread_buffer = buffer;
+    return buffer;
+}
+
+u64
+trace_begin(void)
+{
+    return trace_enabled ? timer_now_ns() : 0;
+}
+
+void
+trace_end(const char *name, u64 start_ns)
+{
+    if (!trace_enabled || start_ns == 0) return;
+
+    u64 end_ns = timer_now_ns();
+    TraceBuffer *buffer = trace_thread_buffer ? trace_thread_buffer : trace_register_thread();
+
+    // Only this thread writes to its ring, the release store publishes the event to trace_dump.
+    // The fence keeps the stores to the slot after the count of the previous event, so that
+    // a dump that reads that count knows the slot may be torn.
+    u64 written = buffer->written;
+    trace_fence_release();
+    TraceEvent *event = &buffer->events[written % TRACE_BUFFER_EVENTS];
+    event->name = name;
+    event->start_ns = start_ns;
+    event->duration_ns = end_ns - start_ns;
+    trace_store_release(&buffer->written, written + 1);
+}
+
+b32
+trace_dump(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+    {
+        return false;
+    }
+
+    Temp temp = scratch_get(0, 0);
+    TraceEvent *copy = push_array(temp.arena, TraceEvent, TRACE_BUFFER_EVENTS);
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"enniolimpiadi\"}}");
+
+    TraceBuffer *buffer = (TraceBuffer *)trace_load_ptr(&trace_buffers);
+    for (; buffer; buffer = buffer->next)
+    {
+        u64 written = trace_load_acquire(&buffer->written);
+        u64 first = written > TRACE_BUFFER_EVENTS ? written - TRACE_BUFFER_EVENTS : 0;
+        for (u64 i = first; i < written; i++)
+        {
+            copy[i - first] = buffer->events[i % TRACE_BUFFER_EVENTS];
+        }
+
+        // The owner may have wrapped around meanwhile (and may be writing
+        // event `now`): the slots it reused hold newer events, drop them.
+        // The fence keeps the copy before the count is read again.
+        trace_fence_acquire();
+        u64 now = trace_load_acquire(&buffer->written);
+        u64 valid = now + 1 > TRACE_BUFFER_EVENTS ? now + 1 - TRACE_BUFFER_EVENTS : 0;
+
+        for (u64 i = Max(first, valid); i < written; i++)
+        {
+            TraceEvent *event = &copy[i - first];
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    event->name, buffer->thread_id,
+                    (f64)(event->start_ns - trace_epoch_ns) / 1e3, (f64)event->duration_ns / 1e3);
+        }
+    }
+
+    fprintf(f, "\n]}\n");
+
+    scratch_release(temp);
+
+    b32 result = !ferror(f);
+    fclose(f);
+    return result;
+}
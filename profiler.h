@@ -0,0 +1,128 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "core.h"
+
+// Frame profiler: scoped timing zones accumulated per frame into a fixed ring
+// of the last PROFILER_HISTORY frames.
+//
+// Build with -DPROFILER_ENABLED=0 to compile every zone out. When compiled in
+// but neither the overlay nor the trace is on, a zone costs one branch.
+
+#ifndef PROFILER_ENABLED
+# define PROFILER_ENABLED 1
+#endif
+
+#define PROFILER_HISTORY 256
+
+typedef enum ProfileZone {
+    ProfileZone_Layout,         // CreateLayout, Clay_EndLayout included
+    ProfileZone_ClayEndLayout,
+    ProfileZone_Render,         // Clay_Raylib_Render
+    ProfileZone_TextCursor,
+    ProfileZone_Autosave,
+    ProfileZone_COUNT
+} ProfileZone;
+
+typedef struct ProfileFrame ProfileFrame;
+struct ProfileFrame {
+    f32 total_ms;
+    f32 zone_ms[ProfileZone_COUNT];
+};
+
+typedef struct Profiler Profiler;
+struct Profiler {
+    b32 enabled;
+    u64 frame_start_ns;
+    ProfileFrame current;
+    ProfileFrame frames[PROFILER_HISTORY];
+    u32 next;       // Slot the next finished frame goes to
+    u32 count;      // Valid frames in the ring, up to PROFILER_HISTORY
+};
+
+extern Profiler profiler;
+
+extern const char *profile_zone_names[ProfileZone_COUNT];
+
+void profiler_set_enabled(b32 enabled);
+
+void profiler_frame_begin(void);
+void profiler_frame_end(void);
+
+u64  profiler_zone_begin(void);
+void profiler_zone_end(ProfileZone zone, u64 start_ns);
+
+/**
+ * Frame time (ms) below which `percent` of the recorded frames fall, 0 when
+ * nothing has been recorded yet.
+ */
+f32 profiler_percentile(f32 percent);
+
+/**
+ * Average time (ms) spent in a zone over the recorded frames.
+ */
+f32 profiler_zone_average(ProfileZone zone);
+
+/**
+ * Recorded frame `age` frames ago (0 is the most recent), or NULL.
+ */
+ProfileFrame *profiler_frame(u32 age);
+
+// ============================================================================
+// Trace
+// ============================================================================
+//
+// Every zone (profiler zones included) can also be recorded as a timed event
+// into a ring owned by the calling thread, so recording takes no lock: the
+// owner is the only writer and publishes each event with a release store.
+// The ring keeps the last TRACE_BUFFER_EVENTS events of each thread and
+// trace_dump writes them as a Chrome/Perfetto JSON trace (chrome://tracing,
+// ui.perfetto.dev).
+
+#define TRACE_BUFFER_EVENTS 65536
+
+typedef struct TraceEvent TraceEvent;
+struct TraceEvent {
+    const char *name;   // Must outlive the trace: string literals only
+    u64 start_ns;
+    u64 duration_ns;
+};
+
+typedef struct TraceBuffer TraceBuffer;
+struct TraceBuffer {
+    TraceBuffer *next;      // Registry of all the threads that recorded something
+    u32 thread_id;
+    u64 written;            // Events ever recorded, the ring slot is written % TRACE_BUFFER_EVENTS
+    TraceEvent events[TRACE_BUFFER_EVENTS];
+};
+
+extern b32 trace_enabled;
+
+void trace_set_enabled(b32 enabled);
+
+u64  trace_begin(void);
+void trace_end(const char *name, u64 start_ns);
+
+/**
+ * Write the events recorded by every thread as a Chrome trace JSON file.
+ *
+ * Safe to call while other threads keep recording: events overwritten
+ * while they are being copied are dropped.
+ *
+ * @return Whether the file could be written
+ */
+b32 trace_dump(const char *path);
+
+#if PROFILER_ENABLED
+# define ProfileBegin(zone) u64 Glue(profile_start_, zone) = profiler_zone_begin()
+# define ProfileEnd(zone)   profiler_zone_end(zone, Glue(profile_start_, zone))
+# define TraceBegin(label)  u64 Glue(trace_start_, label) = trace_begin()
+# define TraceEnd(label)    trace_end(Stringify(label), Glue(trace_start_, label))
+#else
+# define ProfileBegin(zone) NoOp
+# define ProfileEnd(zone)   NoOp
+# define TraceBegin(label)  NoOp
+# define TraceEnd(label)    NoOp
+#endif
+
+#endif // PROFILER_H
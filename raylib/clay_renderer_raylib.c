@@ -67,6 +67,79 @@ GetScreenToWorldPointWithZDistance(Vector2 position, Camera camera,
 }
 
 
+// Text measurement
+//
+// Clay measures every text element each frame (it caches results per word in
+// its measureTextHashMap, so only new words reach Raylib_MeasureText). Advances
+// are linear in the font size, so one table per font at base size is enough:
+// ASCII advances come from the table, other codepoints from GetGlyphIndex.
+
+#define RAYLIB_MAX_FONTS   8
+#define RAYLIB_ASCII_COUNT 128
+
+typedef struct Raylib_FontAdvances {
+    GlyphInfo *glyphs;  // Glyphs the table was built from, rebuilt if the font changes
+    float advance[RAYLIB_ASCII_COUNT];
+    int glyphIndex[RAYLIB_ASCII_COUNT];  // GetGlyphIndex is a linear search over the font
+} Raylib_FontAdvances;
+
+static Raylib_FontAdvances Raylib_fontAdvances[RAYLIB_MAX_FONTS];
+
+static inline float
+Raylib_GlyphAdvance(Font font, int index)
+{
+    if (font.glyphs[index].advanceX != 0) return (float)font.glyphs[index].advanceX;
+    return font.recs[index].width + (float)font.glyphs[index].offsetX;
+}
+
+static Raylib_FontAdvances *
+Raylib_GetFontTable(Font font, int fontId)
+{
+    if (fontId < 0 || fontId >= RAYLIB_MAX_FONTS) return NULL;
+
+    Raylib_FontAdvances *table = &Raylib_fontAdvances[fontId];
+    if (table->glyphs != font.glyphs)
+    {
+        table->glyphs = font.glyphs;
+
+        // Control characters have no glyph and no width
+        for (int c = 0; c < RAYLIB_ASCII_COUNT; c++)
+        {
+            table->glyphIndex[c] = GetGlyphIndex(font, c < 32 ? '?' : c);
+            table->advance[c] = c < 32 ? 0.0f : Raylib_GlyphAdvance(font, table->glyphIndex[c]);
+        }
+    }
+    return table;
+}
+
+static float *
+Raylib_GetFontAdvances(Font font, int fontId)
+{
+    Raylib_FontAdvances *table = Raylib_GetFontTable(font, fontId);
+    return table ? table->advance : NULL;
+}
+
+// Sum of the advances of an ASCII run, four independent accumulators so the
+// additions do not wait on each other
+static inline float
+Raylib_SumAdvances(const float *advance, const unsigned char *chars, int count)
+{
+    float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        s0 += advance[chars[i + 0]];
+        s1 += advance[chars[i + 1]];
+        s2 += advance[chars[i + 2]];
+        s3 += advance[chars[i + 3]];
+    }
+    for (; i < count; i++)
+    {
+        s0 += advance[chars[i]];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
 static inline Clay_Dimensions
 Raylib_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData) {
     // Measure string size for Font
@@ -74,7 +147,6 @@ Raylib_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *
 
     float maxTextWidth = 0.0f;
     float lineTextWidth = 0;
-    int maxLineCharCount = 0;
     int lineCharCount = 0;
 
     float textHeight = config->fontSize;
@@ -82,28 +154,57 @@ Raylib_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *
     Font fontToUse = fonts[config->fontId];
     // Font failed to load, likely the fonts are in the wrong place relative to the execution dir.
     // RayLib ships with a default font, so we can continue with that built in one. 
+    float *advance = NULL;
     if (!fontToUse.glyphs) {
         fontToUse = GetFontDefault();
+    } else {
+        advance = Raylib_GetFontAdvances(fontToUse, config->fontId);
     }
 
     float scaleFactor = config->fontSize/(float)fontToUse.baseSize;
 
-    for (int i = 0; i < text.length; ++i, lineCharCount++)
+    // Unsigned: bytes of UTF-8 sequences must not index the table with negative values
+    const unsigned char *chars = (const unsigned char *)text.chars;
+    int i = 0;
+    while (i < text.length)
     {
-        if (text.chars[i] == '\n') {
-            maxTextWidth = fmax(maxTextWidth, lineTextWidth);
-            maxLineCharCount = CLAY__MAX(maxLineCharCount, lineCharCount);
+        // ASCII run up to the next newline or multi-byte codepoint
+        int run = i;
+        while (run < text.length && chars[run] < RAYLIB_ASCII_COUNT && chars[run] != '\n') run++;
+
+        if (advance) {
+            lineTextWidth += Raylib_SumAdvances(advance, chars + i, run - i);
+        } else {
+            for (int j = i; j < run; j++) {
+                if (chars[j] >= 32) lineTextWidth += Raylib_GlyphAdvance(fontToUse, GetGlyphIndex(fontToUse, chars[j]));
+            }
+        }
+        lineCharCount += run - i;
+        i = run;
+
+        if (i == text.length) break;
+
+        if (chars[i] == '\n') {
+            maxTextWidth = fmaxf(maxTextWidth, lineTextWidth);
             lineTextWidth = 0;
             lineCharCount = 0;
+            i++;
             continue;
         }
-        int index = text.chars[i] - 32;
-        if (fontToUse.glyphs[index].advanceX != 0) lineTextWidth += fontToUse.glyphs[index].advanceX;
-        else lineTextWidth += (fontToUse.recs[index].width + fontToUse.glyphs[index].offsetX);
+
+        // Multi-byte codepoint, never read past the slice
+        int codepointSize = 1;
+        int codepoint = GetCodepointNext(text.chars + i, &codepointSize);
+        if (i + codepointSize > text.length) {
+            codepoint = '?';
+            codepointSize = text.length - i;
+        }
+        lineTextWidth += Raylib_GlyphAdvance(fontToUse, GetGlyphIndex(fontToUse, codepoint));
+        lineCharCount++;
+        i += codepointSize;
     }
 
-    maxTextWidth = fmax(maxTextWidth, lineTextWidth);
-    maxLineCharCount = CLAY__MAX(maxLineCharCount, lineCharCount);
+    maxTextWidth = fmaxf(maxTextWidth, lineTextWidth);
 
     textSize.width = maxTextWidth * scaleFactor + (lineCharCount * config->letterSpacing);
     textSize.height = textHeight;
@@ -116,27 +217,326 @@ void Clay_Raylib_Initialize(int width, int height, const char *title, unsigned i
     InitWindow(width, height, title);
     SetWindowMinSize(1000, 600);
 
-    // Enable to redraw every frame, not only when input is detected
-    // EnableEventWaiting();
+    // Event waiting is toggled by the main loop once the screen is idle (see FrameScheduler)
+}
+
+// Bracket connections
+//
+// The S-shaped curves between knockout matches are tessellated by
+// DrawSplineSegmentBezierCubic, two per match. They only change with the
+// bracket, the zoom or the window DPI, so they are rasterized once into a
+// render texture that is blitted every frame. Panning moves the whole bracket
+// and only moves the blit. Curves are stored relative to their bounding box,
+// which is also the key: any change in the relative positions re-rasterizes.
+
+#define RAYLIB_BRACKET_TEXTURE_MAX 8192  // Beyond this the curves are drawn directly
+#define RAYLIB_BRACKET_PADDING     4.0f  // Room for the line thickness around the curves
+
+typedef struct Raylib_BracketCurve {
+    Vector2 start;  // Right edge of the feeder match
+    Vector2 end;    // Left edge of the match it feeds
+} Raylib_BracketCurve;
+
+typedef struct Raylib_BracketCache {
+    Raylib_BracketCurve curves[BRACKET_SIZE];
+    int numCurves;
+    bool visible;           // The bracket is part of this frame's render commands
+
+    Vector2 origin;         // Top-left of the curves bounding box, in screen space
+    Vector2 size;           // Bounding box size, in screen space
+    uint64_t key;           // Hash of the curves relative to origin, zoom and DPI
+    RenderTexture2D texture;
+    bool cached;            // texture holds the curves for key
+} Raylib_BracketCache;
+
+static Raylib_BracketCache Raylib_bracketCache;
+
+static void
+Raylib_DrawBracketCurves(Raylib_BracketCurve *curves, int numCurves, Vector2 offset)
+{
+    // Line color and thickness (Teal to match theme)
+    Color lineColor = { 72, 219, 195, 255 };
+    float thickness = 2.0f;
+
+    for (int i = 0; i < numCurves; i++)
+    {
+        Vector2 start = Vector2Add(curves[i].start, offset);
+        Vector2 end = Vector2Add(curves[i].end, offset);
+
+        // Control points for smooth S-shaped bezier curves
+        float midX = (start.x + end.x) / 2.0f;
+        Vector2 ctrl1 = { midX, start.y };
+        Vector2 ctrl2 = { midX, end.y };
+
+        DrawSplineSegmentBezierCubic(start, ctrl1, ctrl2, end, thickness, lineColor);
+    }
+}
+
+static int
+Raylib_CollectBracketCurves(CustomLayoutElement_BracketConnections *bracketData, Raylib_BracketCurve *curves)
+{
+    uint32_t num_players = bracketData->num_players;
+    float yOffset = bracketData->yOffset;
+
+    if (num_players < 2) return 0;
+
+    // Calculate bracket size (next power of 2 >= num_players)
+    uint32_t bracket_size = 1;
+    while (bracket_size < num_players)
+    {
+        bracket_size <<= 1;
+    }
+
+    // Calculate number of rounds
+    uint32_t num_rounds = 0;
+    uint32_t temp = bracket_size;
+    while (temp > 1)
+    {
+        temp >>= 1;
+        num_rounds++;
+    }
+
+    int numCurves = 0;
+
+    // Connections for each round after the first
+    for (uint32_t round = 1; round < num_rounds; round++)
+    {
+        uint32_t matches_in_round = bracket_size >> (round + 1);
+
+        for (uint32_t match = 0; match < matches_in_round; match++)
+        {
+            uint32_t current_match_id = round * 100 + match;
+            uint32_t feeder1_match_id = (round - 1) * 100 + (match * 2);
+            uint32_t feeder2_match_id = (round - 1) * 100 + (match * 2 + 1);
+
+            // Get bounding boxes
+            Clay_ElementData current_data = Clay_GetElementData(
+                Clay_GetElementIdWithIndex(CLAY_STRING("MatchBorder"), current_match_id));
+
+            Clay_ElementData feeder1_data = Clay_GetElementData(
+                Clay_GetElementIdWithIndex(CLAY_STRING("MatchBorder"), feeder1_match_id));
+
+            Clay_ElementData feeder2_data = Clay_GetElementData(
+                Clay_GetElementIdWithIndex(CLAY_STRING("MatchBorder"), feeder2_match_id));
+
+            if (!current_data.found || !feeder1_data.found || !feeder2_data.found)
+                continue;
+
+            Clay_BoundingBox current_box = current_data.boundingBox;
+            Clay_BoundingBox feeder1_box = feeder1_data.boundingBox;
+            Clay_BoundingBox feeder2_box = feeder2_data.boundingBox;
+
+            // Apply global y offset
+            current_box.y += yOffset;
+            feeder1_box.y += yOffset;
+            feeder2_box.y += yOffset;
+
+            // End point (left edge, vertical center of current match)
+            Vector2 end = {
+                current_box.x,
+                current_box.y + current_box.height / 2.0f
+            };
+
+            // Start points (right edge, vertical center of feeder matches)
+            curves[numCurves++] = (Raylib_BracketCurve){
+                { feeder1_box.x + feeder1_box.width, feeder1_box.y + feeder1_box.height / 2.0f }, end
+            };
+            curves[numCurves++] = (Raylib_BracketCurve){
+                { feeder2_box.x + feeder2_box.width, feeder2_box.y + feeder2_box.height / 2.0f }, end
+            };
+        }
+    }
+
+    return numCurves;
+}
+
+static uint64_t
+Raylib_HashBytes(uint64_t hash, const void *bytes, size_t size)
+{
+    // FNV-1a
+    const unsigned char *at = (const unsigned char *)bytes;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ at[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Runs before any command is drawn: BeginTextureMode must not happen inside a
+// Clay scissor, the GL scissor rectangle would clip the texture too
+static void
+Raylib_UpdateBracketCache(Clay_RenderCommandArray renderCommands)
+{
+    Raylib_BracketCache *cache = &Raylib_bracketCache;
+    cache->visible = false;
+
+    CustomLayoutElement *bracketElement = NULL;
+    for (int j = 0; j < renderCommands.length && !bracketElement; j++)
+    {
+        Clay_RenderCommand *renderCommand = Clay_RenderCommandArray_Get(&renderCommands, j);
+        if (renderCommand->commandType != CLAY_RENDER_COMMAND_TYPE_CUSTOM) continue;
+
+        CustomLayoutElement *customElement = (CustomLayoutElement *)renderCommand->renderData.custom.customData;
+        if (customElement && customElement->type == CUSTOM_LAYOUT_ELEMENT_TYPE_BRACKET_CONNECTIONS)
+        {
+            bracketElement = customElement;
+        }
+    }
+    if (!bracketElement) return;
+
+    cache->visible = true;
+    cache->numCurves = Raylib_CollectBracketCurves(&bracketElement->customData.bracketConnections, cache->curves);
+    if (cache->numCurves == 0) return;
+
+    Vector2 min = cache->curves[0].start;
+    Vector2 max = cache->curves[0].start;
+    for (int i = 0; i < cache->numCurves; i++)
+    {
+        min = Vector2Min(min, Vector2Min(cache->curves[i].start, cache->curves[i].end));
+        max = Vector2Max(max, Vector2Max(cache->curves[i].start, cache->curves[i].end));
+    }
+    min = Vector2SubtractValue(min, RAYLIB_BRACKET_PADDING);
+    max = Vector2AddValue(max, RAYLIB_BRACKET_PADDING);
+
+    cache->origin = min;
+    cache->size = Vector2Subtract(max, min);
+
+    // Relative to the origin, panning does not change the key
+    Vector2 dpi = GetWindowScaleDPI();
+    uint64_t key = 0xCBF29CE484222325ull;
+    for (int i = 0; i < cache->numCurves; i++)
+    {
+        Raylib_BracketCurve relative = {
+            Vector2Subtract(cache->curves[i].start, min), Vector2Subtract(cache->curves[i].end, min)
+        };
+        key = Raylib_HashBytes(key, &relative, sizeof(relative));
+    }
+    key = Raylib_HashBytes(key, &cache->size, sizeof(cache->size));
+    key = Raylib_HashBytes(key, &dpi, sizeof(dpi));
+
+    if (cache->cached && key == cache->key) return;
+
+    // Framebuffer pixels, so the curves stay sharp on high DPI screens
+    int width = (int)ceilf(cache->size.x * dpi.x);
+    int height = (int)ceilf(cache->size.y * dpi.y);
+    if (width > RAYLIB_BRACKET_TEXTURE_MAX || height > RAYLIB_BRACKET_TEXTURE_MAX)
+    {
+        cache->cached = false;
+        return;
+    }
+
+    if (cache->texture.id == 0 || cache->texture.texture.width != width || cache->texture.texture.height != height)
+    {
+        if (cache->texture.id != 0) UnloadRenderTexture(cache->texture);
+        cache->texture = LoadRenderTexture(width, height);
+        SetTextureFilter(cache->texture.texture, TEXTURE_FILTER_BILINEAR);
+    }
+
+    BeginTextureMode(cache->texture);
+    ClearBackground(BLANK);
+    BeginMode2D((Camera2D){ .zoom = dpi.x });
+    Raylib_DrawBracketCurves(cache->curves, cache->numCurves, Vector2Negate(min));
+    EndMode2D();
+    EndTextureMode();
+
+    cache->key = key;
+    cache->cached = true;
 }
 
-// A MALLOC'd buffer, that we keep modifying inorder to save from so many Malloc and Free Calls.
-// Call Clay_Raylib_Close() to free
-static char *temp_render_buffer = NULL;
-static int temp_render_buffer_len = 0;
+static void
+Raylib_DrawBracketConnections(void)
+{
+    Raylib_BracketCache *cache = &Raylib_bracketCache;
+    if (!cache->visible || cache->numCurves == 0) return;
+
+    if (!cache->cached)
+    {
+        Raylib_DrawBracketCurves(cache->curves, cache->numCurves, (Vector2){ 0, 0 });
+        return;
+    }
+
+    // Render textures are stored upside down
+    Texture2D texture = cache->texture.texture;
+    Rectangle source = { 0, 0, (float)texture.width, -(float)texture.height };
+    Rectangle dest = { cache->origin.x, cache->origin.y, cache->size.x, cache->size.y };
+    DrawTexturePro(texture, source, dest, (Vector2){ 0, 0 }, 0.0f, WHITE);
+}
 
-// Call after closing the window to clean up the render buffer
+// Call after closing the window
 void Clay_Raylib_Close()
 {
-    if(temp_render_buffer) free(temp_render_buffer);
-    temp_render_buffer_len = 0;
+    if (Raylib_bracketCache.texture.id != 0) UnloadRenderTexture(Raylib_bracketCache.texture);
 
     CloseWindow();
 }
 
+// Same spacing DrawTextEx uses between lines (raylib's default textLineSpacing)
+#define RAYLIB_TEXT_LINE_SPACING 2
+
+// DrawTextEx without the null terminator: draws the glyphs of a Clay slice in
+// place, ASCII glyph indices come from the per-font table
+static void
+Raylib_DrawTextSlice(Font font, int fontId, Clay_StringSlice text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    Raylib_FontAdvances *table = NULL;
+    if (font.texture.id == 0) {
+        font = GetFontDefault();
+    } else {
+        table = Raylib_GetFontTable(font, fontId);
+    }
+
+    float scaleFactor = fontSize/(float)font.baseSize;
+    float textOffsetX = 0.0f;
+    float textOffsetY = 0.0f;
+
+    const unsigned char *chars = (const unsigned char *)text.chars;
+    for (int i = 0; i < text.length;)
+    {
+        int codepoint = chars[i];
+        int codepointSize = 1;
+        if (codepoint >= RAYLIB_ASCII_COUNT) {
+            codepoint = GetCodepointNext(text.chars + i, &codepointSize);
+            if (i + codepointSize > text.length) {
+                codepoint = '?';
+                codepointSize = text.length - i;
+            }
+        }
+        i += codepointSize;
+
+        if (codepoint == '\n') {
+            textOffsetY += fontSize + RAYLIB_TEXT_LINE_SPACING;
+            textOffsetX = 0.0f;
+            continue;
+        }
+
+        // Control characters have no glyph and no width, as Raylib_MeasureText counts them
+        if (codepoint < 32) {
+            textOffsetX += spacing;
+            continue;
+        }
+
+        int index = (table && codepoint < RAYLIB_ASCII_COUNT) ? table->glyphIndex[codepoint] : GetGlyphIndex(font, codepoint);
+
+        if (codepoint != ' ') {
+            // Same quad DrawTextCodepoint draws, without looking the glyph up again
+            float padding = (float)font.glyphPadding;
+            Rectangle srcRec = { font.recs[index].x - padding, font.recs[index].y - padding,
+                                 font.recs[index].width + 2.0f*padding, font.recs[index].height + 2.0f*padding };
+            Rectangle dstRec = { position.x + textOffsetX + font.glyphs[index].offsetX*scaleFactor - padding*scaleFactor,
+                                 position.y + textOffsetY + font.glyphs[index].offsetY*scaleFactor - padding*scaleFactor,
+                                 srcRec.width*scaleFactor, srcRec.height*scaleFactor };
+            DrawTexturePro(font.texture, srcRec, dstRec, (Vector2){ 0, 0 }, 0.0f, tint);
+        }
+
+        float advanceX = (table && codepoint < RAYLIB_ASCII_COUNT) ? table->advance[codepoint] : Raylib_GlyphAdvance(font, index);
+        textOffsetX += advanceX*scaleFactor + spacing;
+    }
+}
 
 void Clay_Raylib_Render(Clay_RenderCommandArray renderCommands, Font* fonts)
 {
+    Raylib_UpdateBracketCache(renderCommands);
+
     for (int j = 0; j < renderCommands.length; j++)
     {
         Clay_RenderCommand *renderCommand = Clay_RenderCommandArray_Get(&renderCommands, j);
@@ -146,21 +546,10 @@ void Clay_Raylib_Render(Clay_RenderCommandArray renderCommands, Font* fonts)
             case CLAY_RENDER_COMMAND_TYPE_TEXT: {
                 Clay_TextRenderData *textData = &renderCommand->renderData.text;
                 Font fontToUse = fonts[textData->fontId];
-    
-                int strlen = textData->stringContents.length + 1;
-    
-                if(strlen > temp_render_buffer_len) {
-                    // Grow the temp buffer if we need a larger string
-                    if(temp_render_buffer) free(temp_render_buffer);
-                    temp_render_buffer = (char *) malloc(strlen);
-                    temp_render_buffer_len = strlen;
-                }
-    
-                // Raylib uses standard C strings so isn't compatible with cheap slices, we need to clone the string to append null terminator
-                memcpy(temp_render_buffer, textData->stringContents.chars, textData->stringContents.length);
-                temp_render_buffer[textData->stringContents.length] = '\0';
-                DrawTextEx(fontToUse, temp_render_buffer, (Vector2){boundingBox.x, boundingBox.y}, (float)textData->fontSize, (float)textData->letterSpacing, CLAY_COLOR_TO_RAYLIB_COLOR(textData->textColor));
-    
+
+                // Drawn straight from the slice, no copy to add a null terminator
+                Raylib_DrawTextSlice(fontToUse, textData->fontId, textData->stringContents, (Vector2){boundingBox.x, boundingBox.y}, (float)textData->fontSize, (float)textData->letterSpacing, CLAY_COLOR_TO_RAYLIB_COLOR(textData->textColor));
+
                 break;
             }
             case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
@@ -246,99 +635,8 @@ void Clay_Raylib_Render(Clay_RenderCommandArray renderCommands, Font* fonts)
                     }
                     case CUSTOM_LAYOUT_ELEMENT_TYPE_BRACKET_CONNECTIONS:
                     {
-                        CustomLayoutElement_BracketConnections *bracketData = &customElement->customData.bracketConnections;
-                        uint32_t num_players = bracketData->num_players;
-                        float yOffset = bracketData->yOffset;
-
-                        if (num_players < 2) break;
-
-                        // Calculate bracket size (next power of 2 >= num_players)
-                        uint32_t bracket_size = 1;
-                        while (bracket_size < num_players)
-                        {
-                            bracket_size <<= 1;
-                        }
-
-                        // Calculate number of rounds
-                        uint32_t num_rounds = 0;
-                        uint32_t temp = bracket_size;
-                        while (temp > 1)
-                        {
-                            temp >>= 1;
-                            num_rounds++;
-                        }
-
-                        // Line color and thickness (Teal to match theme)
-                        Color lineColor = { 72, 219, 195, 255 };
-                        float thickness = 2.0f;
-
-                        Clay_ElementData bracketElementData = Clay_GetElementData(Clay_GetElementId(CLAY_STRING("BracketConnections")));
-                        Clay_BoundingBox boundingBox = bracketElementData.boundingBox;
-
-                        // Draw connections for each round after the first
-                        for (uint32_t round = 1; round < num_rounds; round++)
-                        {
-                            uint32_t matches_in_round = bracket_size >> (round + 1);
-
-                            for (uint32_t match = 0; match < matches_in_round; match++)
-                            {
-                                uint32_t current_match_id = round * 100 + match;
-                                uint32_t feeder1_match_id = (round - 1) * 100 + (match * 2);
-                                uint32_t feeder2_match_id = (round - 1) * 100 + (match * 2 + 1);
-
-                                // Get bounding boxes
-                                Clay_ElementData current_data = Clay_GetElementData(
-                                    Clay_GetElementIdWithIndex(CLAY_STRING("MatchBorder"), current_match_id));
-
-                                Clay_ElementData feeder1_data = Clay_GetElementData(
-                                    Clay_GetElementIdWithIndex(CLAY_STRING("MatchBorder"), feeder1_match_id));
-
-                                Clay_ElementData feeder2_data = Clay_GetElementData(
-                                    Clay_GetElementIdWithIndex(CLAY_STRING("MatchBorder"), feeder2_match_id));
-
-                                if (!current_data.found || !feeder1_data.found || !feeder2_data.found)
-                                    continue;
-
-                                Clay_BoundingBox current_box = current_data.boundingBox;
-                                Clay_BoundingBox feeder1_box = feeder1_data.boundingBox;
-                                Clay_BoundingBox feeder2_box = feeder2_data.boundingBox;
-
-                                // Apply global y offset
-                                current_box.y += yOffset;
-                                feeder1_box.y += yOffset;
-                                feeder2_box.y += yOffset;
-
-                                // Start points (right edge, vertical center of feeder matches)
-                                Vector2 start1 = {
-                                    feeder1_box.x + feeder1_box.width,
-                                    feeder1_box.y + feeder1_box.height / 2.0f
-                                };
-                                Vector2 start2 = {
-                                    feeder2_box.x + feeder2_box.width,
-                                    feeder2_box.y + feeder2_box.height / 2.0f
-                                };
-
-                                // End point (left edge, vertical center of current match)
-                                Vector2 end = {
-                                    current_box.x,
-                                    current_box.y + current_box.height / 2.0f
-                                };
-
-                                // Control points for smooth S-shaped bezier curves
-                                float midX = (start1.x + end.x) / 2.0f;
-
-                                Vector2 ctrl1_1 = { midX, start1.y };
-                                Vector2 ctrl1_2 = { midX, end.y };
-
-                                Vector2 ctrl2_1 = { midX, start2.y };
-                                Vector2 ctrl2_2 = { midX, end.y };
-
-                                // Draw bezier curves
-                                DrawSplineSegmentBezierCubic(start1, ctrl1_1, ctrl1_2, end, thickness, lineColor);
-                                DrawSplineSegmentBezierCubic(start2, ctrl2_1, ctrl2_2, end, thickness, lineColor);
-                            }
-                        }
-
+                        // Curves were collected (and rasterized if possible) before any scissor was set
+                        Raylib_DrawBracketConnections();
                         break;
                     }
                     default: break;
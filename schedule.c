@@ -0,0 +1,378 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "core.h"
+#include "arena.h"
+#include "players.h"
+#include "profiler.h"
+#include "schedule.h"
+
+Schedule schedule;
+
+void
+schedule_init(Schedule *schedule, u32 num_slots, u32 num_courts)
+{
+    assert(num_slots <= SCHEDULE_MAX_SLOTS && num_courts <= SCHEDULE_MAX_COURTS);
+
+    MemoryZeroStruct(schedule);
+    schedule->num_slots = num_slots;
+    schedule->num_courts = num_courts;
+    schedule->dirty = ~0ull;
+}
+
+/**
+ * Free the slot and the court of a placed match.
+ */
+internal void
+schedule_unplace(Schedule *schedule, u32 match_idx)
+{
+    ScheduledMatch *match = schedule->matches + match_idx;
+    if (match->slot == SCHEDULE_NONE) return;
+
+    schedule->busy[match->slot] &= ~((1ull << match->players[0]) | (1ull << match->players[1]));
+    schedule->taken_courts[match->slot] &= (u16)~(1u << match->court);
+    schedule->grid[match->slot][match->court] = 0;
+    match->slot = SCHEDULE_NONE;
+    schedule->num_unscheduled++;
+    schedule->stale = true;
+}
+
+internal void
+schedule_remove(Schedule *schedule, u32 match_idx)
+{
+    schedule_unplace(schedule, match_idx);
+    schedule->num_unscheduled--;
+
+    // The last match fills the hole
+    u32 last = --schedule->num_matches;
+    if (match_idx != last)
+    {
+        ScheduledMatch *moved = schedule->matches + last;
+        schedule->matches[match_idx] = *moved;
+        if (moved->slot != SCHEDULE_NONE)
+        {
+            schedule->grid[moved->slot][moved->court] = (u16)(match_idx + 1);
+        }
+    }
+}
+
+void
+schedule_forget_event(Schedule *schedule, u32 event_idx)
+{
+    for (u32 i = schedule->num_matches; i-- > 0;)
+    {
+        if (schedule->matches[i].event_idx == event_idx)
+        {
+            schedule_remove(schedule, i);
+        }
+    }
+}
+
+void
+schedule_set_venue(Schedule *schedule, u32 num_slots, u32 num_courts)
+{
+    assert(num_slots <= SCHEDULE_MAX_SLOTS && num_courts <= SCHEDULE_MAX_COURTS);
+
+    for (u32 i = 0; i < schedule->num_matches; i++)
+    {
+        ScheduledMatch *match = schedule->matches + i;
+        if (match->slot != SCHEDULE_NONE && (match->slot >= num_slots || match->court >= num_courts))
+        {
+            schedule_unplace(schedule, i);
+        }
+    }
+    schedule->num_slots = num_slots;
+    schedule->num_courts = num_courts;
+    schedule->first_slot = Min(schedule->first_slot, num_slots ? num_slots - 1 : 0);
+    schedule->stale = true;
+}
+
+void
+schedule_set_first_slot(Schedule *schedule, u32 first_slot)
+{
+    assert(first_slot < SCHEDULE_MAX_SLOTS);
+    schedule->first_slot = first_slot;
+    schedule->stale = true;
+}
+
+void
+schedule_mark_events(Schedule *schedule, u64 events)
+{
+    schedule->dirty |= events;
+}
+
+void
+schedule_set_unavailable(Schedule *schedule, u32 player_idx, u64 slots)
+{
+    schedule->unavailable[player_idx] = slots;
+    schedule->stale = true;
+
+    for (u32 i = 0; i < schedule->num_matches; i++)
+    {
+        ScheduledMatch *match = schedule->matches + i;
+        if (match->slot != SCHEDULE_NONE && (slots >> match->slot) & 1 &&
+            (match->players[0] == player_idx || match->players[1] == player_idx))
+        {
+            schedule_unplace(schedule, i);
+        }
+    }
+}
+
+void
+schedule_set_court_closed(Schedule *schedule, u32 slot, u32 court, b32 closed)
+{
+    u16 bit = (u16)(1u << court);
+    if (!closed)
+    {
+        schedule->closed_courts[slot] &= (u16)~bit;
+        schedule->stale = true;
+        return;
+    }
+
+    schedule->closed_courts[slot] |= bit;
+    if (schedule->grid[slot][court] != 0)
+    {
+        schedule_unplace(schedule, schedule->grid[slot][court] - 1u);
+    }
+}
+
+/**
+ * Whether a match is still to be played: a group match at 0-0 during the
+ * group phase, a knockout match whose winner has not advanced, both players
+ * still registered.
+ */
+internal b32
+schedule_is_pending(Event *event, ScheduledMatch *match)
+{
+    u64 pair = (1ull << match->players[0]) | (1ull << match->players[1]);
+    if ((event->registrations & pair) != pair) return false;
+
+    if (match->group != GROUP_NONE)
+    {
+        GroupPhase *gp = &event->group_phase;
+        u32 row = match->position / MAX_GROUP_SIZE;
+        u32 col = match->position % MAX_GROUP_SIZE;
+        MatchScore score = gp->scores[match->group][row][col];
+
+        return event->phase == PHASE_GROUP && match->group < gp->num_groups &&
+               gp->groups[match->group][row] == match->players[0] &&
+               gp->groups[match->group][col] == match->players[1] &&
+               score.row_score == 0 && score.col_score == 0;
+    }
+
+    u8 *bracket = tournament_knockout_bracket(event);
+    u32 pos = match->position;
+    return event->phase == PHASE_KNOCKOUT && bracket[pos] == 0 &&
+           bracket[2 * pos + 1] == match->players[0] && bracket[2 * pos + 2] == match->players[1];
+}
+
+internal void
+schedule_add(Schedule *schedule, u32 event_idx, u32 group, u32 position, u8 player_a, u8 player_b)
+{
+    if (schedule->num_matches == SCHEDULE_MAX_MATCHES) return;
+
+    ScheduledMatch *match = schedule->matches + schedule->num_matches++;
+    match->event_idx = (u8)event_idx;
+    match->group = (u8)group;
+    match->position = (u8)position;
+    match->players[0] = player_a;
+    match->players[1] = player_b;
+    match->slot = SCHEDULE_NONE;
+    match->court = 0;
+    schedule->num_unscheduled++;
+    schedule->stale = true;
+}
+
+/**
+ * Drop the matches of an event that are not to play anymore and add the
+ * ones that are not in the schedule yet.
+ */
+internal void
+schedule_update_event(Schedule *schedule, EventsList *events, u32 event_idx)
+{
+    Event *event = events->events + event_idx;
+
+    // Matches already in, by group and position
+    u64 known_group[MAX_GROUPS] = {0};
+    u64 known_knockout = 0;
+
+    for (u32 i = schedule->num_matches; i-- > 0;)
+    {
+        ScheduledMatch *match = schedule->matches + i;
+        if (match->event_idx != event_idx) continue;
+
+        if (!schedule_is_pending(event, match))
+        {
+            schedule_remove(schedule, i);
+        }
+        else if (match->group != GROUP_NONE)
+        {
+            known_group[match->group] |= 1ull << match->position;
+        }
+        else
+        {
+            known_knockout |= 1ull << match->position;
+        }
+    }
+
+    // Removed events have no registrations left
+    if (event->registrations == 0) return;
+
+    if (event->phase == PHASE_GROUP)
+    {
+        GroupPhase *gp = &event->group_phase;
+        for (u32 g = 0; g < gp->num_groups; g++)
+        {
+            for (u32 row = 0; row < MAX_GROUP_SIZE; row++)
+            {
+                for (u32 col = row + 1; col < MAX_GROUP_SIZE; col++)
+                {
+                    u32 position = row * MAX_GROUP_SIZE + col;
+                    ScheduledMatch match = {
+                        .event_idx = (u8)event_idx,
+                        .group = (u8)g,
+                        .position = (u8)position,
+                        .players = { gp->groups[g][row], gp->groups[g][col] },
+                    };
+                    if (match.players[0] == 0 || match.players[1] == 0) continue;
+                    if ((known_group[g] >> position) & 1 || !schedule_is_pending(event, &match)) continue;
+
+                    schedule_add(schedule, event_idx, g, position, match.players[0], match.players[1]);
+                }
+            }
+        }
+    }
+    else if (event->phase == PHASE_KNOCKOUT)
+    {
+        // Slots whose children are both filled and that are still empty
+        u8 *bracket = tournament_knockout_bracket(event);
+        for (u32 pos = 0; 2 * pos + 2 < BRACKET_SIZE; pos++)
+        {
+            u8 player_a = bracket[2 * pos + 1];
+            u8 player_b = bracket[2 * pos + 2];
+            if (bracket[pos] != 0 || player_a == 0 || player_b == 0) continue;
+            if ((known_knockout >> pos) & 1) continue;
+
+            ScheduledMatch match = { .event_idx = (u8)event_idx, .group = GROUP_NONE, .position = (u8)pos,
+                                     .players = { player_a, player_b } };
+            if (!schedule_is_pending(event, &match)) continue;
+
+            schedule_add(schedule, event_idx, GROUP_NONE, pos, player_a, player_b);
+        }
+    }
+}
+
+/**
+ * Give a match the earliest slot where both players are available and free
+ * and a court is open.
+ */
+internal b32
+schedule_place(Schedule *schedule, u32 match_idx)
+{
+    ScheduledMatch *match = schedule->matches + match_idx;
+    u64 pair = (1ull << match->players[0]) | (1ull << match->players[1]);
+    u16 courts = (u16)((1u << schedule->num_courts) - 1);
+
+    u64 slots = schedule->num_slots == 64 ? ~0ull : (1ull << schedule->num_slots) - 1;
+    slots &= ~0ull << schedule->first_slot;
+    slots &= ~(schedule->unavailable[match->players[0]] | schedule->unavailable[match->players[1]]);
+
+    for (; slots; slots &= slots - 1)
+    {
+        u32 slot = (u32)__builtin_ctzll(slots);
+        u16 open = courts & (u16)~(schedule->taken_courts[slot] | schedule->closed_courts[slot]);
+        if ((schedule->busy[slot] & pair) || !open) continue;
+
+        u32 court = (u32)__builtin_ctz(open);
+        match->slot = (u8)slot;
+        match->court = (u8)court;
+        schedule->busy[slot] |= pair;
+        schedule->taken_courts[slot] |= (u16)(1u << court);
+        schedule->grid[slot][court] = (u16)(match_idx + 1);
+        schedule->num_unscheduled--;
+        return true;
+    }
+    return false;
+}
+
+typedef struct ScheduleOrder ScheduleOrder;
+struct ScheduleOrder {
+    u32 load;       // Registrations of the two players
+    u32 match_idx;
+};
+
+internal int
+schedule_compare_order(const void *a, const void *b)
+{
+    const ScheduleOrder *x = a;
+    const ScheduleOrder *y = b;
+    if (x->load != y->load) return x->load > y->load ? -1 : 1;
+    return x->match_idx < y->match_idx ? -1 : x->match_idx > y->match_idx;
+}
+
+u32
+schedule_update(Schedule *schedule, PlayersList *players, EventsList *events)
+{
+    TraceBegin(schedule_update);
+    assert(schedule->first_slot < SCHEDULE_MAX_SLOTS);
+
+    // Matches of the past slots that are still to play: missed, placed again
+    for (u32 slot = 0; slot < schedule->first_slot; slot++)
+    {
+        for (u32 court = 0; court < schedule->num_courts; court++)
+        {
+            if (schedule->grid[slot][court] != 0)
+            {
+                schedule_unplace(schedule, schedule->grid[slot][court] - 1u);
+            }
+        }
+    }
+
+    // Index 0 and the tail are the sentinels of the list
+    u64 dirty = schedule->dirty & ~1ull;
+    b32 changed = dirty != 0 || schedule->stale;
+    schedule->dirty = 0;
+    for (; dirty; dirty &= dirty - 1)
+    {
+        u32 event_idx = (u32)__builtin_ctzll(dirty);
+        if (event_idx >= events->len - 1) break;
+        schedule_update_event(schedule, events, event_idx);
+    }
+
+    // Nothing freed or added since the last placement: the same matches would
+    // not fit again
+    if (schedule->stale && schedule->num_unscheduled > 0)
+    {
+        Temp temp = scratch_get(0, 0);
+
+        ScheduleOrder *order = push_array(temp.arena, ScheduleOrder, schedule->num_unscheduled);
+        u32 count = 0;
+        for (u32 i = 0; i < schedule->num_matches; i++)
+        {
+            ScheduledMatch *match = schedule->matches + i;
+            if (match->slot != SCHEDULE_NONE) continue;
+
+            order[count].load = registration_count(players->players[match->players[0]].registrations) +
+                                registration_count(players->players[match->players[1]].registrations);
+            order[count].match_idx = i;
+            count++;
+        }
+        assert(count == schedule->num_unscheduled);
+        qsort(order, count, sizeof(ScheduleOrder), schedule_compare_order);
+
+        for (u32 i = 0; i < count; i++)
+        {
+            schedule_place(schedule, order[i].match_idx);
+        }
+
+        scratch_release(temp);
+    }
+    schedule->stale = false;
+    if (changed)
+    {
+        schedule->version++;
+    }
+
+    TraceEnd(schedule_update);
+    return schedule->num_unscheduled;
+}
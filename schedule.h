@@ -0,0 +1,118 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include "core.h"
+#include "players.h"
+
+// Match schedule: every match still to play, group matches (a 0-0) and
+// knockout matches whose two players are known, gets a time slot and a
+// court. A player plays at most one match per slot, whatever the events:
+// the players busy in a slot are a bitmask, the same as the registrations.
+//
+// Placing a match is greedy: the earliest slot from first_slot on where both
+// players are available and free and a court is open. Matches are placed
+// busiest players first, those registered to the most events, whose matches
+// are the hardest to fit.
+//
+// The schedule is incremental: a placed match keeps its slot and court until
+// it is played or stops being a match (a player left, the phase changed).
+// The events changed by an action are marked (history_commit does it, as do
+// undo and redo), and schedule_update only looks at those: it drops their
+// matches that are not to play anymore, adds the new ones, then places the
+// matches without a slot, in microseconds. Matches that do not fit stay
+// unscheduled and are tried again at every update.
+
+#define SCHEDULE_MAX_SLOTS    64      // A bit each in the availability masks
+#define SCHEDULE_MAX_COURTS   16      // A bit each in the court masks
+#define SCHEDULE_MAX_MATCHES  16384   // Pending matches of all the events
+#define SCHEDULE_NONE         0xFF    // Slot of a match without one
+
+typedef struct ScheduledMatch ScheduledMatch;
+struct ScheduledMatch {
+    u8 event_idx;
+    u8 group;       // GROUP_NONE for a knockout match
+    u8 position;    // Knockout: slot the winner goes to. Group: row * MAX_GROUP_SIZE + col
+    u8 players[2];
+    u8 slot;        // SCHEDULE_NONE while unscheduled
+    u8 court;
+};
+
+typedef struct Schedule Schedule;
+struct Schedule {
+    // Venue: slots from first_slot on can be given, slots before it are past
+    u32 num_slots;
+    u32 num_courts;
+    u32 first_slot;
+    u16 closed_courts[SCHEDULE_MAX_SLOTS];   // Bit c: court c is closed in the slot
+    u64 unavailable[MAX_NUM_ENTITIES];       // Bit s: the player cannot play in slot s
+
+    ScheduledMatch matches[SCHEDULE_MAX_MATCHES];
+    u32 num_matches;
+    u32 num_unscheduled;
+
+    // Placed matches by slot
+    u64 busy[SCHEDULE_MAX_SLOTS];            // Players playing in the slot
+    u16 taken_courts[SCHEDULE_MAX_SLOTS];
+    u16 grid[SCHEDULE_MAX_SLOTS][SCHEDULE_MAX_COURTS];  // Match index + 1, 0 for a free court
+
+    // Events to look at on the next update, and whether the matches without
+    // a slot may fit now
+    u64 dirty;
+    b32 stale;
+
+    // Bumped by every update that may have moved a match, the UI redraws on it
+    u64 version;
+};
+
+extern Schedule schedule;
+
+/**
+ * Empty the schedule and set the venue: slots and courts, all open, every
+ * player available. Every event is looked at on the next update.
+ */
+void schedule_init(Schedule *schedule, u32 num_slots, u32 num_courts);
+
+/**
+ * Change the number of slots and courts. The matches in the slots or courts
+ * that go are placed again on the next update, the others stay.
+ */
+void schedule_set_venue(Schedule *schedule, u32 num_slots, u32 num_courts);
+
+/**
+ * Move the first slot that can be given, e.g. as the day goes on. The matches
+ * of the slots before it that are still to play are placed again.
+ */
+void schedule_set_first_slot(Schedule *schedule, u32 first_slot);
+
+/**
+ * Take the matches of an event back, e.g. when it is removed.
+ */
+void schedule_forget_event(Schedule *schedule, u32 event_idx);
+
+/**
+ * Look at events (a bitmask of indices) on the next update: call after
+ * changing them.
+ */
+void schedule_mark_events(Schedule *schedule, u64 events);
+
+/**
+ * Slots a player cannot play in. Their matches in those slots lose them and
+ * are placed again on the next update.
+ */
+void schedule_set_unavailable(Schedule *schedule, u32 player_idx, u64 slots);
+
+/**
+ * Open or close a court in a slot. A match in a court that closes is placed
+ * again on the next update.
+ */
+void schedule_set_court_closed(Schedule *schedule, u32 slot, u32 court, b32 closed);
+
+/**
+ * Bring the matches of the marked events up to date and place the matches
+ * without a slot.
+ *
+ * @return The matches left without a slot
+ */
+u32 schedule_update(Schedule *schedule, PlayersList *players, EventsList *events);
+
+#endif // SCHEDULE_H
@@ -0,0 +1,303 @@
+#include <assert.h>
+#include <stddef.h>
+
+#include "core.h"
+#include "pool.h"
+#include "players.h"
+#include "snapshot.h"
+
+SnapshotStore snapshot_store;
+
+void
+snapshot_store_init(SnapshotStore *store, Arena *arena)
+{
+    MemoryZeroStruct(store);
+    store->chunks = pool_init(arena, SnapshotChunk, SNAPSHOT_MAX_CHUNKS);
+    store->free_chunks = SNAPSHOT_MAX_CHUNKS;
+    store->next_version = 1;
+}
+
+/**
+ * Snapshotted bytes of an event, the last chunk is shorter.
+ */
+internal u8 *
+snapshot_bytes(Event *event)
+{
+    return (u8 *)event + SNAPSHOT_EVENT_BEGIN;
+}
+
+internal u64
+snapshot_chunk_size(u32 chunk)
+{
+    return Min(SNAPSHOT_CHUNK_SIZE, SNAPSHOT_EVENT_SIZE - chunk * SNAPSHOT_CHUNK_SIZE);
+}
+
+internal u8 *
+snapshot_chunk(SnapshotStore *store, Snapshot *snapshot, u32 chunk)
+{
+    return ((SnapshotChunk *)pool_get(store->chunks, snapshot->chunks[chunk]))->bytes;
+}
+
+/**
+ * The snapshot of a version of an event, NULL when it has been dropped.
+ */
+internal Snapshot *
+snapshot_find(SnapshotStore *store, u32 event_idx, u32 version)
+{
+    if (version == 0 || version >= store->next_version || store->next_version - version > store->count)
+    {
+        return NULL;
+    }
+
+    Snapshot *snapshot = &store->snapshots[(version - 1) % SNAPSHOT_MAX];
+    return snapshot->event_idx == event_idx ? snapshot : NULL;
+}
+
+internal void
+snapshot_release(SnapshotStore *store, Snapshot *snapshot)
+{
+    for (u32 i = 0; i < SNAPSHOT_EVENT_CHUNKS; i++)
+    {
+        u16 chunk = snapshot->chunks[i];
+        assert(store->refcounts[chunk] > 0);
+        if (--store->refcounts[chunk] == 0)
+        {
+            pool_pop(store->chunks, chunk);
+            store->free_chunks++;
+        }
+    }
+    snapshot->event_idx = 0;
+}
+
+internal void
+snapshot_drop_oldest(SnapshotStore *store)
+{
+    assert(store->count > 0);
+
+    u32 version = store->next_version - store->count;
+    Snapshot *snapshot = &store->snapshots[(version - 1) % SNAPSHOT_MAX];
+    if (snapshot->event_idx != 0)
+    {
+        if (store->current[snapshot->event_idx] == version)
+        {
+            store->current[snapshot->event_idx] = 0;
+        }
+        snapshot_release(store, snapshot);
+    }
+    store->count--;
+}
+
+/**
+ * Whether a snapshot holds exactly the snapshotted bytes of an event.
+ */
+internal b32
+snapshot_matches(SnapshotStore *store, Snapshot *snapshot, u8 *bytes)
+{
+    for (u32 i = 0; i < SNAPSHOT_EVENT_CHUNKS; i++)
+    {
+        if (MemoryCompare(snapshot_chunk(store, snapshot, i), bytes + i * SNAPSHOT_CHUNK_SIZE, snapshot_chunk_size(i)) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+u32
+snapshot_take(SnapshotStore *store, Event *event, u32 event_idx)
+{
+    u8 *bytes = snapshot_bytes(event);
+
+    Snapshot *base = snapshot_find(store, event_idx, store->current[event_idx]);
+    if (base && snapshot_matches(store, base, bytes))
+    {
+        return base->version;
+    }
+
+    // Room for a snapshot sharing nothing with its base, which may be dropped too
+    while (store->count == SNAPSHOT_MAX || store->free_chunks < SNAPSHOT_EVENT_CHUNKS)
+    {
+        snapshot_drop_oldest(store);
+    }
+    base = snapshot_find(store, event_idx, store->current[event_idx]);
+
+    u32 version = store->next_version++;
+    store->count++;
+
+    Snapshot *snapshot = &store->snapshots[(version - 1) % SNAPSHOT_MAX];
+    snapshot->event_idx = event_idx;
+    snapshot->version = version;
+
+    for (u32 i = 0; i < SNAPSHOT_EVENT_CHUNKS; i++)
+    {
+        u8 *at = bytes + i * SNAPSHOT_CHUNK_SIZE;
+        u64 size = snapshot_chunk_size(i);
+
+        // Unchanged since the base: shared
+        if (base && MemoryCompare(snapshot_chunk(store, base, i), at, size) == 0)
+        {
+            snapshot->chunks[i] = base->chunks[i];
+            store->refcounts[base->chunks[i]]++;
+            continue;
+        }
+
+        SnapshotChunk chunk = {0};
+        MemoryCopy(chunk.bytes, at, size);
+        u32 slot = pool_push(store->chunks, &chunk);
+        store->refcounts[slot] = 1;
+        store->free_chunks--;
+        snapshot->chunks[i] = (u16)slot;
+    }
+
+    store->current[event_idx] = version;
+    return version;
+}
+
+u32
+snapshot_sync(SnapshotStore *store, Event *event, u32 event_idx)
+{
+    u8 *bytes = snapshot_bytes(event);
+
+    Snapshot *current = snapshot_find(store, event_idx, store->current[event_idx]);
+    if (current && snapshot_matches(store, current, bytes))
+    {
+        return current->version;
+    }
+
+    // Newest first: an undo usually goes back to the last version like it
+    for (u32 i = store->count; i-- > 0;)
+    {
+        u32 version = store->next_version - store->count + i;
+        Snapshot *snapshot = snapshot_find(store, event_idx, version);
+        if (snapshot && snapshot_matches(store, snapshot, bytes))
+        {
+            store->current[event_idx] = version;
+            return version;
+        }
+    }
+
+    return snapshot_take(store, event, event_idx);
+}
+
+b32
+snapshot_read(SnapshotStore *store, u32 event_idx, u32 version, Event *out)
+{
+    Snapshot *snapshot = snapshot_find(store, event_idx, version);
+    if (!snapshot) return false;
+
+    u8 *bytes = snapshot_bytes(out);
+    for (u32 i = 0; i < SNAPSHOT_EVENT_CHUNKS; i++)
+    {
+        MemoryCopy(bytes + i * SNAPSHOT_CHUNK_SIZE, snapshot_chunk(store, snapshot, i), snapshot_chunk_size(i));
+    }
+    return true;
+}
+
+b32
+snapshot_restore(SnapshotStore *store, PlayersList *players, EventsList *events, u32 event_idx, u32 version)
+{
+    Event *event = events->events + event_idx;
+    u64 registrations = event->registrations;
+
+    if (!snapshot_read(store, event_idx, version, event)) return false;
+    store->current[event_idx] = version;
+
+    // The players registered in only one of the two versions
+    s32 positions[64];
+    u32 count = find_all_filled_slots(registrations ^ event->registrations, positions);
+    for (u32 i = 0; i < count; i++)
+    {
+        u32 player_idx = (u32)positions[i];
+        Player *player = players->players + player_idx;
+        player->registrations ^= 1ull << event_idx;
+        sorted_view_update(players->by_registrations, player_idx, registration_count(player->registrations), player->name);
+    }
+    sorted_view_update(events->by_registrations, event_idx, registration_count(event->registrations), event->name);
+
+    results_update_event(players, events, event_idx);
+    return true;
+}
+
+void
+snapshot_forget_event(SnapshotStore *store, u32 event_idx)
+{
+    for (u32 i = 0; i < store->count; i++)
+    {
+        u32 version = store->next_version - store->count + i;
+        Snapshot *snapshot = snapshot_find(store, event_idx, version);
+        if (snapshot)
+        {
+            snapshot_release(store, snapshot);
+        }
+    }
+    store->current[event_idx] = 0;
+}
+
+void
+snapshot_forget_player(SnapshotStore *store, EventsList *events, u32 player_idx)
+{
+    u64 dropped_events = 0;
+    for (u32 i = 0; i < store->count; i++)
+    {
+        u32 version = store->next_version - store->count + i;
+        Snapshot *snapshot = &store->snapshots[(version - 1) % SNAPSHOT_MAX];
+        if (snapshot->event_idx == 0) continue;
+
+        // Registrations open the snapshotted bytes: first chunk, offset 0
+        u64 registrations;
+        MemoryCopy(&registrations, snapshot_chunk(store, snapshot, 0), sizeof(registrations));
+        if (!((registrations >> player_idx) & 1)) continue;
+
+        u32 event_idx = snapshot->event_idx;
+        if (store->current[event_idx] == version)
+        {
+            store->current[event_idx] = 0;
+            dropped_events |= 1ull << event_idx;
+        }
+        snapshot_release(store, snapshot);
+    }
+
+    // The events were rebuilt without the player: that is the version they are at
+    s32 positions[64];
+    u32 count = find_all_filled_slots(dropped_events, positions);
+    for (u32 i = 0; i < count; i++)
+    {
+        snapshot_take(store, events->events + positions[i], (u32)positions[i]);
+    }
+}
+
+u32
+snapshot_count(SnapshotStore *store, u32 event_idx, u32 *position)
+{
+    u32 count = 0;
+    *position = 0;
+    for (u32 i = 0; i < store->count; i++)
+    {
+        u32 version = store->next_version - store->count + i;
+        if (snapshot_find(store, event_idx, version))
+        {
+            count++;
+            if (version == store->current[event_idx]) *position = count;
+        }
+    }
+    return count;
+}
+
+u32
+snapshot_step(SnapshotStore *store, u32 event_idx, s32 steps)
+{
+    u32 position;
+    u32 count = snapshot_count(store, event_idx, &position);
+    s32 target = (s32)position + steps;
+    if (position == 0 || target < 1 || target > (s32)count) return 0;
+
+    for (u32 i = 0; i < store->count; i++)
+    {
+        u32 version = store->next_version - store->count + i;
+        if (snapshot_find(store, event_idx, version) && --target == 0)
+        {
+            return version;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>
+
+#include "core.h"
+#include "arena.h"
+#include "pool.h"
+#include "players.h"
+
+// Versions of the events: a snapshot of an event is its state (registrations,
+// phase, bracket, groups, scores) cut into chunks of SNAPSHOT_CHUNK_SIZE
+// bytes. A snapshot shares with the version the event was at the chunks that
+// did not change, copy on write, so entering a score costs the couple of
+// chunks of the score matrices it touched, not the several KB of the event.
+//
+// Chunks live in a pool and are reference counted. Snapshots go into a ring,
+// the oldest ones are dropped when the ring or the pool is full. A snapshot
+// is identified by its version, unique across all the events.
+//
+// Every action logged by the history snapshots the events it changed, and
+// undoing or redoing one moves them to the version they are back to.
+// Restoring a version writes its chunks back into the event, and only moves
+// the event to that version: the later versions are kept, and a change made
+// from there becomes the newest version.
+
+#define SNAPSHOT_CHUNK_SIZE    128
+
+// Snapshotted part of an event: not the links and the name, which belong to
+// the list, nor the derived fields from the medals on
+#define SNAPSHOT_EVENT_BEGIN   offsetof(Event, registrations)
+#define SNAPSHOT_EVENT_SIZE    (offsetof(Event, medals) - SNAPSHOT_EVENT_BEGIN)
+#define SNAPSHOT_EVENT_CHUNKS  ((SNAPSHOT_EVENT_SIZE + SNAPSHOT_CHUNK_SIZE - 1) / SNAPSHOT_CHUNK_SIZE)
+#define SNAPSHOT_MAX           1024     // Snapshots kept, of all the events
+#define SNAPSHOT_MAX_CHUNKS    8192     // Distinct chunks kept, 1 MB
+
+typedef struct SnapshotChunk SnapshotChunk;
+struct SnapshotChunk {
+    u8 bytes[SNAPSHOT_CHUNK_SIZE];
+};
+
+typedef struct Snapshot Snapshot;
+struct Snapshot {
+    u32 event_idx;      // 0 when the event was removed
+    u32 version;
+    u16 chunks[SNAPSHOT_EVENT_CHUNKS];  // Pool slots
+};
+
+typedef struct SnapshotStore SnapshotStore;
+struct SnapshotStore {
+    Pool *chunks;
+    u16 refcounts[SNAPSHOT_MAX_CHUNKS];
+    u32 free_chunks;
+
+    // Ring of snapshots: version v goes to slot (v - 1) % SNAPSHOT_MAX, the
+    // valid versions are the last `count` before next_version
+    Snapshot snapshots[SNAPSHOT_MAX];
+    u32 count;
+    u32 next_version;
+
+    // Version each event is at, 0 when it has none
+    u32 current[MAX_NUM_ENTITIES];
+};
+
+extern SnapshotStore snapshot_store;
+
+void snapshot_store_init(SnapshotStore *store, Arena *arena);
+
+/**
+ * Snapshot an event, unless it has not changed since the version it is at.
+ *
+ * @return The version of the event
+ */
+u32 snapshot_take(SnapshotStore *store, Event *event, u32 event_idx);
+
+/**
+ * Move an event to the kept version equal to it, after it was changed without
+ * a snapshot (an undo or a redo), or snapshot it if there is none.
+ *
+ * @return The version of the event
+ */
+u32 snapshot_sync(SnapshotStore *store, Event *event, u32 event_idx);
+
+/**
+ * Bring an event back to one of its versions: the registrations of the
+ * players follow those of the event, the sorted views and the results are
+ * updated. Touch the registered players of both versions before, to log it.
+ *
+ * @return Whether the version is still kept
+ */
+b32 snapshot_restore(SnapshotStore *store, PlayersList *players, EventsList *events, u32 event_idx, u32 version);
+
+/**
+ * Copy a version of an event over `out`, e.g. a copy of the event to compare
+ * with it. The fields that are not snapshotted are left as they are.
+ */
+b32 snapshot_read(SnapshotStore *store, u32 event_idx, u32 version, Event *out);
+
+/**
+ * Drop all the versions of an event, when it is removed.
+ */
+void snapshot_forget_event(SnapshotStore *store, u32 event_idx);
+
+/**
+ * Drop the versions of every event that register a player, when the player is
+ * removed: their index may be taken by someone else. Call after the removal,
+ * the events the player was in are snapshotted as they are now.
+ */
+void snapshot_forget_player(SnapshotStore *store, EventsList *events, u32 player_idx);
+
+/**
+ * Version of an event `steps` versions before (negative) or after the one it
+ * is at, 0 when there is none.
+ */
+u32 snapshot_step(SnapshotStore *store, u32 event_idx, s32 steps);
+
+/**
+ * Versions kept of an event, and the position (from 1) among them of the one
+ * it is at, 0 when it has none.
+ */
+u32 snapshot_count(SnapshotStore *store, u32 event_idx, u32 *position);
+
+#endif // SNAPSHOT_H
@@ -1,3 +1,4 @@
+#include <assert.h>
 #include <stdbool.h>
 
 #include "core.h"
@@ -127,3 +128,18 @@ str8_from_u32(Arena *arena, u32 num)
 
     return result;
 }
+
+// Two digits per number, numbers below 10 skip the leading '0'
+global const char str8_small_u32_digits[2 * STR8_SMALL_U32_COUNT + 1] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+String8
+str8_from_small_u32(u32 num)
+{
+    assert(num < STR8_SMALL_U32_COUNT);
+
+    u8 *digits = (u8 *)str8_small_u32_digits + 2 * num;
+    return (num < 10) ? str8(digits + 1, 1) : str8(digits, 2);
+}
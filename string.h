@@ -26,6 +26,12 @@ bool str8_cmp(String8 s1, String8 s2);
 String8 str8_from_cstr(char *c);
 String8 str8_from_u32(Arena *arena, u32 num);
 
+#define STR8_SMALL_U32_COUNT 100
+
+// Decimal string of num < STR8_SMALL_U32_COUNT, from a static table: no
+// allocation, always the same pointer for the same number. Read only.
+String8 str8_from_small_u32(u32 num);
+
 u64 cstr8_len(u8 *c);
 
 #endif // STRING_H
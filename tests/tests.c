@@ -5,8 +5,15 @@
 #include "../arena.c"
 #include "../pool.c"
 #include "../string.c"
+#include "../compress.c"
 #include "../linkedlist.c"
+#include "../timer.c"
+#include "../profiler.c"
 #include "../players.c"
+#include "../snapshot.c"
+#include "../history.c"
+#include "../schedule.c"
+#include "../input.c"
 
 ///////////////////////////////////////////////////////////////
 // arena tests
@@ -79,6 +86,20 @@ test_str8_copy(void)
     String8 res = str8_copy(arena, a);
 }
 
+void
+test_str8_from_small_u32(void)
+{
+    Arena *arena = arena_alloc(MegaByte(1));
+
+    for (u32 i = 0; i < STR8_SMALL_U32_COUNT; i++)
+    {
+        assert(str8_cmp(str8_from_small_u32(i), str8_from_u32(arena, i)));
+    }
+
+    // Interned: the same number is always the same string
+    assert(str8_from_small_u32(42).str == str8_from_small_u32(42).str);
+}
+
 ///////////////////////////////////////////////////////////////
 // pool tests
 
@@ -146,6 +167,37 @@ test_pool_double_free(void)
     pool_pop(pool, idx);
 }
 
+///////////////////////////////////////////////////////////////
+// compress tests
+
+void
+test_compress_roundtrip(void)
+{
+    Arena *arena = arena_alloc(MegaByte(4));
+
+    // Zero runs, repeated patterns and noise, spanning several blocks
+    u64 size = 3 * COMPRESS_BLOCK_SIZE + 123;
+    u8 *src = push_array(arena, u8, size);
+    u32 seed = 12345;
+    for (u64 i = 0; i < size; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        if ((i / 1000) % 3 == 1)      src[i] = (u8)(i % 7);
+        else if ((i / 1000) % 3 == 2) src[i] = (u8)(seed >> 16);
+    }
+
+    u8 *packed = push_array(arena, u8, COMPRESS_BOUND(size));
+    u64 packed_size = compress_stream(src, size, packed);
+    assert(packed_size < size);
+
+    u8 *unpacked = push_array(arena, u8, size);
+    assert(decompress_stream(packed, packed_size, unpacked, size) == size);
+    assert(MemoryMatch(src, unpacked, size));
+
+    // Truncated input must be rejected, not read out of bounds
+    assert(decompress_stream(packed, packed_size - 1, unpacked, size) == 0);
+}
+
 ///////////////////////////////////////////////////////////////
 // players tests
 
@@ -154,8 +206,8 @@ test_players(void)
 {
     Arena *arena = arena_alloc(MegaByte(10));
 
-    EntityList players = entity_list_init(arena, 64);
-    EntityList tournaments = entity_list_init(arena, 64);
+    PlayersList players = players_list_init(arena, 64);
+    EventsList tournaments = events_list_init(arena, 64);
 
     String8 aldo     = str8_lit("Aldo");
     String8 giovanni = str8_lit("Giovanni");
@@ -165,24 +217,911 @@ test_players(void)
     String8 machiavelli = str8_lit("Machiavelli");
     String8 freccette   = str8_lit("Freccette");
 
-    entity_list_add(&players, aldo);
-    entity_list_add(&players, giovanni);
-    entity_list_add(&players, giacomo);
+    players_list_add(&players, aldo);
+    players_list_add(&players, giovanni);
+    players_list_add(&players, giacomo);
+
+    events_list_add(&tournaments, pingpong);
+    events_list_add(&tournaments, machiavelli);
+    events_list_add(&tournaments, freccette);
+
+    register_player_to_event(&players, &tournaments, aldo, pingpong);
+
+    u32 idx_aldo = players_list_find(&players, aldo);
+    assert((players.players + idx_aldo)->registrations == 0x0000000000000002);
+
+    u32 idx_pingpong = events_list_find(&tournaments, pingpong);
+    assert((tournaments.events + idx_pingpong)->registrations == 0x0000000000000002);
+
+    players_list_remove(&players, &tournaments, aldo);
+    assert((tournaments.events + idx_pingpong)->registrations == 0x0000000000000000);
+}
+
+void
+test_sorted_views(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+
+    players_list_add(&players, str8_lit("giovanni"));
+    players_list_add(&players, str8_lit("Aldo"));
+    players_list_add(&players, str8_lit("Giacomo"));
+    players_list_add(&players, str8_lit("Gianna"));
+
+    // Sorted ignoring case
+    SortedView *names = players.by_name;
+    assert(names->count == 4);
+    assert(str8_cmp(names->entries[0].name, str8_lit("Aldo")));
+    assert(str8_cmp(names->entries[1].name, str8_lit("Giacomo")));
+    assert(str8_cmp(names->entries[2].name, str8_lit("Gianna")));
+    assert(str8_cmp(names->entries[3].name, str8_lit("giovanni")));
+
+    SortedRange range = sorted_view_prefix(names, str8_lit("gi"));
+    assert(range.first == 1 && range.count == 3);
+
+    range = sorted_view_prefix(names, str8_lit("GIA"));
+    assert(range.first == 1 && range.count == 2);
+
+    range = sorted_view_prefix(names, str8_lit(""));
+    assert(range.first == 0 && range.count == 4);
+
+    range = sorted_view_prefix(names, str8_lit("Giacomone"));
+    assert(range.count == 0);
+
+    range = sorted_view_prefix(names, str8_lit("z"));
+    assert(range.first == 4 && range.count == 0);
+
+    // Rename moves the entry, remove drops it
+    u32 idx_aldo = players_list_find(&players, str8_lit("Aldo"));
+    players_list_rename(&players, idx_aldo, str8_lit("Zeno"));
+    assert(names->entries[3].idx == idx_aldo);
+    assert(sorted_view_prefix(names, str8_lit("a")).count == 0);
+
+    players_list_remove(&players, &events, str8_lit("Gianna"));
+    range = sorted_view_prefix(names, str8_lit("gia"));
+    assert(range.count == 1);
+    assert(names->entries[range.first].idx == players_list_find(&players, str8_lit("Giacomo")));
+
+    events_list_add(&events, str8_lit("Ping Pong"));
+    events_list_add(&events, str8_lit("Freccette"));
+    assert(sorted_view_prefix(events.by_name, str8_lit("ping p")).count == 1);
+
+    // Registration counts reorder both lists, most registrations first,
+    // ties by name
+    register_player_to_event(&players, &events, str8_lit("giovanni"), str8_lit("Ping Pong"));
+    register_player_to_event(&players, &events, str8_lit("giovanni"), str8_lit("Freccette"));
+    register_player_to_event(&players, &events, str8_lit("Zeno"), str8_lit("Freccette"));
+
+    SortedView *by_registrations = players.by_registrations;
+    assert(by_registrations->count == 3);
+    assert(str8_cmp(by_registrations->entries[0].name, str8_lit("giovanni")));
+    assert(by_registrations->entries[0].key == 2);
+    assert(str8_cmp(by_registrations->entries[1].name, str8_lit("Zeno")));
+    assert(str8_cmp(by_registrations->entries[2].name, str8_lit("Giacomo")));
+    assert(str8_cmp(events.by_registrations->entries[0].name, str8_lit("Freccette")));
+
+    unregister_player_from_event(&players, &events, str8_lit("Zeno"), str8_lit("Freccette"));
+    register_player_to_event(&players, &events, str8_lit("Giacomo"), str8_lit("Ping Pong"));
+    assert(str8_cmp(by_registrations->entries[1].name, str8_lit("Giacomo")));
+    assert(by_registrations->entries[2].key == 0);
+
+    // Removing an event updates the counts of its players
+    events_list_remove(&events, &players, str8_lit("Ping Pong"));
+    assert(events.by_registrations->count == 1);
+    assert(by_registrations->entries[0].key == 1);
+    assert(str8_cmp(by_registrations->entries[1].name, str8_lit("Giacomo")));
+
+    // The rebuilt views match the maintained ones
+    SortedView maintained = *names;
+    SortedView maintained_registrations = *by_registrations;
+    players_list_reindex(&players);
+    assert(names->count == maintained.count);
+    for (u32 i = 0; i < names->count; ++i)
+    {
+        assert(names->entries[i].idx == maintained.entries[i].idx);
+        assert(by_registrations->entries[i].idx == maintained_registrations.entries[i].idx);
+    }
+}
+
+internal void
+test_advance(PlayersList *players, EventsList *events, u32 event_idx, u8 player_idx)
+{
+    Event *event = events->events + event_idx;
+    tournament_advance_winner(event, tournament_find_bracket_slot(event, player_idx));
+    results_update_event(players, events, event_idx);
+}
+
+void
+test_medals(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+
+    char *names[] = { "Aldo", "Giovanni", "Giacomo", "Marina" };
+    events_list_add(&events, str8_lit("Ping Pong"));
+    events_list_add(&events, str8_lit("Freccette"));
+    for (u32 i = 0; i < ArrayCount(names); ++i)
+    {
+        players_list_add(&players, str8_from_cstr(names[i]));
+        register_player_to_event(&players, &events, str8_from_cstr(names[i]), str8_lit("Ping Pong"));
+    }
+    register_player_to_event(&players, &events, str8_lit("Aldo"), str8_lit("Freccette"));
+    register_player_to_event(&players, &events, str8_lit("Marina"), str8_lit("Freccette"));
+
+    u32 idx_pingpong = events_list_find(&events, str8_lit("Ping Pong"));
+    u32 idx_freccette = events_list_find(&events, str8_lit("Freccette"));
+    assert(tournament_start(events.events + idx_pingpong));
+    assert(tournament_start(events.events + idx_freccette));
+
+    // Semifinals: the losers get bronze as soon as their match is decided
+    u8 *bracket = events.events[idx_pingpong].bracket;
+    Player *first_semi_loser = players.players + bracket[4];
+    test_advance(&players, &events, idx_pingpong, bracket[3]);
+    assert(first_semi_loser->medals.bronze == 1);
+    assert(sorted_view_count_keyed(players.by_medals) == 1);
+
+    u8 finalist = bracket[1];
+    Player *second_semi_loser = players.players + bracket[6];
+    test_advance(&players, &events, idx_pingpong, bracket[5]);
+    assert(second_semi_loser->medals.bronze == 1);
+    assert(events_list_finished_count(&events) == 0);
+
+    // Final
+    test_advance(&players, &events, idx_pingpong, finalist);
+    assert(events_list_finished_count(&events) == 1);
+    assert(players.players[finalist].medals.gold == 1);
+    assert(players.players[bracket[2]].medals.silver == 1);
+    assert(players.by_medals->entries[0].idx == finalist);
+    assert(sorted_view_count_keyed(players.by_medals) == 4);
+
+    // A 2-player event is a lone final, no bronze
+    test_advance(&players, &events, idx_freccette, (u8)players_list_find(&players, str8_lit("Marina")));
+    EventMedals freccette = events.events[idx_freccette].medals;
+    assert(freccette.silver != 0 && freccette.bronze[0] == 0 && freccette.bronze[1] == 0);
+    assert(players.players[freccette.gold].medals.gold == 1 + (freccette.gold == finalist));
+
+    // Undoing the final takes gold and silver back
+    tournament_undo_advance(events.events + idx_pingpong, 1, finalist);
+    tournament_undo_advance(events.events + idx_pingpong, 2, finalist);
+    results_update_event(&players, &events, idx_pingpong);
+    assert(events.events[idx_pingpong].medals.gold == 0);
+    assert(events_list_finished_count(&events) == 1);
+
+    // The maintained tallies match a rebuild from the brackets
+    MedalCount tallies[64];
+    for (u32 i = 0; i < 64; ++i) tallies[i] = players.players[i].medals;
+    results_rebuild(&players, &events);
+    players_list_reindex(&players);
+    for (u32 i = 1; i <= ArrayCount(names); ++i)
+    {
+        assert(MemoryMatchStruct(&tallies[i], &players.players[i].medals));
+    }
+
+    // Removing an event takes its medals back
+    events_list_remove(&events, &players, str8_lit("Freccette"));
+    assert(sorted_view_count_keyed(players.by_medals) == 2);
+    assert(players.by_medals->entries[0].key == medal_key((MedalCount){ .bronze = 1 }));
+}
+
+void
+test_player_stats(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+
+    char *names[] = { "Aldo", "Giovanni", "Giacomo", "Marina" };
+    events_list_add(&events, str8_lit("Ping Pong"));
+    for (u32 i = 0; i < ArrayCount(names); ++i)
+    {
+        players_list_add(&players, str8_from_cstr(names[i]));
+        register_player_to_event(&players, &events, str8_from_cstr(names[i]), str8_lit("Ping Pong"));
+    }
+
+    u32 idx_pingpong = events_list_find(&events, str8_lit("Ping Pong"));
+    Event *pingpong = events.events + idx_pingpong;
+    pingpong->format = FORMAT_GROUP_KNOCKOUT;
+    tournament_construct_groups(pingpong);
+    tournament_populate_bracket_from_groups(pingpong);
+    assert(tournament_start(pingpong));
 
-    entity_list_add(&tournaments, pingpong);
-    entity_list_add(&tournaments, machiavelli);
-    entity_list_add(&tournaments, freccette);
+    // Group matches: a win with goals, a draw, a 0-0 still to play
+    GroupPhase *gp = &pingpong->group_phase;
+    u8 a = gp->groups[0][0];
+    u8 b = gp->groups[0][1];
+    u8 c = gp->groups[0][2];
+    tournament_set_group_score(pingpong, 0, 0, 1, 3, 1);
+    tournament_set_group_score(pingpong, 0, 0, 2, 2, 2);
+    results_update_event(&players, &events, idx_pingpong);
 
-    entity_list_register(&players, &tournaments, aldo, pingpong);
+    PlayerStats *stats_a = &players.players[a].stats;
+    assert(stats_a->played == 2 && stats_a->wins == 1 && stats_a->draws == 1 && stats_a->losses == 0);
+    assert(stats_a->goals_for == 5 && stats_a->goals_against == 3);
+    assert(players.players[b].stats.losses == 1 && players.players[b].stats.goals_for == 1);
+    assert(players.players[c].stats.draws == 1);
 
-    u32 idx_aldo = entity_list_find(&players, aldo);
-    assert((players.entities + idx_aldo)->registrations == 0x0000000000000002);
+    // Correcting a score replaces the old result
+    tournament_set_group_score(pingpong, 0, 0, 1, 0, 1);
+    results_update_event(&players, &events, idx_pingpong);
+    assert(stats_a->wins == 0 && stats_a->losses == 1 && stats_a->goals_for == 2);
+    assert(players.players[b].stats.wins == 1);
 
-    u32 idx_pingpong = entity_list_find(&tournaments, pingpong);
-    assert((tournaments.entities + idx_pingpong)->registrations == 0x0000000000000002);
+    // Knockout: 2 qualifiers play the final, the round reached and the win
+    // are recorded, and the event counts as finished for all its players
+    tournament_terminate_group_phase(pingpong);
+    results_update_event(&players, &events, idx_pingpong);
+    u8 *bracket = tournament_knockout_bracket(pingpong);
+    u8 winner = bracket[1];
+    u32 wins = players.players[winner].stats.wins;
+    assert(winner != 0 && bracket[2] != 0);
+    assert(tournament_round_of_slot(pingpong->records[winner].bracket_slot) == 1);
 
-    entity_list_remove(&players, &tournaments, aldo);
-    assert((tournaments.entities + idx_pingpong)->registrations == 0x0000000000000000);
+    tournament_advance_winner(pingpong, 1);
+    results_update_event(&players, &events, idx_pingpong);
+    assert(players.players[winner].stats.wins == wins + 1);
+    assert(tournament_round_of_slot(pingpong->records[winner].bracket_slot) == 0);
+    assert(players.players[c].stats.events_finished == 1);
+
+    // The maintained stats match a rebuild from the events
+    PlayerStats maintained[64];
+    for (u32 i = 0; i < 64; ++i) maintained[i] = players.players[i].stats;
+    results_rebuild(&players, &events);
+    for (u32 i = 1; i <= ArrayCount(names); ++i)
+    {
+        assert(MemoryMatchStruct(&maintained[i], &players.players[i].stats));
+    }
+
+    // Removing the event takes its matches back
+    events_list_remove(&events, &players, str8_lit("Ping Pong"));
+    assert(stats_a->played == 0 && stats_a->goals_for == 0);
+}
+
+internal void
+test_register(PlayersList *players, EventsList *events, char *player, char *event)
+{
+    history_begin();
+    history_touch_player(players, players_list_find(players, str8_from_cstr(player)));
+    history_touch_event(events, events_list_find(events, str8_from_cstr(event)));
+    register_player_to_event(players, events, str8_from_cstr(player), str8_from_cstr(event));
+    history_commit();
+}
+
+void
+test_history(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+    history_clear();
+
+    char *names[] = { "Aldo", "Giovanni", "Giacomo", "Marina" };
+    events_list_add(&events, str8_lit("Ping Pong"));
+    for (u32 i = 0; i < ArrayCount(names); ++i)
+    {
+        players_list_add(&players, str8_from_cstr(names[i]));
+        test_register(&players, &events, names[i], "Ping Pong");
+    }
+
+    u32 idx_pingpong = events_list_find(&events, str8_lit("Ping Pong"));
+    u32 idx_marina = players_list_find(&players, str8_lit("Marina"));
+    Event *pingpong = events.events + idx_pingpong;
+    Player *marina = players.players + idx_marina;
+
+    // A registration is undone and redone, sorted views included; each is a
+    // new version of the olympiad for the autosave
+    u64 version = history.version;
+    assert(history_undo(&players, &events));
+    assert(history.version == version + 1);
+    assert(marina->registrations == 0 && !((pingpong->registrations >> idx_marina) & 1));
+    assert(players.by_registrations->entries[players.by_registrations->count - 1].idx == idx_marina);
+    assert(history_redo(&players, &events));
+    assert(((pingpong->registrations >> idx_marina) & 1) && marina->registrations != 0);
+    assert(!history_can_redo());
+
+    // An action that changes nothing is not a new version
+    version = history.version;
+    history_begin();
+    history_touch_event(&events, idx_pingpong);
+    history_commit();
+    assert(history.version == version);
+
+    // Start, play the semifinals and the final
+    history_begin();
+    history_touch_event(&events, idx_pingpong);
+    assert(tournament_start(pingpong));
+    history_commit();
+
+    for (u32 slot = 2; slot >= 1; --slot)
+    {
+        u32 winner = 2 * slot + 1;
+        history_begin();
+        history_touch_event(&events, idx_pingpong);
+        tournament_advance_winner(pingpong, winner);
+        history_commit();
+        results_update_event(&players, &events, idx_pingpong);
+    }
+    history_begin();
+    history_touch_event(&events, idx_pingpong);
+    tournament_advance_winner(pingpong, 1);
+    history_commit();
+    results_update_event(&players, &events, idx_pingpong);
+
+    u8 champion = pingpong->bracket[0];
+    assert(champion != 0 && players.players[champion].medals.gold == 1);
+
+    // Returning to the registration wipes the bracket: undoing it brings the
+    // bracket and the medals back, with a record per changed chunk
+    u8 bracket[BRACKET_SIZE];
+    MemoryCopyArray(bracket, pingpong->bracket);
+    u64 newest = history.newest;
+
+    history_begin();
+    history_touch_event(&events, idx_pingpong);
+    tournament_return_to_registration(pingpong);
+    history_commit();
+    results_update_event(&players, &events, idx_pingpong);
+    assert(history.newest - newest < BRACKET_SIZE / 8 + 2);
+    assert(players.players[champion].medals.gold == 0);
+
+    assert(history_undo(&players, &events));
+    assert(pingpong->phase == PHASE_KNOCKOUT);
+    assert(MemoryCompare(bracket, pingpong->bracket, BRACKET_SIZE) == 0);
+    assert(players.players[champion].medals.gold == 1);
+    assert(players.by_medals->entries[0].idx == champion);
+
+    // Undoing the final, then doing something else, discards the redo
+    assert(history_undo(&players, &events));
+    assert(pingpong->bracket[0] == 0 && players.players[champion].medals.gold == 0);
+    assert(history_can_redo());
+
+    history_begin();
+    history_touch_player(&players, idx_marina);
+    players_list_rename(&players, idx_marina, str8_lit("Adriana"));
+    history_commit();
+    assert(!history_can_redo());
+    assert(players.by_name->entries[0].idx == idx_marina);
+
+    assert(history_undo(&players, &events));
+    assert(str8_cmp(marina->name, str8_lit("Marina")));
+    assert(players.by_name->entries[ArrayCount(names) - 1].idx == idx_marina);
+
+    // An action that changes nothing is not logged
+    u64 cursor = history.cursor;
+    history_begin();
+    history_touch_event(&events, idx_pingpong);
+    history_commit();
+    assert(history.cursor == cursor && history_can_redo());
+
+    // Undo all the way back to the empty event
+    while (history_undo(&players, &events));
+    assert(pingpong->registrations == 0 && pingpong->phase == PHASE_REGISTRATION);
+    assert(!history_can_undo());
+}
+
+void
+test_snapshots(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+    snapshot_store_init(&snapshot_store, arena);
+    history_clear();
+
+    char *names[] = { "Aldo", "Giovanni", "Giacomo", "Marina", "Adriana", "Ennio" };
+    events_list_add(&events, str8_lit("Calcetto"));
+    for (u32 i = 0; i < ArrayCount(names); ++i)
+    {
+        players_list_add(&players, str8_from_cstr(names[i]));
+        test_register(&players, &events, names[i], "Calcetto");
+    }
+
+    u32 idx_calcetto = events_list_find(&events, str8_lit("Calcetto"));
+    Event *calcetto = events.events + idx_calcetto;
+
+    // The empty event, then a version per registration
+    u32 position;
+    assert(snapshot_count(&snapshot_store, idx_calcetto, &position) == ArrayCount(names) + 1);
+    assert(position == ArrayCount(names) + 1);
+
+    history_begin();
+    history_touch_event(&events, idx_calcetto);
+    calcetto->format = FORMAT_GROUP_KNOCKOUT;
+    calcetto->group_phase.group_size = 3;
+    calcetto->group_phase.advance_per_group = 1;
+    tournament_construct_groups(calcetto);
+    assert(tournament_start(calcetto));
+    history_commit();
+    u32 started = snapshot_store.current[idx_calcetto];
+
+    // A score shares all the chunks but the few of the matrices it touched
+    for (u32 col = 1; col < 3; ++col)
+    {
+        u32 free_chunks = snapshot_store.free_chunks;
+        history_begin();
+        history_touch_event(&events, idx_calcetto);
+        tournament_set_group_score(calcetto, 0, 0, col, 2, 0);
+        history_commit();
+        assert(free_chunks - snapshot_store.free_chunks <= 4);
+    }
+    u8 leader = calcetto->group_phase.groups[0][0];
+
+    // Terminating the groups by mistake: step back to the scores, the bracket
+    // of the knockout is gone and the results follow
+    history_begin();
+    history_touch_event(&events, idx_calcetto);
+    tournament_terminate_group_phase(calcetto);
+    history_commit();
+    results_update_event(&players, &events, idx_calcetto);
+    assert(calcetto->phase == PHASE_KNOCKOUT);
+
+    u32 terminated = snapshot_store.current[idx_calcetto];
+    u32 scored = snapshot_step(&snapshot_store, idx_calcetto, -1);
+    assert(scored != 0 && scored < terminated);
+    assert(snapshot_restore(&snapshot_store, &players, &events, idx_calcetto, scored));
+    assert(calcetto->phase == PHASE_GROUP);
+    assert(calcetto->group_phase.scores[0][0][2].row_score == 2);
+    assert(players.players[leader].stats.wins == 2);
+
+    // Reading a version leaves the event alone
+    Event *copy = push_array(arena, Event, 1);
+    MemoryCopyStruct(copy, calcetto);
+    assert(snapshot_read(&snapshot_store, idx_calcetto, started, copy));
+    assert(copy->group_phase.scores[0][0][2].row_score == 0);
+    assert(calcetto->group_phase.scores[0][0][2].row_score == 2);
+
+    // Restoring as the UI does, then undoing and redoing it: the event is
+    // back at its versions, and so is the stepper
+    history_begin();
+    history_touch_event(&events, idx_calcetto);
+    for (u32 i = 0; i < ArrayCount(names); ++i)
+    {
+        history_touch_player(&players, players_list_find(&players, str8_from_cstr(names[i])));
+    }
+    assert(snapshot_restore(&snapshot_store, &players, &events, idx_calcetto, started));
+    history_commit();
+    assert(snapshot_store.current[idx_calcetto] == started);
+    assert(history_undo(&players, &events));
+    assert(snapshot_store.current[idx_calcetto] == scored);
+    assert(history_redo(&players, &events));
+    assert(snapshot_store.current[idx_calcetto] == started);
+    assert(history_undo(&players, &events));
+    assert(calcetto->group_phase.scores[0][0][2].row_score == 2);
+
+    // Back to a version with fewer registrations: the players follow
+    u32 idx_ennio = players_list_find(&players, str8_lit("Ennio"));
+    u32 registered = snapshot_step(&snapshot_store, idx_calcetto, -4);
+    assert(snapshot_restore(&snapshot_store, &players, &events, idx_calcetto, registered));
+    assert(calcetto->phase == PHASE_REGISTRATION);
+    assert(!((calcetto->registrations >> idx_ennio) & 1));
+    assert(players.players[idx_ennio].registrations == 0);
+    assert(players.by_registrations->entries[players.by_registrations->count - 1].idx == idx_ennio);
+    assert(snapshot_step(&snapshot_store, idx_calcetto, 5) == terminated);
+
+    // Hundreds of versions: the oldest are dropped, no chunk is leaked
+    for (u32 i = 0; i < SNAPSHOT_MAX + 10; ++i)
+    {
+        calcetto->group_phase.scores[i % MAX_GROUPS][1][2].row_score = (u16)i;
+        snapshot_take(&snapshot_store, calcetto, idx_calcetto);
+    }
+    assert(snapshot_count(&snapshot_store, idx_calcetto, &position) == SNAPSHOT_MAX);
+    assert(position == SNAPSHOT_MAX);
+
+    snapshot_forget_event(&snapshot_store, idx_calcetto);
+    assert(snapshot_count(&snapshot_store, idx_calcetto, &position) == 0);
+    assert(snapshot_store.free_chunks == SNAPSHOT_MAX_CHUNKS);
+
+    // Removing a player drops the versions that register them, their index
+    // may be taken by someone else: the versions left can all be restored
+    events_list_add(&events, str8_lit("Bocce"));
+    u32 idx_bocce = events_list_find(&events, str8_lit("Bocce"));
+    Event *bocce = events.events + idx_bocce;
+    test_register(&players, &events, "Aldo", "Bocce");
+    test_register(&players, &events, "Giovanni", "Bocce");
+    assert(snapshot_count(&snapshot_store, idx_bocce, &position) == 3);
+
+    u32 idx_aldo = players_list_find(&players, str8_lit("Aldo"));
+    u32 idx_giovanni = players_list_find(&players, str8_lit("Giovanni"));
+    players_list_remove(&players, &events, str8_lit("Aldo"));
+    snapshot_forget_player(&snapshot_store, &events, idx_aldo);
+    history_clear();
+    players_list_add(&players, str8_lit("Lucia"));
+    assert(players_list_find(&players, str8_lit("Lucia")) == idx_aldo);
+
+    // The empty event, and the event as the removal left it
+    assert(snapshot_count(&snapshot_store, idx_bocce, &position) == 2 && position == 2);
+    u32 empty = snapshot_step(&snapshot_store, idx_bocce, -1);
+    assert(snapshot_restore(&snapshot_store, &players, &events, idx_bocce, empty));
+    assert(bocce->registrations == 0 && players.players[idx_giovanni].registrations == (1ull << idx_calcetto));
+    assert(snapshot_restore(&snapshot_store, &players, &events, idx_bocce, snapshot_step(&snapshot_store, idx_bocce, 1)));
+    assert(bocce->registrations == (1ull << idx_giovanni));
+    assert(players.players[idx_aldo].registrations == 0);
+
+    MemoryZeroStruct(&snapshot_store);
+}
+
+void
+test_late_group(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+
+    char *names[] = { "Aldo", "Giovanni", "Giacomo", "Marina", "Adriana", "Ennio", "Lucia", "Piero" };
+    events_list_add(&events, str8_lit("Bocce"));
+    for (u32 i = 0; i < ArrayCount(names); ++i)
+    {
+        players_list_add(&players, str8_from_cstr(names[i]));
+    }
+    for (u32 i = 0; i < 4; ++i)
+    {
+        register_player_to_event(&players, &events, str8_from_cstr(names[i]), str8_lit("Bocce"));
+    }
+
+    u32 idx_bocce = events_list_find(&events, str8_lit("Bocce"));
+    Event *bocce = events.events + idx_bocce;
+    GroupPhase *gp = &bocce->group_phase;
+    bocce->format = FORMAT_GROUP_KNOCKOUT;
+    gp->group_size = 2;
+    gp->advance_per_group = 1;
+    tournament_construct_groups(bocce);
+    tournament_populate_bracket_from_groups(bocce);
+
+    // Not before the group phase
+    u32 idx_adriana = players_list_find(&players, str8_lit("Adriana"));
+    u32 idx_ennio = players_list_find(&players, str8_lit("Ennio"));
+    u32 idx_lucia = players_list_find(&players, str8_lit("Lucia"));
+    u64 late = (1ULL << idx_adriana) | (1ULL << idx_ennio) | (1ULL << idx_lucia);
+    assert(!register_late_group_to_event(&players, &events, idx_bocce, late));
+    assert(bocce->registrations == 0x1E && players.players[idx_adriana].registrations == 0);
+
+    assert(tournament_start(bocce));
+    tournament_set_group_score(bocce, 0, 0, 1, 3, 1);
+    tournament_set_group_score(bocce, 1, 0, 1, 0, 2);
+    MatchScore scores[2][MAX_GROUP_SIZE][MAX_GROUP_SIZE];
+    MemoryCopy(scores, gp->scores, sizeof(scores));
+
+    // A group of one is refused
+    assert(!register_late_group_to_event(&players, &events, idx_bocce, 1ULL << idx_adriana));
+    assert(gp->num_groups == 2);
+
+    // Three latecomers: a third group, the first two untouched
+    assert(register_late_group_to_event(&players, &events, idx_bocce, late));
+    assert(gp->num_groups == 3);
+    assert(MemoryCompare(scores, gp->scores, sizeof(scores)) == 0);
+    assert(gp->player_group[idx_ennio] == 2 && gp->groups[2][gp->player_slot[idx_ennio]] == idx_ennio);
+    assert((players.players[idx_lucia].registrations >> idx_bocce) & 1);
+    assert(registration_count(bocce->registrations) == 7);
+    assert(events.by_registrations->entries[0].idx == idx_bocce);
+
+    // The bracket takes the winners of the first groups and the new group's leader
+    tournament_set_group_score(bocce, 2, 0, 1, 1, 0);
+    tournament_set_group_score(bocce, 2, 0, 2, 1, 0);
+    u8 *bracket = tournament_knockout_bracket(bocce);
+    u8 leaders[] = { gp->groups[0][0], gp->groups[1][1], gp->groups[2][0] };
+    for (u32 i = 0; i < ArrayCount(leaders); ++i)
+    {
+        assert(tournament_find_bracket_slot(bocce, leaders[i]) < BRACKET_SIZE);
+    }
+    assert(bracket[0] == 0);
+
+    // The new group's matches count in the stats
+    results_update_event(&players, &events, idx_bocce);
+    assert(players.players[gp->groups[2][0]].stats.wins == 2);
+}
+
+internal u32
+test_bracket_half(u32 slot)
+{
+    while (slot > 2) slot = (slot - 1) / 2;
+    return slot;
+}
+
+void
+test_seeding(void)
+{
+    // Seed 1 plays 8, 4 plays 5, 2 plays 7, 3 plays 6
+    u32 expected[] = { 0, 7, 3, 4, 1, 6, 2, 5 };
+    for (u32 line = 0; line < ArrayCount(expected); ++line)
+    {
+        assert(seeding_seed_of_line(line, 3) == expected[line]);
+    }
+
+    // Seed b meets a better seed no earlier than in the round where only the
+    // best 2^k >= b + 1 seeds are left
+    for (u32 levels = 1; levels <= 8; ++levels)
+    {
+        u32 num_lines = 1u << levels;
+        u32 line_of_seed[256];
+        for (u32 line = 0; line < num_lines; ++line)
+        {
+            line_of_seed[seeding_seed_of_line(line, levels)] = line;
+        }
+        for (u32 b = 1; b < num_lines; ++b)
+        {
+            u32 k = 32 - (u32)__builtin_clz(b);
+            for (u32 a = 0; a < b; ++a)
+            {
+                assert(seeding_meeting_round(line_of_seed[a], line_of_seed[b]) >= levels - k + 1);
+            }
+        }
+    }
+
+    // Qualifiers of a group meet as late as their number allows: the two of
+    // a group only in the final, up to 128 groups (256 qualifiers)
+    u16 groups[256];
+    u16 tiers[256];
+    u32 lines[256];
+    for (u32 advance = 1; advance <= 4; ++advance)
+    {
+        for (u32 num_groups = 1; num_groups * advance <= 256; ++num_groups)
+        {
+            u32 count = 0;
+            for (u32 tier = 0; tier < advance; ++tier)
+            {
+                for (u32 g = 0; g < num_groups; ++g)
+                {
+                    groups[count] = (u16)g;
+                    tiers[count] = (u16)tier;
+                    count++;
+                }
+            }
+            u32 levels = seeding_assign_lines(groups, tiers, count, lines);
+            assert((1u << levels) >= count && (levels == 0 || (1u << (levels - 1)) < count));
+
+            u32 earliest = advance <= 2 ? levels : levels - 1;
+            u8 taken[256] = {0};
+            for (u32 i = 0; i < count; ++i)
+            {
+                assert(!taken[lines[i]]);
+                taken[lines[i]] = 1;
+                for (u32 j = 0; j < i; ++j)
+                {
+                    assert(groups[i] != groups[j] || seeding_meeting_round(lines[i], lines[j]) >= earliest);
+                }
+            }
+
+            // Group winners keep their seeds
+            for (u32 g = 0; g < num_groups; ++g)
+            {
+                assert(seeding_seed_of_line(lines[g], levels) == g);
+            }
+        }
+    }
+
+    // In the bracket: 4 groups of 4, the first two of each in opposite halves
+    Arena *arena = arena_alloc(MegaByte(10));
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+    events_list_add(&events, str8_lit("Bocce"));
+    char *names[] = { "Aldo", "Giovanni", "Giacomo", "Marina", "Adriana", "Ennio", "Lucia", "Piero",
+                      "Franca", "Dino", "Rosa", "Bruno", "Carla", "Elio", "Nanni", "Tina" };
+    for (u32 i = 0; i < ArrayCount(names); ++i)
+    {
+        players_list_add(&players, str8_from_cstr(names[i]));
+        register_player_to_event(&players, &events, str8_from_cstr(names[i]), str8_lit("Bocce"));
+    }
+
+    Event *bocce = events.events + events_list_find(&events, str8_lit("Bocce"));
+    GroupPhase *gp = &bocce->group_phase;
+    bocce->format = FORMAT_GROUP_KNOCKOUT;
+    gp->group_size = 4;
+    gp->advance_per_group = 2;
+    tournament_construct_groups(bocce);
+    tournament_populate_bracket_from_groups(bocce);
+    assert(gp->num_groups == 4);
+
+    u32 halves[MAX_GROUPS] = {0};
+    u32 qualified = 0;
+    for (u32 slot = 0; slot < BRACKET_SIZE; ++slot)
+    {
+        u8 player = gp->bracket[slot];
+        if (player == 0) continue;
+        assert(slot >= 7 && slot < 15);
+        halves[gp->player_group[player]] |= 1u << test_bracket_half(slot);
+        qualified++;
+    }
+    assert(qualified == 8);
+    for (u32 g = 0; g < 4; ++g)
+    {
+        assert(halves[g] == 0x6);
+    }
+
+    // 3 groups: 6 qualifiers, the two best seeds skip the first round
+    gp->advance_per_group = 2;
+    gp->group_size = 5;
+    tournament_construct_groups(bocce);
+    tournament_populate_bracket_from_groups(bocce);
+    assert(gp->num_groups == 3);
+
+    u32 byes = 0;
+    qualified = 0;
+    MemoryZeroArray(halves);
+    for (u32 slot = 0; slot < BRACKET_SIZE; ++slot)
+    {
+        u8 player = gp->bracket[slot];
+        if (player == 0) continue;
+        byes += slot < 7;
+        halves[gp->player_group[player]] |= 1u << test_bracket_half(slot);
+        qualified++;
+    }
+    assert(qualified == 6 && byes == 2);
+    for (u32 g = 0; g < 3; ++g)
+    {
+        assert(halves[g] == 0x6);
+    }
+}
+
+/**
+ * No player in two matches of a slot, no court used twice, and the masks
+ * agree with the matches.
+ */
+internal void
+test_schedule_check(Schedule *s)
+{
+    u64 busy[SCHEDULE_MAX_SLOTS] = {0};
+    u16 courts[SCHEDULE_MAX_SLOTS] = {0};
+    u32 unscheduled = 0;
+    for (u32 i = 0; i < s->num_matches; ++i)
+    {
+        ScheduledMatch *match = s->matches + i;
+        if (match->slot == SCHEDULE_NONE)
+        {
+            unscheduled++;
+            continue;
+        }
+
+        u64 pair = (1ULL << match->players[0]) | (1ULL << match->players[1]);
+        assert(match->slot >= s->first_slot && match->slot < s->num_slots && match->court < s->num_courts);
+        assert((busy[match->slot] & pair) == 0 && !((courts[match->slot] >> match->court) & 1));
+        assert(((s->unavailable[match->players[0]] | s->unavailable[match->players[1]]) >> match->slot & 1) == 0);
+        assert(s->grid[match->slot][match->court] == i + 1);
+        busy[match->slot] |= pair;
+        courts[match->slot] |= (u16)(1u << match->court);
+    }
+    assert(unscheduled == s->num_unscheduled);
+    assert(MemoryCompare(busy, s->busy, sizeof(busy)) == 0);
+    assert(MemoryCompare(courts, s->taken_courts, sizeof(courts)) == 0);
+}
+
+void
+test_schedule(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+
+    char *names[] = { "Aldo", "Giovanni", "Giacomo", "Marina", "Adriana", "Ennio", "Lucia", "Piero" };
+    events_list_add(&events, str8_lit("Bocce"));
+    events_list_add(&events, str8_lit("Ping Pong"));
+    for (u32 i = 0; i < ArrayCount(names); ++i)
+    {
+        players_list_add(&players, str8_from_cstr(names[i]));
+        register_player_to_event(&players, &events, str8_from_cstr(names[i]), str8_lit("Bocce"));
+    }
+    for (u32 i = 0; i < 4; ++i)
+    {
+        register_player_to_event(&players, &events, str8_from_cstr(names[i]), str8_lit("Ping Pong"));
+    }
+
+    // Bocce: 2 groups of 4, 12 matches. Ping Pong: 2 semifinals among
+    // players who also play Bocce
+    u32 idx_bocce = events_list_find(&events, str8_lit("Bocce"));
+    u32 idx_pingpong = events_list_find(&events, str8_lit("Ping Pong"));
+    Event *bocce = events.events + idx_bocce;
+    Event *pingpong = events.events + idx_pingpong;
+    GroupPhase *gp = &bocce->group_phase;
+    bocce->format = FORMAT_GROUP_KNOCKOUT;
+    gp->group_size = 4;
+    gp->advance_per_group = 1;
+    tournament_construct_groups(bocce);
+    tournament_populate_bracket_from_groups(bocce);
+    assert(tournament_start(bocce));
+    tournament_construct_bracket(pingpong);
+    assert(tournament_start(pingpong));
+
+    // Nothing started is scheduled
+    schedule_init(&schedule, 8, 2);
+    pingpong->phase = PHASE_REGISTRATION;
+    assert(schedule_update(&schedule, &players, &events) == 0 && schedule.num_matches == 12);
+    pingpong->phase = PHASE_KNOCKOUT;
+    schedule_mark_events(&schedule, 1ULL << idx_pingpong);
+    assert(schedule_update(&schedule, &players, &events) == 0 && schedule.num_matches == 14);
+    test_schedule_check(&schedule);
+
+    // An update with nothing to look at keeps the version the UI drew
+    u64 version = schedule.version;
+    assert(version > 0);
+    schedule_update(&schedule, &players, &events);
+    assert(schedule.version == version);
+
+    // Busiest players first: a knockout match of players in both events
+    // has the first slot
+    ScheduledMatch *first = schedule.matches + schedule.grid[0][0] - 1;
+    assert(players.players[first->players[0]].registrations == 0x6);
+    assert(players.players[first->players[1]].registrations == 0x6);
+
+    // A result takes its match off, every other match stays where it was
+    ScheduledMatch before[SCHEDULE_MAX_MATCHES];
+    u32 num_before = schedule.num_matches;
+    MemoryCopy(before, schedule.matches, sizeof(ScheduledMatch) * num_before);
+
+    history_begin();
+    history_touch_event(&events, idx_bocce);
+    tournament_set_group_score(bocce, 0, 0, 1, 2, 1);
+    history_commit();
+    assert((schedule.dirty >> idx_bocce) & 1);
+    schedule_update(&schedule, &players, &events);
+    test_schedule_check(&schedule);
+    assert(schedule.num_matches == num_before - 1);
+
+    u32 kept = 0;
+    for (u32 i = 0; i < num_before; ++i)
+    {
+        for (u32 j = 0; j < schedule.num_matches; ++j)
+        {
+            ScheduledMatch *match = schedule.matches + j;
+            if (match->event_idx == before[i].event_idx && match->group == before[i].group &&
+                match->position == before[i].position)
+            {
+                assert(match->slot == before[i].slot && match->court == before[i].court);
+                kept++;
+            }
+        }
+    }
+    assert(kept == num_before - 1);
+
+    // Both semifinals played: the final is scheduled, after nobody
+    u8 *bracket = tournament_knockout_bracket(pingpong);
+    tournament_advance_winner(pingpong, 3);
+    tournament_advance_winner(pingpong, 5);
+    schedule_mark_events(&schedule, 1ULL << idx_pingpong);
+    assert(schedule_update(&schedule, &players, &events) == 0);
+    test_schedule_check(&schedule);
+    u32 finals = 0;
+    for (u32 i = 0; i < schedule.num_matches; ++i)
+    {
+        ScheduledMatch *match = schedule.matches + i;
+        if (match->event_idx != idx_pingpong) continue;
+        assert(match->position == 0 && match->players[0] == bracket[1] && match->players[1] == bracket[2]);
+        finals++;
+    }
+    assert(finals == 1);
+
+    // A player away for the first two slots plays later
+    u32 aldo = players_list_find(&players, str8_lit("Aldo"));
+    schedule_set_unavailable(&schedule, aldo, 0x03);
+    assert(schedule_update(&schedule, &players, &events) == 0);
+    test_schedule_check(&schedule);
+
+    // The day goes on: the matches left in the past slots are placed again
+    schedule_set_first_slot(&schedule, 2);
+    schedule_update(&schedule, &players, &events);
+    test_schedule_check(&schedule);
+
+    // A closed court and a smaller venue: what does not fit waits
+    schedule_set_court_closed(&schedule, 3, 0, true);
+    schedule_set_venue(&schedule, 4, 1);
+    u32 left = schedule_update(&schedule, &players, &events);
+    test_schedule_check(&schedule);
+    assert(left == schedule.num_matches - 1);
+
+    // Removing an event takes its matches back
+    schedule_set_venue(&schedule, 8, 2);
+    schedule_forget_event(&schedule, idx_bocce);
+    schedule_update(&schedule, &players, &events);
+    test_schedule_check(&schedule);
+    assert(schedule.num_matches == 1);
+
+    MemoryZeroStruct(&schedule);
 }
 
 void
@@ -190,8 +1129,8 @@ test_unregistration(void)
 {
     Arena *arena = arena_alloc(MegaByte(10));
 
-    EntityList players = entity_list_init(arena, 64);
-    EntityList tournaments = entity_list_init(arena, 64);
+    PlayersList players = players_list_init(arena, 64);
+    EventsList tournaments = events_list_init(arena, 64);
 
     String8 aldo     = str8_lit("Aldo");
     String8 giovanni = str8_lit("Giovanni");
@@ -201,31 +1140,468 @@ test_unregistration(void)
     String8 machiavelli = str8_lit("Machiavelli");
     String8 freccette   = str8_lit("Freccette");
 
-    entity_list_add(&players, aldo);
-    entity_list_add(&players, giovanni);
-    entity_list_add(&players, giacomo);
+    players_list_add(&players, aldo);
+    players_list_add(&players, giovanni);
+    players_list_add(&players, giacomo);
 
-    entity_list_add(&tournaments, pingpong);
-    entity_list_add(&tournaments, machiavelli);
-    entity_list_add(&tournaments, freccette);
+    events_list_add(&tournaments, pingpong);
+    events_list_add(&tournaments, machiavelli);
+    events_list_add(&tournaments, freccette);
 
-    u32 idx_aldo = entity_list_find(&players, aldo);
-    u32 idx_pingpong = entity_list_find(&tournaments, pingpong);
+    u32 idx_aldo = players_list_find(&players, aldo);
+    u32 idx_pingpong = events_list_find(&tournaments, pingpong);
 
-    entity_list_register(&players, &tournaments, aldo, pingpong);
-    assert((tournaments.entities + idx_aldo)->registrations == 2);
-    assert((tournaments.entities + idx_pingpong)->registrations == 2);
+    register_player_to_event(&players, &tournaments, aldo, pingpong);
+    assert((players.players + idx_aldo)->registrations == 2);
+    assert((tournaments.events + idx_pingpong)->registrations == 2);
 
-    entity_list_unregister(&players, &tournaments, aldo, pingpong);
-    assert((tournaments.entities + idx_aldo)->registrations == 0);
-    assert((tournaments.entities + idx_pingpong)->registrations == 0);
+    unregister_player_from_event(&players, &tournaments, aldo, pingpong);
+    assert((players.players + idx_aldo)->registrations == 0);
+    assert((tournaments.events + idx_pingpong)->registrations == 0);
+}
+
+///////////////////////////////////////////////////////////////
+// save tests
+
+void
+test_tournament_knockout(void)
+{
+    Arena *arena = arena_alloc(MegaByte(1));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+
+    players_list_add(&players, str8_lit("Aldo"));
+    players_list_add(&players, str8_lit("Giovanni"));
+    events_list_add(&events, str8_lit("Ping Pong"));
+
+    Event *pingpong = events.events + events_list_find(&events, str8_lit("Ping Pong"));
+    assert(!tournament_start(pingpong));
+
+    register_player_to_event(&players, &events, str8_lit("Aldo"), str8_lit("Ping Pong"));
+    register_player_to_event(&players, &events, str8_lit("Giovanni"), str8_lit("Ping Pong"));
+    assert(tournament_start(pingpong));
+    assert(pingpong->phase == PHASE_KNOCKOUT);
+
+    u8 aldo = (u8)players_list_find(&players, str8_lit("Aldo"));
+    u32 slot = tournament_find_bracket_slot(pingpong, aldo);
+    assert(slot != BRACKET_SIZE && slot != 0);
+
+    tournament_advance_winner(pingpong, slot);
+    assert(pingpong->bracket[0] == aldo);
+    assert(tournament_find_bracket_slot(pingpong, aldo) == 0);
+
+    tournament_undo_advance(pingpong, slot, aldo);
+    assert(pingpong->bracket[0] == 0);
+}
+
+void
+test_save_roundtrip(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+
+    players_list_add(&players, str8_lit("Aldo"));
+    players_list_add(&players, str8_lit("Giovanni"));
+    players_list_add(&players, str8_lit("Giacomo"));
+    events_list_add(&events, str8_lit("Ping Pong"));
+
+    register_player_to_event(&players, &events, str8_lit("Aldo"), str8_lit("Ping Pong"));
+    register_player_to_event(&players, &events, str8_lit("Giovanni"), str8_lit("Ping Pong"));
+    register_player_to_event(&players, &events, str8_lit("Giacomo"), str8_lit("Ping Pong"));
+
+    u32 idx_pingpong = events_list_find(&events, str8_lit("Ping Pong"));
+    Event *pingpong = events.events + idx_pingpong;
+    pingpong->format = FORMAT_GROUP_KNOCKOUT;
+    pingpong->phase = PHASE_GROUP;
+    pingpong->group_phase.scores[0][0][1] = (MatchScore){ 3, 1 };
+    pingpong->group_phase.scores[0][1][0] = (MatchScore){ 1, 3 };
+
+    const char *save_file = olympiad_save_file;
+    olympiad_save_file = "build/test_roundtrip.sav";
+    assert(olympiad_save(&players, &events));
+
+    PlayersList players_loaded = players_list_init(arena, 64);
+    EventsList events_loaded = events_list_init(arena, 64);
+    assert(olympiad_load(arena, &players_loaded, &events_loaded));
+    olympiad_save_file = save_file;
+
+    assert(players_list_count(&players_loaded) == 3);
+    assert(players_loaded.first_free_idx == players.first_free_idx);
+
+    Event *loaded = events_loaded.events + events_list_find(&events_loaded, str8_lit("Ping Pong"));
+    assert(loaded == events_loaded.events + idx_pingpong);
+    assert(loaded->registrations == pingpong->registrations);
+    assert(loaded->phase == PHASE_GROUP && loaded->format == FORMAT_GROUP_KNOCKOUT);
+    assert(MemoryMatchArray(loaded->bracket, pingpong->bracket));
+    assert(MemoryMatchStruct(&loaded->group_phase, &pingpong->group_phase));
+}
+
+void
+test_save_newer_version(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+    players_list_add(&players, str8_lit("Aldo"));
+
+    const char *save_file = "build/test_newer.sav";
+    assert(olympiad_save_archive(&players, &events, save_file));
+
+    // Bump the version in the header, as a newer build would write it
+    FILE *f = fopen(save_file, "r+b");
+    assert(f);
+    u32 version = SAVE_VERSION + 1;
+    fseek(f, sizeof(u32), SEEK_SET);
+    fwrite(&version, sizeof(version), 1, f);
+    fclose(f);
+
+    PlayersList players_loaded = players_list_init(arena, 64);
+    EventsList events_loaded = events_list_init(arena, 64);
+    assert(!olympiad_load_file(arena, &players_loaded, &events_loaded, save_file));
+}
+
+// Written by save version 2, never saved over: olympiad.sav is the app's live save
+#define TEST_SAVE_V2 "tests/fixtures/olympiad_v2.sav"
+
+/**
+ * Version in the header of a save file, 0 when it cannot be read.
+ */
+u32
+test_save_version(const char *path)
+{
+    SaveHeader header = {0};
+    FILE *f = fopen(path, "rb");
+    if (!f) return 0;
+    size_t read = fread(&header, sizeof(header), 1, f);
+    fclose(f);
+    return read == 1 ? header.version : 0;
+}
+
+/**
+ * A full olympiad: every slot taken, about a third of the registrations,
+ * every event started, half of them in groups with a few scores entered.
+ */
+void
+test_large_olympiad(Arena *arena, PlayersList *players, EventsList *events)
+{
+    u32 capacity = MAX_NUM_ENTITIES - 2;
+    String8 player_names[MAX_NUM_ENTITIES];
+    String8 event_names[MAX_NUM_ENTITIES];
+    for (u32 i = 0; i < capacity; ++i)
+    {
+        char buffer[32];
+        int len = snprintf(buffer, sizeof(buffer), "Giocatore %02u", i);
+        player_names[i] = str8_copy(arena, str8((u8 *)buffer, (u64)len));
+        len = snprintf(buffer, sizeof(buffer), "Torneo %02u", i);
+        event_names[i] = str8_copy(arena, str8((u8 *)buffer, (u64)len));
+        players_list_add(players, player_names[i]);
+        events_list_add(events, event_names[i]);
+    }
+
+    u64 state = 1;
+    for (u32 e = 0; e < capacity; ++e)
+    {
+        for (u32 p = 0; p < capacity; ++p)
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            if ((state >> 33) % 3 == 0)
+            {
+                register_player_to_event(players, events, player_names[p], event_names[e]);
+            }
+        }
+
+        Event *event = events->events + events_list_find(events, event_names[e]);
+        if (e % 2)
+        {
+            event->format = FORMAT_GROUP_KNOCKOUT;
+            event->group_phase.group_size = 4;
+            event->group_phase.advance_per_group = 2;
+            tournament_construct_groups(event);
+        }
+        if (!tournament_start(event) || event->phase != PHASE_GROUP) continue;
+
+        GroupPhase *gp = &event->group_phase;
+        for (u32 g = 0; g < gp->num_groups; ++g)
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            tournament_set_group_score(event, g, 0, 1, (u16)((state >> 40) % 6), (u16)((state >> 50) % 6));
+        }
+    }
+}
+
+void
+test_save_archive(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+    assert(test_save_version(TEST_SAVE_V2) == 2);
+    assert(olympiad_load_file(arena, &players, &events, TEST_SAVE_V2));
+
+    const char *archive = "build/test_archive.sav";
+    assert(olympiad_save_archive(&players, &events, archive));
+
+    PlayersList players_loaded = players_list_init(arena, 64);
+    EventsList events_loaded = events_list_init(arena, 64);
+    assert(olympiad_load_file(arena, &players_loaded, &events_loaded, archive));
+
+    u32 idx_tail = events.len - 1;
+    for (u32 e = events.events->nxt; e != idx_tail; e = events.events[e].nxt)
+    {
+        Event *a = events.events + e;
+        Event *b = events_loaded.events + e;
+        assert(str8_cmp(a->name, b->name));
+        assert(a->registrations == b->registrations);
+        assert(MemoryMatchArray(a->bracket, b->bracket));
+        assert(MemoryMatchArray(a->group_phase.scores, b->group_phase.scores));
+    }
+
+    // A full olympiad: the archive is at least 5 times smaller than the plain
+    // save of the same version (about 9 times here, 6 to 7 times on the
+    // olympiads of generate_save)
+    PlayersList players_large = players_list_init(arena, 64);
+    EventsList events_large = events_list_init(arena, 64);
+    test_large_olympiad(arena, &players_large, &events_large);
+
+    const char *save_file = olympiad_save_file;
+    olympiad_save_file = "build/test_large.sav";
+    assert(olympiad_save(&players_large, &events_large));
+    olympiad_save_file = save_file;
+    assert(olympiad_save_archive(&players_large, &events_large, "build/test_large_archive.sav"));
+
+    FILE *f = fopen("build/test_large.sav", "rb");
+    assert(f);
+    fseek(f, 0, SEEK_END);
+    long plain_size = ftell(f);
+    fclose(f);
+    f = fopen("build/test_large_archive.sav", "rb");
+    assert(f);
+    fseek(f, 0, SEEK_END);
+    long archive_size = ftell(f);
+    fclose(f);
+    printf("Archive: %ld bytes, plain save: %ld bytes\n", archive_size, plain_size);
+    assert(archive_size * 5 < plain_size);
+
+    // A corrupt decompressed size is rejected, not allocated
+    f = fopen(archive, "r+b");
+    assert(f);
+    u64 raw_size = GigaByte(64);
+    fseek(f, 24 + 8, SEEK_SET); // SaveHeader, SaveSection
+    fwrite(&raw_size, sizeof(raw_size), 1, f);
+    fclose(f);
+    PlayersList players_corrupt = players_list_init(arena, 64);
+    EventsList events_corrupt = events_list_init(arena, 64);
+    assert(!olympiad_load_file(arena, &players_corrupt, &events_corrupt, archive));
+}
+
+void
+test_save_upgrade_v2(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+    assert(test_save_version(TEST_SAVE_V2) == 2);
+    assert(olympiad_load_file(arena, &players, &events, TEST_SAVE_V2));
+
+    assert(players_list_count(&players) > 0);
+    assert(events_list_count(&events) > 0);
+
+    // Registrations must still be consistent in both directions
+    u32 idx_tail = events.len - 1;
+    for (u32 e = events.events->nxt; e != idx_tail; e = events.events[e].nxt)
+    {
+        s32 positions[64];
+        u32 count = find_all_filled_slots(events.events[e].registrations, positions);
+        for (u32 i = 0; i < count; ++i)
+        {
+            assert((players.players[positions[i]].registrations >> e) & 1);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////
+// profiler tests
+
+void
+test_profiler_ring(void)
+{
+    profiler_set_enabled(true);
+    assert(profiler_frame(0) == NULL);
+    assert(profiler_percentile(50) == 0);
+
+    // Wrap the ring once, frame i took i ms
+    for (u32 i = 0; i < PROFILER_HISTORY + 10; i++)
+    {
+        profiler_frame_begin();
+        profiler_frame_end();
+        profiler_frame(0)->total_ms = (f32)i;
+    }
+
+    assert(profiler.count == PROFILER_HISTORY);
+    assert(profiler_frame(0)->total_ms == (f32)(PROFILER_HISTORY + 9));
+    assert(profiler_frame(PROFILER_HISTORY - 1)->total_ms == 10.0f);
+    assert(profiler_frame(PROFILER_HISTORY) == NULL);
+
+    assert(profiler_percentile(0) == 10.0f);
+    assert(profiler_percentile(100) == (f32)(PROFILER_HISTORY + 9));
+    f32 p50 = profiler_percentile(50);
+    assert(p50 >= 137.0f && p50 <= 138.0f);
+
+    // Hidden: zones are not recorded
+    profiler_set_enabled(false);
+    u64 start = profiler_zone_begin();
+    profiler_zone_end(ProfileZone_Layout, start);
+    assert(start == 0 && profiler.current.zone_ms[ProfileZone_Layout] == 0);
+}
+
+///////////////////////////////////////////////////////////////
+// input tests
+
+// raylib is not linked into the tests: what input.c polls from it comes
+// from this frame instead
+global InputFrame test_input_frame;
+global u32 test_input_next_char;
+global s32 test_window_size[2];
+
+double  GetTime(void)                   { return test_input_frame.time; }
+float   GetFrameTime(void)              { return test_input_frame.frameTime; }
+int     GetScreenWidth(void)            { return test_input_frame.screenWidth; }
+int     GetScreenHeight(void)           { return test_input_frame.screenHeight; }
+Vector2 GetMousePosition(void)          { return test_input_frame.mousePosition; }
+Vector2 GetMouseDelta(void)             { return test_input_frame.mouseDelta; }
+Vector2 GetMouseWheelMoveV(void)        { return test_input_frame.wheel; }
+bool    IsWindowResized(void)           { return test_input_frame.windowResized; }
+bool    IsMouseButtonDown(int button)     { return (test_input_frame.mouseDown >> button) & 1; }
+bool    IsMouseButtonPressed(int button)  { return (test_input_frame.mousePressed >> button) & 1; }
+bool    IsMouseButtonReleased(int button) { return (test_input_frame.mouseReleased >> button) & 1; }
+bool    IsKeyDown(int key)              { return InputBitGet(test_input_frame.keysDown, key); }
+bool    IsKeyPressed(int key)           { return InputBitGet(test_input_frame.keysPressed, key); }
+bool    IsKeyPressedRepeat(int key)     { return InputBitGet(test_input_frame.keysRepeated, key); }
+void    SetWindowSize(int width, int height) { test_window_size[0] = width; test_window_size[1] = height; }
+
+int
+GetCharPressed(void)
+{
+    if (test_input_next_char >= test_input_frame.numChars) return 0;
+    return test_input_frame.chars[test_input_next_char++];
+}
+
+void
+test_input_record_replay(void)
+{
+    Arena *arena = arena_alloc(MegaByte(10));
+
+    PlayersList players = players_list_init(arena, 64);
+    EventsList events = events_list_init(arena, 64);
+    players_list_add(&players, str8_lit("Aldo"));
+    events_list_add(&events, str8_lit("Ping Pong"));
+    test_register(&players, &events, "Aldo", "Ping Pong");
+
+    // Record a few synthetic frames: the mouse moves, a key and a click on
+    // the second frame, two characters typed on the third
+    const char *path = "build/test_input.rec";
+    assert(input_record_begin(path, &players, &events));
+    for (u32 i = 0; i < 3; i++)
+    {
+        MemoryZeroStruct(&test_input_frame);
+        test_input_frame.time = 1.0 + i / 60.0;
+        test_input_frame.frameTime = 1 / 60.0f;
+        test_input_frame.screenWidth = 800;
+        test_input_frame.screenHeight = 600;
+        test_input_frame.mousePosition = (Vector2){ 10.0f * (f32)i, 20.0f };
+        if (i == 1)
+        {
+            InputBitSet(test_input_frame.keysDown, KEY_A);
+            test_input_frame.mouseDown = 1 << MOUSE_BUTTON_LEFT;
+        }
+        if (i == 2)
+        {
+            test_input_frame.numChars = 2;
+            test_input_frame.chars[0] = 'o';
+            test_input_frame.chars[1] = 'k';
+        }
+        test_input_next_char = 0;
+        input_begin_frame();
+    }
+    input_end();
+    MemoryZeroStruct(&input);
+
+    // Replay under another screen size: the recorded frames come back, not
+    // the ones raylib would give, and the window follows the recorded size
+    MemoryZeroStruct(&test_input_frame);
+    test_input_frame.screenWidth = 1;
+    test_input_frame.screenHeight = 1;
+
+    const char *save_file = olympiad_save_file;
+    const char *temp_file = olympiad_temp_file;
+    PlayersList players_replayed = players_list_init(arena, 64);
+    EventsList events_replayed = events_list_init(arena, 64);
+    assert(input_replay_begin(arena, path, &players_replayed, &events_replayed));
+    olympiad_save_file = save_file;
+    olympiad_temp_file = temp_file;
+
+    assert(players_list_count(&players_replayed) == 1);
+    u32 idx_pingpong = events_list_find(&events_replayed, str8_lit("Ping Pong"));
+    assert(events_replayed.events[idx_pingpong].registrations == events.events[idx_pingpong].registrations);
+
+    s32 width, height;
+    input_replay_screen_size(&width, &height);
+    assert(width == 800 && height == 600);
+
+    for (u32 i = 0; i < 3; i++)
+    {
+        input_begin_frame();
+        assert(!input_replay_finished());
+        assert(input_time() == 1.0 + i / 60.0);
+        assert(input_mouse_position().x == 10.0f * (f32)i);
+        assert(input_key_down(KEY_A) == (i == 1));
+        assert(input_mouse_down(MOUSE_BUTTON_LEFT) == (i == 1));
+        assert(input_char_pressed() == (i == 2 ? 'o' : 0));
+        assert(input_char_pressed() == (i == 2 ? 'k' : 0));
+        // Held keys and buttons are state, the typed characters are events
+        assert(input_has_events() == (i == 2));
+        assert(input_char_pressed() == 0);
+    }
+    assert(test_window_size[0] == 800 && test_window_size[1] == 600);
+
+    input_begin_frame();
+    assert(input_replay_finished());
+    input_end();
+    MemoryZeroStruct(&input);
 }
 
 int
 main(void)
 {
+    ctx_init();
+
+    test_str8_from_small_u32();
+    test_compress_roundtrip();
+
     test_players();
+    test_sorted_views();
+    test_medals();
+    test_player_stats();
+    test_history();
+    test_snapshots();
+    test_late_group();
+    test_seeding();
+    test_schedule();
     test_unregistration();
 
+    test_tournament_knockout();
+    test_save_roundtrip();
+    test_save_upgrade_v2();
+    test_save_archive();
+    test_save_newer_version();
+    test_profiler_ring();
+    test_input_record_replay();
+
     return 0;
 }
@@ -0,0 +1,63 @@
+#include "core.h"
+#include "timer.h"
+
+// NOTE: on Linux clock_gettime needs _POSIX_C_SOURCE, which build.sh passes
+//       on the command line since -std=c99 hides it otherwise
+
+#if OS_MAC
+# include <mach/mach_time.h>
+#elif OS_WINDOWS
+// Declared by hand: windows.h clashes with raylib (CloseWindow, DrawText, ...)
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(s64 *count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(s64 *frequency);
+#else
+# include <time.h>
+#endif
+
+#if ARCH_X64 || ARCH_X86
+# if COMPILER_MSVC
+#  include <intrin.h>
+# else
+#  include <x86intrin.h>
+# endif
+#endif
+
+u64
+timer_now_ns(void)
+{
+#if OS_MAC
+    local_persist mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0)
+    {
+        mach_timebase_info(&timebase);
+    }
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+#elif OS_WINDOWS
+    local_persist s64 frequency;
+    if (frequency == 0)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+    s64 count;
+    QueryPerformanceCounter(&count);
+    return (u64)(count / frequency) * 1000000000ull + (u64)(count % frequency) * 1000000000ull / (u64)frequency;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+#endif
+}
+
+u64
+timer_cycles(void)
+{
+#if ARCH_X64 || ARCH_X86
+    return __rdtsc();
+#elif ARCH_ARM64 && !COMPILER_MSVC
+    u64 ticks;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return timer_now_ns();
+#endif
+}
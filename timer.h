@@ -0,0 +1,13 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include "core.h"
+
+// Monotonic wall clock in nanoseconds (arbitrary origin)
+u64 timer_now_ns(void);
+
+// Raw CPU cycle/tick counter: rdtsc on x86, cntvct_el0 on arm64.
+// Only meaningful as a difference between two reads on the same core.
+u64 timer_cycles(void);
+
+#endif // TIMER_H